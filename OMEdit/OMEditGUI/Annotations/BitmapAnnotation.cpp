@@ -38,6 +38,9 @@
 #include "BitmapAnnotation.h"
 #include "Commands.h"
 
+/* The decoded images shared by all the bitmaps. The cost is in kilobytes. */
+QCache<QString, QImage> BitmapAnnotation::mImagesCache(64 * 1024);
+
 BitmapAnnotation::BitmapAnnotation(QString classFileName, QString annotation, GraphicsView *pGraphicsView)
   : ShapeAnnotation(false, pGraphicsView, 0)
 {
@@ -98,13 +101,43 @@ void BitmapAnnotation::parseShapeAnnotation(QString annotation)
   if (list.size() >= 6) {
     mImageSource = StringHandler::removeFirstLastQuotes(list.at(5));
   }
-  if (!mImageSource.isEmpty()) {
-    mImage.loadFromData(QByteArray::fromBase64(mImageSource.toLatin1()));
-  } else if (!mFileName.isEmpty()) {
-    mImage.load(mFileName);
+  mImage = loadImage(mImageSource, mFileName);
+}
+
+/*!
+ * \brief BitmapAnnotation::loadImage
+ * Decodes the image source or reads the image file.\n
+ * The decoded images are cached by the content hash of the image source or by the file path and modification time.
+ * So all the bitmaps showing the same image share one QImage.
+ * \param imageSource - base64 encoded image.
+ * \param fileName - used if imageSource is empty.
+ * \return
+ */
+QImage BitmapAnnotation::loadImage(const QString &imageSource, const QString &fileName)
+{
+  QString key;
+  if (!imageSource.isEmpty()) {
+    key = QString("source:") + QCryptographicHash::hash(imageSource.toLatin1(), QCryptographicHash::Sha1).toHex();
+  } else if (!fileName.isEmpty()) {
+    QFileInfo fileInfo(fileName);
+    key = QString("file:%1:%2").arg(fileInfo.absoluteFilePath()).arg(fileInfo.lastModified().toString(Qt::ISODate));
+  } else {
+    key = QString("default");
+  }
+  QImage *pImage = mImagesCache.object(key);
+  if (pImage) {
+    return *pImage;
+  }
+  QImage image;
+  if (!imageSource.isEmpty()) {
+    image.loadFromData(QByteArray::fromBase64(imageSource.toLatin1()));
+  } else if (!fileName.isEmpty()) {
+    image.load(fileName);
   } else {
-    mImage = QImage(":/Resources/icons/bitmap-shape.svg");
+    image = QImage(":/Resources/icons/bitmap-shape.svg");
   }
+  mImagesCache.insert(key, new QImage(image), qMax(image.byteCount() / 1024, 1));
+  return image;
 }
 
 QRectF BitmapAnnotation::boundingRect() const
@@ -127,9 +160,31 @@ void BitmapAnnotation::paint(QPainter *painter, const QStyleOptionGraphicsItem *
     drawBitmapAnnotaion(painter);
 }
 
+/*!
+ * \brief BitmapAnnotation::drawBitmapAnnotaion
+ * Draws the image mirrored and scaled to the size in device pixels.\n
+ * The mirrored and scaled pixmaps are kept in QPixmapCache and shared by all the bitmaps showing the same image.
+ * \param painter
+ */
 void BitmapAnnotation::drawBitmapAnnotaion(QPainter *painter)
 {
-  painter->drawImage(getBoundingRect(), mImage.mirrored());
+  QRectF rect = getBoundingRect();
+  if (mImage.isNull()) {
+    return;
+  }
+  // never make the pixmap larger than the image. The painter scales it up when zoomed in.
+  QSize size = painter->transform().mapRect(rect).toAlignedRect().size().boundedTo(mImage.size());
+  if (size.isEmpty()) {
+    return;
+  }
+  // copies of a QImage share its cache key.
+  QString key = QString("OMEditBitmap_%1_%2x%3").arg(mImage.cacheKey()).arg(size.width()).arg(size.height());
+  QPixmap pixmap;
+  if (!QPixmapCache::find(key, &pixmap)) {
+    pixmap = QPixmap::fromImage(mImage.mirrored().scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
+    QPixmapCache::insert(key, pixmap);
+  }
+  painter->drawPixmap(rect, pixmap, QRectF(pixmap.rect()));
 }
 
 /*!
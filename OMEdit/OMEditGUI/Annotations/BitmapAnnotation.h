@@ -61,8 +61,10 @@ public:
   QString getOMCShapeAnnotation();
   QString getShapeAnnotation();
   void updateShape(ShapeAnnotation *pShapeAnnotation);
+  static QImage loadImage(const QString &imageSource, const QString &fileName);
 private:
   Component *mpComponent;
+  static QCache<QString, QImage> mImagesCache;
 public slots:
   void duplicate();
 };
@@ -77,25 +77,24 @@ EllipseAnnotation::EllipseAnnotation(ShapeAnnotation *pShapeAnnotation, Graphics
 
 void EllipseAnnotation::parseShapeAnnotation(QString annotation)
 {
-  GraphicItem::parseShapeAnnotation(annotation);
-  FilledShape::parseShapeAnnotation(annotation);
-  // parse the shape to get the list of attributes of Ellipse.
-  QStringList list = StringHandler::getStrings(annotation);
+  // tokenize the shape once to get the list of attributes of Ellipse.
+  OMCValueTree list(annotation);
+  GraphicItem::parseShapeAnnotation(list);
+  FilledShape::parseShapeAnnotation(list);
   if (list.size() < 11) {
     return;
   }
   // 9th item is the extent points
-  QStringList extentsList = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(list.at(8)));
+  OMCValueTree::Node extentsList = list.at(8);
   for (int i = 0 ; i < qMin(extentsList.size(), 2) ; i++) {
-    QStringList extentPoints = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(extentsList[i]));
-    if (extentPoints.size() >= 2) {
-      mExtents.replace(i, QPointF(extentPoints.at(0).toFloat(), extentPoints.at(1).toFloat()));
+    if (extentsList.at(i).size() >= 2) {
+      mExtents.replace(i, extentsList.at(i).toPoint());
     }
   }
   // 10th item of the list contains the start angle.
-  mStartAngle = list.at(9).toFloat();
+  mStartAngle = list.at(9).toReal();
   // 11th item of the list contains the end angle.
-  mEndAngle = list.at(10).toFloat();
+  mEndAngle = list.at(10).toReal();
 }
 
 QRectF EllipseAnnotation::boundingRect() const
@@ -105,23 +104,19 @@ QRectF EllipseAnnotation::boundingRect() const
 
 QPainterPath EllipseAnnotation::shape() const
 {
+  if (isGeometryCacheValid()) {
+    return mGeometryCache.getShape();
+  }
   QPainterPath path;
+  path.addEllipse(getBoundingRect());
   qreal startAngle = StringHandler::getNormalizedAngle(mStartAngle);
   qreal endAngle = StringHandler::getNormalizedAngle(mEndAngle);
-  if ((startAngle - endAngle) == 0)
-  {
-    path.addEllipse(getBoundingRect());
-    if (mFillPattern == StringHandler::FillNone)
-    {
-      return addPathStroker(path);
-    }
-    else
-    {
-      return path;
-    }
+  if ((startAngle - endAngle) == 0 && mFillPattern == StringHandler::FillNone) {
+    updateGeometryCache(path, addPathStroker(path));
+  } else {
+    updateGeometryCache(path, path);
   }
-  path.addEllipse(getBoundingRect());
-  return path;
+  return mGeometryCache.getShape();
 }
 
 void EllipseAnnotation::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
@@ -136,7 +131,6 @@ void EllipseAnnotation::paint(QPainter *painter, const QStyleOptionGraphicsItem
 
 void EllipseAnnotation::drawEllipseAnnotaion(QPainter *painter)
 {
-  QPainterPath path;
   // first we invert the painter since we have our coordinate system inverted.
   // inversion is required to draw the elliptic curves at correct angles.
   painter->scale(1.0, -1.0);
@@ -146,8 +140,8 @@ void EllipseAnnotation::drawEllipseAnnotaion(QPainter *painter)
   qreal startAngle = StringHandler::getNormalizedAngle(mStartAngle);
   qreal endAngle = StringHandler::getNormalizedAngle(mEndAngle);
   if ((startAngle - endAngle) == 0) {
-    path.addEllipse(getBoundingRect());
-    painter->drawPath(path);
+    // boundingRect() above makes sure that the geometry cache is up to date.
+    painter->drawPath(mGeometryCache.getPath());
   } else {
     painter->drawPie(getBoundingRect(), mStartAngle*16, mEndAngle*16 - mStartAngle*16);
   }
@@ -217,6 +211,7 @@ void EllipseAnnotation::updateShape(ShapeAnnotation *pShapeAnnotation)
   GraphicItem::setDefaults(pShapeAnnotation);
   FilledShape::setDefaults(pShapeAnnotation);
   ShapeAnnotation::setDefaults(pShapeAnnotation);
+  shareGeometryCache(pShapeAnnotation);
 }
 
 /*!
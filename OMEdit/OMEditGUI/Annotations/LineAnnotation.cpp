@@ -44,6 +44,7 @@ LineAnnotation::LineAnnotation(QString annotation, GraphicsView *pGraphicsView)
   setLineType(LineAnnotation::ShapeType);
   setStartComponent(0);
   setEndComponent(0);
+  mMovedComponents = 0;
   setDelay("");
   setZf("");
   setZfr("");
@@ -64,6 +65,7 @@ LineAnnotation::LineAnnotation(ShapeAnnotation *pShapeAnnotation, Component *pPa
   setLineType(LineAnnotation::ComponentType);
   setStartComponent(0);
   setEndComponent(0);
+  mMovedComponents = 0;
   setDelay("");
   setZf("");
   setZfr("");
@@ -80,6 +82,7 @@ LineAnnotation::LineAnnotation(ShapeAnnotation *pShapeAnnotation, GraphicsView *
   : ShapeAnnotation(true, pGraphicsView, 0)
 {
   updateShape(pShapeAnnotation);
+  mMovedComponents = 0;
   setShapeFlags(true);
   mpGraphicsView->addItem(this);
   connect(pShapeAnnotation, SIGNAL(updateReferenceShapes()), pShapeAnnotation, SIGNAL(changed()));
@@ -107,6 +110,7 @@ LineAnnotation::LineAnnotation(Component *pStartComponent, GraphicsView *pGraphi
   // set the start component
   setStartComponent(pStartComponent);
   setEndComponent(0);
+  mMovedComponents = 0;
   setDelay("");
   setZf("");
   setZfr("");
@@ -126,6 +130,7 @@ LineAnnotation::LineAnnotation(QString annotation, Component *pStartComponent, C
   setStartComponent(pStartComponent);
   // set the end component
   setEndComponent(pEndComponent);
+  mMovedComponents = 0;
   setDelay("");
   setZf("");
   setZfr("");
@@ -149,6 +154,7 @@ LineAnnotation::LineAnnotation(Component *pParent)
   setLineType(LineAnnotation::ComponentType);
   setStartComponent(0);
   setEndComponent(0);
+  mMovedComponents = 0;
   setDelay("");
   setZf("");
   setZfr("");
@@ -177,6 +183,7 @@ LineAnnotation::LineAnnotation(GraphicsView *pGraphicsView)
   setLineType(LineAnnotation::ShapeType);
   setStartComponent(0);
   setEndComponent(0);
+  mMovedComponents = 0;
   setDelay("");
   setZf("");
   setZfr("");
@@ -203,48 +210,45 @@ LineAnnotation::LineAnnotation(GraphicsView *pGraphicsView)
 
 void LineAnnotation::parseShapeAnnotation(QString annotation)
 {
-  GraphicItem::parseShapeAnnotation(annotation);
-  // parse the shape to get the list of attributes of Line.
-  QStringList list = StringHandler::getStrings(annotation);
+  // tokenize the shape once to get the list of attributes of Line.
+  OMCValueTree list(annotation);
+  GraphicItem::parseShapeAnnotation(list);
   if (list.size() < 10) {
     return;
   }
   mPoints.clear();
   // 4th item of list contains the points.
-  QStringList pointsList = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(list.at(3)));
-  foreach (QString point, pointsList) {
-    QStringList linePoints = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(point));
-    if (linePoints.size() >= 2) {
-      addPoint(QPointF(linePoints.at(0).toFloat(), linePoints.at(1).toFloat()));
+  OMCValueTree::Node pointsList = list.at(3);
+  for (int i = 0 ; i < pointsList.size() ; i++) {
+    if (pointsList.at(i).size() >= 2) {
+      addPoint(pointsList.at(i).toPoint());
     }
   }
   // 5th item of list contains the color.
-  QStringList colorList = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(list.at(4)));
-  if (colorList.size() >= 3) {
-    int red, green, blue = 0;
-    red = colorList.at(0).toInt();
-    green = colorList.at(1).toInt();
-    blue = colorList.at(2).toInt();
-    mLineColor = QColor (red, green, blue);
+  if (list.at(4).size() >= 3) {
+    mLineColor = list.at(4).toColor();
   }
   // 6th item of list contains the Line Pattern.
-  mLinePattern = StringHandler::getLinePatternType(list.at(5));
+  mLinePattern = StringHandler::getLinePatternType(list.at(5).toString());
   // 7th item of list contains the Line thickness.
-  mLineThickness = list.at(6).toFloat();
+  mLineThickness = list.at(6).toReal();
   // 8th item of list contains the Line Arrows.
-  QStringList arrowList = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(list.at(7)));
+  OMCValueTree::Node arrowList = list.at(7);
   if (arrowList.size() >= 2) {
-    mArrow.replace(0, StringHandler::getArrowType(arrowList.at(0)));
-    mArrow.replace(1, StringHandler::getArrowType(arrowList.at(1)));
+    mArrow.replace(0, StringHandler::getArrowType(arrowList.at(0).toString()));
+    mArrow.replace(1, StringHandler::getArrowType(arrowList.at(1).toString()));
   }
   // 9th item of list contains the Line Arrow Size.
-  mArrowSize = list.at(8).toFloat();
+  mArrowSize = list.at(8).toReal();
   // 10th item of list contains the smooth.
-  mSmooth = StringHandler::getSmoothType(list.at(9));
+  mSmooth = StringHandler::getSmoothType(list.at(9).toString());
 }
 
 QPainterPath LineAnnotation::getShape() const
 {
+  if (isGeometryCacheValid()) {
+    return mGeometryCache.getPath();
+  }
   QPainterPath path;
   if (mPoints.size() > 0) {
     // mPoints.size() is at least 1
@@ -275,6 +279,7 @@ QPainterPath LineAnnotation::getShape() const
       }
     }
   }
+  updateGeometryCache(path, addPathStroker(path));
   return path;
 }
 
@@ -285,8 +290,9 @@ QRectF LineAnnotation::boundingRect() const
 
 QPainterPath LineAnnotation::shape() const
 {
-  QPainterPath path = getShape();
-  return addPathStroker(path);
+  // getShape() makes sure that the geometry cache is up to date.
+  getShape();
+  return mGeometryCache.getShape();
 }
 
 void LineAnnotation::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
@@ -711,40 +717,89 @@ void LineAnnotation::updateShape(ShapeAnnotation *pShapeAnnotation)
   for (int i = 0 ; i < points.size() ; i++) {
     addPoint(points[i]);
   }
+  // share the point data with the reference shape.
+  mPoints = points;
   ShapeAnnotation::setDefaults(pShapeAnnotation);
+  shareGeometryCache(pShapeAnnotation);
 }
 
 /*!
  * \brief LineAnnotation::handleComponentMoved
  * If the component associated with the connection is moved then update the connection accordingly.\n
- * If the both start and end components associated with the connection are moved then move whole connection.
+ * While the user drags the components the update is scheduled with GraphicsView::scheduleConnectionUpdate so that
+ * a connection whose both ends move is re-routed only once.
  */
 void LineAnnotation::handleComponentMoved()
 {
   if (mPoints.size() < 2) {
     return;
   }
+  Component *pComponent = qobject_cast<Component*>(sender());
+  bool scheduled = mMovedComponents != 0;
+  if (mpStartComponent && pComponent == mpStartComponent->getRootParentComponent()) {
+    mMovedComponents |= StartComponentMoved;
+  }
+  if (mpEndComponent && pComponent == mpEndComponent->getRootParentComponent()) {
+    mMovedComponents |= EndComponentMoved;
+  }
+  if (mMovedComponents == 0) {
+    mMovedComponents = OtherComponentMoved;
+  }
+  if (mpGraphicsView->isMovingComponentsAndShapes()) {
+    if (!scheduled) {
+      mpGraphicsView->scheduleConnectionUpdate(this);
+    }
+  } else {
+    QHash<Component*, QPointF> connectorsScenePositions;
+    updateConnectionPoints(&connectorsScenePositions);
+  }
+}
+
+/*!
+ * \brief LineAnnotation::updateConnectionPoints
+ * Moves the connection points to the positions of the moved start and end components.
+ * \param pConnectorsScenePositions - the scene positions of the connectors computed so far. Shared by all the connections updated together.
+ */
+void LineAnnotation::updateConnectionPoints(QHash<Component*, QPointF> *pConnectorsScenePositions)
+{
+  int movedComponents = mMovedComponents;
+  mMovedComponents = 0;
+  if (movedComponents == 0 || mPoints.size() < 2) {
+    return;
+  }
   prepareGeometryChange();
   if (mpStartComponent && mpStartComponent->getRootParentComponent()->isSelected() &&
       mpEndComponent && mpEndComponent->getRootParentComponent()->isSelected()) {
-    moveAllPoints(mpStartComponent->mapToScene(mpStartComponent->boundingRect().center()).x() - mPoints[0].x(),
-        mpStartComponent->mapToScene(mpStartComponent->boundingRect().center()).y() - mPoints[0].y());
+    QPointF startPoint = getConnectorScenePosition(mpStartComponent, pConnectorsScenePositions);
+    moveAllPoints(startPoint.x() - mPoints[0].x(), startPoint.y() - mPoints[0].y());
   } else {
-    if (mpStartComponent) {
-      Component *pComponent = qobject_cast<Component*>(sender());
-      if (pComponent == mpStartComponent->getRootParentComponent()) {
-        updateStartPoint(mpGraphicsView->roundPoint(mpStartComponent->mapToScene(mpStartComponent->boundingRect().center())));
-      }
+    if (mpStartComponent && (movedComponents & StartComponentMoved)) {
+      updateStartPoint(mpGraphicsView->roundPoint(getConnectorScenePosition(mpStartComponent, pConnectorsScenePositions)));
     }
-    if (mpEndComponent) {
-      Component *pComponent = qobject_cast<Component*>(sender());
-      if (pComponent == mpEndComponent->getRootParentComponent()) {
-        updateEndPoint(mpGraphicsView->roundPoint(mpEndComponent->mapToScene(mpEndComponent->boundingRect().center())));
-      }
+    if (mpEndComponent && (movedComponents & EndComponentMoved)) {
+      updateEndPoint(mpGraphicsView->roundPoint(getConnectorScenePosition(mpEndComponent, pConnectorsScenePositions)));
     }
   }
 }
 
+/*!
+ * \brief LineAnnotation::getConnectorScenePosition
+ * Returns the scene position of the connector center. Computes it only once per connector.
+ * \param pComponent - the connector.
+ * \param pConnectorsScenePositions
+ * \return
+ */
+QPointF LineAnnotation::getConnectorScenePosition(Component *pComponent, QHash<Component*, QPointF> *pConnectorsScenePositions)
+{
+  QHash<Component*, QPointF>::const_iterator iterator = pConnectorsScenePositions->constFind(pComponent);
+  if (iterator != pConnectorsScenePositions->constEnd()) {
+    return iterator.value();
+  }
+  QPointF position = pComponent->mapToScene(pComponent->boundingRect().center());
+  pConnectorsScenePositions->insert(pComponent, position);
+  return position;
+}
+
 /*!
  * \brief LineAnnotation::updateConnectionAnnotation
  * Updates the connection annotation.
@@ -102,7 +102,13 @@ public:
   QString getAlpha() {return mAlpha;}
   void setShapeFlags(bool enable);
   void updateShape(ShapeAnnotation *pShapeAnnotation);
+  void updateConnectionPoints(QHash<Component*, QPointF> *pConnectorsScenePositions);
 private:
+  enum MovedComponent {
+    StartComponentMoved = 1,
+    EndComponentMoved = 2,
+    OtherComponentMoved = 4
+  };
   LineType mLineType;
   Component *mpStartComponent;
   QString mStartComponentName;
@@ -113,6 +119,8 @@ private:
   QString mZf;
   QString mZfr;
   QString mAlpha;
+  int mMovedComponents;
+  static QPointF getConnectorScenePosition(Component *pComponent, QHash<Component*, QPointF> *pConnectorsScenePositions);
 public slots:
   void handleComponentMoved();
   void updateConnectionAnnotation();
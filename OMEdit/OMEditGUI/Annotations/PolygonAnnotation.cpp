@@ -77,20 +77,19 @@ PolygonAnnotation::PolygonAnnotation(ShapeAnnotation *pShapeAnnotation, Graphics
 
 void PolygonAnnotation::parseShapeAnnotation(QString annotation)
 {
-  GraphicItem::parseShapeAnnotation(annotation);
-  FilledShape::parseShapeAnnotation(annotation);
-  // parse the shape to get the list of attributes of Polygon.
-  QStringList list = StringHandler::getStrings(annotation);
+  // tokenize the shape once to get the list of attributes of Polygon.
+  OMCValueTree list(annotation);
+  GraphicItem::parseShapeAnnotation(list);
+  FilledShape::parseShapeAnnotation(list);
   if (list.size() < 10) {
     return;
   }
   mPoints.clear();
   // 9th item of list contains the points.
-  QStringList pointsList = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(list.at(8)));
-  foreach (QString point, pointsList) {
-    QStringList polygonPoints = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(point));
-    if (polygonPoints.size() >= 2) {
-      mPoints.append(QPointF(polygonPoints.at(0).toFloat(), polygonPoints.at(1).toFloat()));
+  OMCValueTree::Node pointsList = list.at(8);
+  for (int i = 0 ; i < pointsList.size() ; i++) {
+    if (pointsList.at(i).size() >= 2) {
+      mPoints.append(pointsList.at(i).toPoint());
     }
   }
   /* The polygon is automatically closed, if the first and the last points are not identical. */
@@ -106,11 +105,14 @@ void PolygonAnnotation::parseShapeAnnotation(QString annotation)
     }
   }
   // 10th item of the list is smooth.
-  mSmooth = StringHandler::getSmoothType(list.at(9));
+  mSmooth = StringHandler::getSmoothType(list.at(9).toString());
 }
 
 QPainterPath PolygonAnnotation::getShape() const
 {
+  if (isGeometryCacheValid()) {
+    return mGeometryCache.getPath();
+  }
   QPainterPath path;
   if (mPoints.size() > 0) {
     if (mSmooth) {
@@ -138,6 +140,11 @@ QPainterPath PolygonAnnotation::getShape() const
       path.addPolygon(QPolygonF(mPoints.toVector()));
     }
   }
+  if (mFillPattern == StringHandler::FillNone) {
+    updateGeometryCache(path, addPathStroker(path));
+  } else {
+    updateGeometryCache(path, path);
+  }
   return path;
 }
 
@@ -148,12 +155,9 @@ QRectF PolygonAnnotation::boundingRect() const
 
 QPainterPath PolygonAnnotation::shape() const
 {
-  QPainterPath path = getShape();
-  if (mFillPattern == StringHandler::FillNone) {
-    return addPathStroker(path);
-  } else {
-    return path;
-  }
+  // getShape() makes sure that the geometry cache is up to date.
+  getShape();
+  return mGeometryCache.getShape();
 }
 
 void PolygonAnnotation::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
@@ -268,6 +272,7 @@ void PolygonAnnotation::updateShape(ShapeAnnotation *pShapeAnnotation)
   mPoints.clear();
   setPoints(pShapeAnnotation->getPoints());
   ShapeAnnotation::setDefaults(pShapeAnnotation);
+  shareGeometryCache(pShapeAnnotation);
 }
 
 /*!
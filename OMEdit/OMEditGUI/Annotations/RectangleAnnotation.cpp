@@ -95,25 +95,24 @@ RectangleAnnotation::RectangleAnnotation(Component *pParent)
 
 void RectangleAnnotation::parseShapeAnnotation(QString annotation)
 {
-  GraphicItem::parseShapeAnnotation(annotation);
-  FilledShape::parseShapeAnnotation(annotation);
-  // parse the shape to get the list of attributes of Rectangle.
-  QStringList list = StringHandler::getStrings(annotation);
+  // tokenize the shape once to get the list of attributes of Rectangle.
+  OMCValueTree list(annotation);
+  GraphicItem::parseShapeAnnotation(list);
+  FilledShape::parseShapeAnnotation(list);
   if (list.size() < 11) {
     return;
   }
   // 9th item of the list contains the border pattern.
-  mBorderPattern = StringHandler::getBorderPatternType(list.at(8));
+  mBorderPattern = StringHandler::getBorderPatternType(list.at(8).toString());
   // 10th item is the extent points
-  QStringList extentsList = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(list.at(9)));
+  OMCValueTree::Node extentsList = list.at(9);
   for (int i = 0 ; i < qMin(extentsList.size(), 2) ; i++) {
-    QStringList extentPoints = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(extentsList[i]));
-    if (extentPoints.size() >= 2) {
-      mExtents.replace(i, QPointF(extentPoints.at(0).toFloat(), extentPoints.at(1).toFloat()));
+    if (extentsList.at(i).size() >= 2) {
+      mExtents.replace(i, extentsList.at(i).toPoint());
     }
   }
   // 11th item of the list contains the corner radius.
-  mRadius = list.at(10).toFloat();
+  mRadius = list.at(10).toReal();
 }
 
 QRectF RectangleAnnotation::boundingRect() const
@@ -123,12 +122,17 @@ QRectF RectangleAnnotation::boundingRect() const
 
 QPainterPath RectangleAnnotation::shape() const
 {
+  if (isGeometryCacheValid()) {
+    return mGeometryCache.getShape();
+  }
   QPainterPath path;
   path.addRoundedRect(getBoundingRect(), mRadius, mRadius);
-  if (mFillPattern == StringHandler::FillNone)
-    return addPathStroker(path);
-  else
-    return path;
+  if (mFillPattern == StringHandler::FillNone) {
+    updateGeometryCache(path, addPathStroker(path));
+  } else {
+    updateGeometryCache(path, path);
+  }
+  return mGeometryCache.getShape();
 }
 
 void RectangleAnnotation::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
@@ -212,6 +216,7 @@ void RectangleAnnotation::updateShape(ShapeAnnotation *pShapeAnnotation)
   GraphicItem::setDefaults(pShapeAnnotation);
   FilledShape::setDefaults(pShapeAnnotation);
   ShapeAnnotation::setDefaults(pShapeAnnotation);
+  shareGeometryCache(pShapeAnnotation);
 }
 
 /*!
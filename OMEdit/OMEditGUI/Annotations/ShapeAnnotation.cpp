@@ -70,21 +70,27 @@ void GraphicItem::setDefaults(ShapeAnnotation *pShapeAnnotation)
   */
 void GraphicItem::parseShapeAnnotation(QString annotation)
 {
-  // parse the shape to get the list of attributes
-  QStringList list = StringHandler::getStrings(annotation);
-  if (list.size() < 3)
+  parseShapeAnnotation(OMCValueTree(annotation));
+}
+
+/*!
+ * \brief GraphicItem::parseShapeAnnotation
+ * Parses the GraphicItem attributes from the already tokenized shape annotation.
+ * \param annotation
+ */
+void GraphicItem::parseShapeAnnotation(const OMCValueTree &annotation)
+{
+  if (annotation.size() < 3) {
     return;
+  }
   // if first item of list is true then the shape should be visible.
-  mVisible = list.at(0).contains("true");
+  mVisible = annotation.at(0).toBool();
   // 2nd item is the origin
-  QStringList originList = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(list.at(1)));
-  if (originList.size() >= 2)
-  {
-    mOrigin.setX(originList.at(0).toFloat());
-    mOrigin.setY(originList.at(1).toFloat());
+  if (annotation.at(1).size() >= 2) {
+    mOrigin = annotation.at(1).toPoint();
   }
   // 3rd item is the rotation
-  mRotation = list.at(2).toFloat();
+  mRotation = annotation.at(2).toReal();
 }
 
 /*!
@@ -167,36 +173,33 @@ void FilledShape::setDefaults(ShapeAnnotation *pShapeAnnotation)
   */
 void FilledShape::parseShapeAnnotation(QString annotation)
 {
-  // parse the shape to get the list of attributes
-  QStringList list = StringHandler::getStrings(annotation);
-  if (list.size() < 8)
+  parseShapeAnnotation(OMCValueTree(annotation));
+}
+
+/*!
+ * \brief FilledShape::parseShapeAnnotation
+ * Parses the FilledShape attributes from the already tokenized shape annotation.
+ * \param annotation
+ */
+void FilledShape::parseShapeAnnotation(const OMCValueTree &annotation)
+{
+  if (annotation.size() < 8) {
     return;
+  }
   // 4th item of the list is the line color
-  QStringList colorList = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(list.at(3)));
-  if (colorList.size() >= 3)
-  {
-    int red, green, blue = 0;
-    red = colorList.at(0).toInt();
-    green = colorList.at(1).toInt();
-    blue = colorList.at(2).toInt();
-    mLineColor = QColor (red, green, blue);
+  if (annotation.at(3).size() >= 3) {
+    mLineColor = annotation.at(3).toColor();
   }
   // 5th item of list contains the fill color.
-  QStringList fillColorList = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(list.at(4)));
-  if (fillColorList.size() >= 3)
-  {
-    int red, green, blue = 0;
-    red = fillColorList.at(0).toInt();
-    green = fillColorList.at(1).toInt();
-    blue = fillColorList.at(2).toInt();
-    mFillColor = QColor (red, green, blue);
+  if (annotation.at(4).size() >= 3) {
+    mFillColor = annotation.at(4).toColor();
   }
   // 6th item of list contains the Line Pattern.
-  mLinePattern = StringHandler::getLinePatternType(list.at(5));
+  mLinePattern = StringHandler::getLinePatternType(annotation.at(5).toString());
   // 7th item of list contains the Fill Pattern.
-  mFillPattern = StringHandler::getFillPatternType(list.at(6));
+  mFillPattern = StringHandler::getFillPatternType(annotation.at(6).toString());
   // 8th item of list contains the thickness.
-  mLineThickness = list.at(7).toFloat();
+  mLineThickness = annotation.at(7).toReal();
 }
 
 /*!
@@ -275,6 +278,44 @@ QStringList FilledShape::getShapeAnnotation()
   return annotationString;
 }
 
+ShapeGeometryData::ShapeGeometryData()
+  : mSmooth(StringHandler::SmoothNone), mRadius(0), mStartAngle(0), mEndAngle(0), mFillPattern(StringHandler::FillNone)
+{
+}
+
+/*!
+ * \brief ShapeGeometry::isEqual
+ * Returns true if the geometry is same as the cached geometry.
+ * \return
+ */
+bool ShapeGeometry::isEqual(const QList<QPointF> &points, const QList<QPointF> &extents, StringHandler::Smooth smooth, qreal radius,
+                            qreal startAngle, qreal endAngle, StringHandler::FillPattern fillPattern) const
+{
+  return isValid() && d->mSmooth == smooth && d->mRadius == radius && d->mStartAngle == startAngle && d->mEndAngle == endAngle
+      && d->mFillPattern == fillPattern && d->mPoints == points && d->mExtents == extents;
+}
+
+/*!
+ * \brief ShapeGeometry::update
+ * Caches the geometry and the paths built from it.\n
+ * A new ShapeGeometryData is created so the shapes sharing the old one keep their paths.
+ */
+void ShapeGeometry::update(const QList<QPointF> &points, const QList<QPointF> &extents, StringHandler::Smooth smooth, qreal radius,
+                           qreal startAngle, qreal endAngle, StringHandler::FillPattern fillPattern, const QPainterPath &path,
+                           const QPainterPath &shape)
+{
+  d = new ShapeGeometryData;
+  d->mPoints = points;
+  d->mExtents = extents;
+  d->mSmooth = smooth;
+  d->mRadius = radius;
+  d->mStartAngle = startAngle;
+  d->mEndAngle = endAngle;
+  d->mFillPattern = fillPattern;
+  d->mPath = path;
+  d->mShape = shape;
+}
+
 /*!
   \class ShapeAnnotation
   \brief The base class for all shapes LineAnnotation, PolygonAnnotation, RectangleAnnotation, EllipseAnnotation, TextAnnotation,
@@ -570,6 +611,42 @@ QString ShapeAnnotation::getShapeAnnotation()
   return "";
 }
 
+/*!
+ * \brief ShapeAnnotation::isGeometryCacheValid
+ * Returns true if the cached paths are built from the current geometry of the shape.\n
+ * The lists are compared by their shared data first so the check is cheap for the shapes sharing the geometry of the class shape.
+ * \return
+ */
+bool ShapeAnnotation::isGeometryCacheValid() const
+{
+  return mGeometryCache.isEqual(mPoints, mExtents, mSmooth, mRadius, mStartAngle, mEndAngle, mFillPattern);
+}
+
+/*!
+ * \brief ShapeAnnotation::updateGeometryCache
+ * Caches the paths built from the current geometry of the shape.
+ * \param path - the path used for drawing the shape.
+ * \param shape - the path returned by QGraphicsItem::shape().
+ */
+void ShapeAnnotation::updateGeometryCache(const QPainterPath &path, const QPainterPath &shape) const
+{
+  mGeometryCache.update(mPoints, mExtents, mSmooth, mRadius, mStartAngle, mEndAngle, mFillPattern, path, shape);
+}
+
+/*!
+ * \brief ShapeAnnotation::shareGeometryCache
+ * Shares the cached geometry and paths of the reference shape.\n
+ * Builds the cache of the reference shape first if needed so all the shapes inheriting it use the same paths.
+ * \param pShapeAnnotation - the reference shape.
+ */
+void ShapeAnnotation::shareGeometryCache(ShapeAnnotation *pShapeAnnotation)
+{
+  if (!pShapeAnnotation->isGeometryCacheValid()) {
+    pShapeAnnotation->shape();
+  }
+  mGeometryCache = pShapeAnnotation->mGeometryCache;
+}
+
 /*!
  * \brief ShapeAnnotation::initializeTransformation
  * Initializes the transformation matrix with the default transformation values of the shape.
@@ -1655,3 +1732,80 @@ QVariant ShapeAnnotation::itemChange(GraphicsItemChange change, const QVariant &
   }
   return value;
 }
+
+/*!
+ * \class ReferenceShapeItem
+ * \brief Draws a shape of a class inside a component instance.
+ */
+/*!
+ * \brief ReferenceShapeItem::ReferenceShapeItem
+ * \param pShapeAnnotation - the shape of the class.
+ * \param pParent - the component instance.
+ */
+ReferenceShapeItem::ReferenceShapeItem(ShapeAnnotation *pShapeAnnotation, Component *pParent)
+  : QGraphicsItem(pParent), mpShapeAnnotation(pShapeAnnotation), mpParentComponent(pParent)
+{
+  updateGeometry();
+  connect(pShapeAnnotation, SIGNAL(updateReferenceShapes()), pShapeAnnotation, SIGNAL(changed()), Qt::UniqueConnection);
+  connect(pShapeAnnotation, SIGNAL(added()), this, SLOT(referenceShapeAdded()));
+  connect(pShapeAnnotation, SIGNAL(changed()), this, SLOT(referenceShapeChanged()));
+  connect(pShapeAnnotation, SIGNAL(deleted()), this, SLOT(referenceShapeDeleted()));
+}
+
+QRectF ReferenceShapeItem::boundingRect() const
+{
+  return mBoundingRect;
+}
+
+QPainterPath ReferenceShapeItem::shape() const
+{
+  return mpShapeAnnotation ? mpShapeAnnotation->shape() : QPainterPath();
+}
+
+void ReferenceShapeItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+  if (mpShapeAnnotation) {
+    mpShapeAnnotation->paint(painter, option, widget);
+  }
+}
+
+/*!
+ * \brief ReferenceShapeItem::updateGeometry
+ * Places the item at the origin and rotation of the shape like the shapes of the component do.\n
+ * The bounding rectangle is kept since the shape is already changed when referenceShapeChanged() calls prepareGeometryChange().
+ */
+void ReferenceShapeItem::updateGeometry()
+{
+  mBoundingRect = mpShapeAnnotation->boundingRect();
+  setPos(mpShapeAnnotation->getOrigin());
+  setRotation(mpShapeAnnotation->getRotation());
+}
+
+/*!
+ * \brief ReferenceShapeItem::referenceShapeAdded
+ */
+void ReferenceShapeItem::referenceShapeAdded()
+{
+  setVisible(true);
+  mpParentComponent->shapeAdded();
+}
+
+/*!
+ * \brief ReferenceShapeItem::referenceShapeChanged
+ */
+void ReferenceShapeItem::referenceShapeChanged()
+{
+  prepareGeometryChange();
+  updateGeometry();
+  update();
+  mpParentComponent->shapeUpdated();
+}
+
+/*!
+ * \brief ReferenceShapeItem::referenceShapeDeleted
+ */
+void ReferenceShapeItem::referenceShapeDeleted()
+{
+  setVisible(false);
+  mpParentComponent->shapeDeleted();
+}
@@ -46,6 +46,8 @@
 #include <QCheckBox>
 #include <QDialogButtonBox>
 #include <QVBoxLayout>
+#include <QSharedData>
+#include <QPointer>
 
 #include "Helper.h"
 #include "StringHandler.h"
@@ -64,6 +66,7 @@ public:
   void setDefaults();
   void setDefaults(ShapeAnnotation *pShapeAnnotation);
   void parseShapeAnnotation(QString annotation);
+  void parseShapeAnnotation(const OMCValueTree &annotation);
   QStringList getOMCShapeAnnotation();
   QStringList getShapeAnnotation();
   void setOrigin(QPointF origin) {mOrigin = origin;}
@@ -83,6 +86,7 @@ public:
   void setDefaults();
   void setDefaults(ShapeAnnotation *pShapeAnnotation);
   void parseShapeAnnotation(QString annotation);
+  void parseShapeAnnotation(const OMCValueTree &annotation);
   QStringList getOMCShapeAnnotation();
   QStringList getShapeAnnotation();
   void setLineColor(QColor color) {mLineColor = color;}
@@ -103,6 +107,45 @@ protected:
   qreal mLineThickness;
 };
 
+/*!
+ * \class ShapeGeometryData
+ * \brief The implicitly shared payload of ShapeGeometry.
+ */
+class ShapeGeometryData : public QSharedData
+{
+public:
+  ShapeGeometryData();
+  QList<QPointF> mPoints;
+  QList<QPointF> mExtents;
+  StringHandler::Smooth mSmooth;
+  qreal mRadius;
+  qreal mStartAngle;
+  qreal mEndAngle;
+  StringHandler::FillPattern mFillPattern;
+  QPainterPath mPath;
+  QPainterPath mShape;
+};
+
+/*!
+ * \class ShapeGeometry
+ * \brief Holds the geometry of a shape together with the QPainterPaths built from it.\n
+ * Copying a ShapeGeometry only copies the pointer to its ShapeGeometryData. The inherited shapes copy the ShapeGeometry of their
+ * reference shape so they draw the same paths. A shape only builds new paths when its geometry differs from the cached one.
+ */
+class ShapeGeometry
+{
+public:
+  bool isValid() const {return d.constData() != 0;}
+  bool isEqual(const QList<QPointF> &points, const QList<QPointF> &extents, StringHandler::Smooth smooth, qreal radius, qreal startAngle,
+               qreal endAngle, StringHandler::FillPattern fillPattern) const;
+  void update(const QList<QPointF> &points, const QList<QPointF> &extents, StringHandler::Smooth smooth, qreal radius, qreal startAngle,
+              qreal endAngle, StringHandler::FillPattern fillPattern, const QPainterPath &path, const QPainterPath &shape);
+  QPainterPath getPath() const {return isValid() ? d->mPath : QPainterPath();}
+  QPainterPath getShape() const {return isValid() ? d->mShape : QPainterPath();}
+private:
+  QSharedDataPointer<ShapeGeometryData> d;
+};
+
 class ShapeAnnotation : public QObject, public QGraphicsItem, public GraphicItem, public FilledShape
 {
   Q_OBJECT
@@ -126,6 +169,9 @@ public:
   void createActions();
   QPainterPath addPathStroker(QPainterPath &path) const;
   QRectF getBoundingRect() const;
+  bool isGeometryCacheValid() const;
+  void updateGeometryCache(const QPainterPath &path, const QPainterPath &shape) const;
+  void shareGeometryCache(ShapeAnnotation *pShapeAnnotation);
   void applyLinePattern(QPainter *painter);
   void applyFillPattern(QPainter *painter);
   virtual void parseShapeAnnotation(QString annotation);
@@ -256,8 +302,36 @@ protected:
   QString mImageSource;
   QImage mImage;
   QList<CornerItem*> mCornerItemsList;
+  mutable ShapeGeometry mGeometryCache;
   virtual void contextMenuEvent(QGraphicsSceneContextMenuEvent *pEvent);
   virtual QVariant itemChange(GraphicsItemChange change, const QVariant &value);
 };
 
+/*!
+ * \class ReferenceShapeItem
+ * \brief Draws a shape of a class inside a component instance.\n
+ * The instance doesn't copy the shape. It draws the shape of the class with its own position and rotation,
+ * so all the instances of a class share the shapes of the class.
+ */
+class ReferenceShapeItem : public QObject, public QGraphicsItem
+{
+  Q_OBJECT
+  Q_INTERFACES(QGraphicsItem)
+public:
+  ReferenceShapeItem(ShapeAnnotation *pShapeAnnotation, Component *pParent);
+  ShapeAnnotation* getShapeAnnotation() const {return mpShapeAnnotation;}
+  QRectF boundingRect() const;
+  QPainterPath shape() const;
+  void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget = 0);
+private:
+  QPointer<ShapeAnnotation> mpShapeAnnotation;
+  Component *mpParentComponent;
+  QRectF mBoundingRect;
+  void updateGeometry();
+public slots:
+  void referenceShapeAdded();
+  void referenceShapeChanged();
+  void referenceShapeDeleted();
+};
+
 #endif // SHAPEANNOTATION_H
@@ -38,6 +38,9 @@
 #include "TextAnnotation.h"
 #include "Commands.h"
 
+/* texts smaller than this on the screen are not drawn. */
+#define TEXT_MINIMUM_PIXEL_HEIGHT 3
+
 /*!
  * \class TextAnnotation
  * \brief Draws the text shapes.
@@ -49,7 +52,7 @@
  * \param pGraphicsView - pointer to GraphicsView
  */
 TextAnnotation::TextAnnotation(QString annotation, GraphicsView *pGraphicsView)
-  : ShapeAnnotation(false, pGraphicsView, 0)
+  : ShapeAnnotation(false, pGraphicsView, 0), mLayoutValid(false)
 {
   mpComponent = 0;
   // set the default values
@@ -63,7 +66,7 @@ TextAnnotation::TextAnnotation(QString annotation, GraphicsView *pGraphicsView)
 }
 
 TextAnnotation::TextAnnotation(ShapeAnnotation *pShapeAnnotation, Component *pParent)
-  : ShapeAnnotation(pParent), mpComponent(pParent)
+  : ShapeAnnotation(pParent), mpComponent(pParent), mLayoutValid(false)
 {
   updateShape(pShapeAnnotation);
   initUpdateTextString();
@@ -76,7 +79,7 @@ TextAnnotation::TextAnnotation(ShapeAnnotation *pShapeAnnotation, Component *pPa
 }
 
 TextAnnotation::TextAnnotation(ShapeAnnotation *pShapeAnnotation, GraphicsView *pGraphicsView)
-  : ShapeAnnotation(true, pGraphicsView, 0)
+  : ShapeAnnotation(true, pGraphicsView, 0), mLayoutValid(false)
 {
   mpComponent = 0;
   updateShape(pShapeAnnotation);
@@ -89,7 +92,7 @@ TextAnnotation::TextAnnotation(ShapeAnnotation *pShapeAnnotation, GraphicsView *
 }
 
 TextAnnotation::TextAnnotation(Component *pParent)
-  : ShapeAnnotation(pParent), mpComponent(pParent)
+  : ShapeAnnotation(pParent), mpComponent(pParent), mLayoutValid(false)
 {
   // set the default values
   GraphicItem::setDefaults();
@@ -226,44 +229,21 @@ void TextAnnotation::drawTextAnnotaion(QPainter *painter)
   applyLinePattern(painter);
   /* Don't apply the fill patterns on Text shapes. */
   /*applyFillPattern(painter);*/
-  qreal dx = ((-boundingRect().left()) - boundingRect().right());
-  qreal dy = ((-boundingRect().top()) - boundingRect().bottom());
+  QRectF rect = boundingRect();
+  updateTextLayout(painter, rect);
+  // level of detail. Skip the texts that are too small to read. Library pixmaps are rendered once so draw everything there.
+  if (!(mpGraphicsView && mpGraphicsView->isRenderingLibraryPixmap())) {
+    qreal scale = qSqrt(qAbs(painter->worldTransform().determinant()));
+    if (mLayoutTextHeight * scale < TEXT_MINIMUM_PIXEL_HEIGHT) {
+      return;
+    }
+  }
+  qreal dx = ((-rect.left()) - rect.right());
+  qreal dy = ((-rect.top()) - rect.bottom());
   // first we invert the painter since we have our coordinate system inverted.
   painter->scale(1.0, -1.0);
   painter->translate(0, dy);
-  mTextString = StringHandler::removeFirstLastQuotes(mTextString);
-  mTextString = StringHandler::unparse(QString("\"").append(mTextString).append("\""));
-  QFont font;
-  if (mFontSize > 0) {
-    font = QFont(mFontName, mFontSize, StringHandler::getFontWeight(mTextStyles), StringHandler::getFontItalic(mTextStyles));
-    // set font underline
-    if(StringHandler::getFontUnderline(mTextStyles)) {
-      font.setUnderline(true);
-    }
-    font.setPointSizeF(mFontSize/4);
-    painter->setFont(font);
-  } else {
-    font = QFont(mFontName, mFontSize, StringHandler::getFontWeight(mTextStyles), StringHandler::getFontItalic(mTextStyles));
-    // set font underline
-    if(StringHandler::getFontUnderline(mTextStyles)) {
-      font.setUnderline(true);
-    }
-    painter->setFont(font);
-    QRect fontBoundRect = painter->fontMetrics().boundingRect(boundingRect().toRect(), Qt::TextDontClip, mTextString);
-    float xFactor = boundingRect().width() / fontBoundRect.width();
-    float yFactor = boundingRect().height() / fontBoundRect.height();
-    float factor = xFactor < yFactor ? xFactor : yFactor;
-    QFont f = painter->font();
-    qreal fontSizeFactor = f.pointSizeF()*factor;
-    if ((fontSizeFactor < 12) && mpComponent) {
-      f.setPointSizeF(12);
-    } else if (fontSizeFactor <= 0) {
-      f.setPointSizeF(1);
-    } else {
-      f.setPointSizeF(fontSizeFactor);
-    }
-    painter->setFont(f);
-  }
+  painter->setFont(mLayoutFont);
   if (mpComponent) {
     Component *pComponent = mpComponent->getRootParentComponent();
     if (pComponent && pComponent->mTransformation.isValid()) {
@@ -305,15 +285,87 @@ void TextAnnotation::drawTextAnnotaion(QPainter *painter)
     qreal angle = StringHandler::getNormalizedAngle(mTransformation.getRotateAngle());
     if (angle == 180) {
       painter->scale(-1.0, -1.0);
-      painter->translate(((-boundingRect().left()) - boundingRect().right()), ((-boundingRect().top()) - boundingRect().bottom()));
+      painter->translate(dx, dy);
     }
   }
   // draw the font
-  if (mpComponent) {
-    painter->drawText(boundingRect(), StringHandler::getTextAlignment(mHorizontalAlignment) | Qt::AlignVCenter | Qt::TextDontClip, mTextString);
-  } else if (boundingRect().width() > 0 && boundingRect().height() > 0) {
-    painter->drawText(boundingRect(), StringHandler::getTextAlignment(mHorizontalAlignment) | Qt::AlignVCenter | Qt::TextDontClip, mTextString);
+  if (mpComponent || (rect.width() > 0 && rect.height() > 0)) {
+    if (mLayoutUseStaticText) {
+      // the same placement as QPainter::drawText with Qt::AlignVCenter and the horizontal alignment.
+      QSizeF size = mLayoutStaticText.size();
+      qreal x = rect.left();
+      Qt::Alignment alignment = StringHandler::getTextAlignment(mHorizontalAlignment);
+      if (alignment & Qt::AlignRight) {
+        x = rect.right() - size.width();
+      } else if (alignment & Qt::AlignHCenter) {
+        x = rect.left() + (rect.width() - size.width()) / 2;
+      }
+      painter->drawStaticText(QPointF(x, rect.top() + (rect.height() - size.height()) / 2), mLayoutStaticText);
+    } else {
+      painter->drawText(rect, StringHandler::getTextAlignment(mHorizontalAlignment) | Qt::AlignVCenter | Qt::TextDontClip, mTextString);
+    }
+  }
+}
+
+/*!
+ * \brief TextAnnotation::updateTextLayout
+ * Computes the font and the layout of the text. Does nothing if the text, font and size are unchanged since the last call.
+ * \param painter
+ * \param rect - the bounding rectangle of the text.
+ */
+void TextAnnotation::updateTextLayout(QPainter *painter, const QRectF &rect)
+{
+  // the quotes and escape sequences of the text are handled once per text change.
+  if (!mLayoutValid || mTextString.compare(mLayoutTextString) != 0) {
+    mTextString = StringHandler::removeFirstLastQuotes(mTextString);
+    mTextString = StringHandler::unparse(QString("\"").append(mTextString).append("\""));
+    mLayoutTextString = mTextString;
+    mLayoutValid = false;
+  }
+  int dpi = painter->device() ? painter->device()->logicalDpiY() : 0;
+  if (mLayoutValid && mLayoutFontName.compare(mFontName) == 0 && mLayoutFontSize == mFontSize && mLayoutTextStyles == mTextStyles
+      && mLayoutSize == rect.size() && mLayoutDpi == dpi) {
+    return;
+  }
+  QFont font = QFont(mFontName, mFontSize, StringHandler::getFontWeight(mTextStyles), StringHandler::getFontItalic(mTextStyles));
+  // set font underline
+  if(StringHandler::getFontUnderline(mTextStyles)) {
+    font.setUnderline(true);
+  }
+  if (mFontSize > 0) {
+    font.setPointSizeF(mFontSize/4);
+  } else {
+    QRect fontBoundRect = QFontMetrics(font, painter->device()).boundingRect(rect.toRect(), Qt::TextDontClip, mTextString);
+    float xFactor = rect.width() / fontBoundRect.width();
+    float yFactor = rect.height() / fontBoundRect.height();
+    float factor = xFactor < yFactor ? xFactor : yFactor;
+    qreal fontSizeFactor = font.pointSizeF()*factor;
+    if ((fontSizeFactor < 12) && mpComponent) {
+      font.setPointSizeF(12);
+    } else if (fontSizeFactor <= 0) {
+      font.setPointSizeF(1);
+    } else {
+      font.setPointSizeF(fontSizeFactor);
+    }
+  }
+  mLayoutFont = font;
+  mLayoutTextHeight = QFontMetricsF(font, painter->device()).height();
+  // QStaticText keeps the glyph layout between the paints. Use it for single line texts.
+  mLayoutUseStaticText = !mTextString.contains('\n');
+  if (mLayoutUseStaticText) {
+    mLayoutStaticText.setText(mTextString);
+    mLayoutStaticText.setTextFormat(Qt::PlainText);
+    mLayoutStaticText.setPerformanceHint(QStaticText::AggressiveCaching);
+    mLayoutStaticText.prepare(QTransform(), font);
+  } else {
+    mLayoutStaticText = QStaticText();
   }
+  mLayoutFontName = mFontName;
+  mLayoutFontSize = mFontSize;
+  mLayoutTextStyles = mTextStyles;
+  mLayoutSize = rect.size();
+  mLayoutDpi = dpi;
+  mLayoutValid = true;
 }
 
 /*!
@@ -65,7 +65,20 @@ public:
   void updateShape(ShapeAnnotation *pShapeAnnotation);
 private:
   Component *mpComponent;
+  /* the text layout cache. It is recomputed when the text, font or size of the text changes. */
+  bool mLayoutValid;
+  QString mLayoutTextString;
+  QString mLayoutFontName;
+  qreal mLayoutFontSize;
+  QList<StringHandler::TextStyle> mLayoutTextStyles;
+  QSizeF mLayoutSize;
+  int mLayoutDpi;
+  QFont mLayoutFont;
+  qreal mLayoutTextHeight;
+  bool mLayoutUseStaticText;
+  QStaticText mLayoutStaticText;
 
+  void updateTextLayout(QPainter *painter, const QRectF &rect);
   void initUpdateTextString();
   void updateTextStringHelper(QRegExp regExp);
 public slots:
@@ -0,0 +1,290 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES RECIPIENT'S ACCEPTANCE
+ * OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3, ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+
+#include "BatchMode.h"
+
+#include <stdio.h>
+
+/*!
+ * \brief BatchMode::BatchMode
+ * \param pMainWindow - the hidden MainWindow used to reach OMC and the libraries.
+ */
+BatchMode::BatchMode(MainWindow *pMainWindow)
+  : mpMainWindow(pMainWindow)
+{
+}
+
+/*!
+ * \brief BatchMode::printError
+ * Prints the message without its html tags to stderr.
+ * \param message
+ */
+void BatchMode::printError(const QString &message)
+{
+  fprintf(stderr, "%s\n", QString(message).remove(QRegExp("<[^>]*>")).toLocal8Bit().constData());
+}
+
+/*!
+ * \brief BatchMode::readScript
+ * Reads the batch commands from a script file. One command per line, empty lines and lines starting with # or // are skipped.
+ * \param fileName - the script file.
+ * \param pCommands - the list to append the commands to.
+ * \return true if the file is read.
+ */
+bool BatchMode::readScript(const QString &fileName, QStringList *pCommands)
+{
+  QFile file(fileName);
+  if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    printError(GUIMessages::getMessage(GUIMessages::ERROR_OPENING_FILE).arg(fileName).arg(file.errorString()));
+    return false;
+  }
+  QTextStream inStream(&file);
+  inStream.setCodec(Helper::utf8.toStdString().data());
+  while (!inStream.atEnd()) {
+    QString line = inStream.readLine().trimmed();
+    if (line.isEmpty() || line.startsWith("#") || line.startsWith("//")) {
+      continue;
+    }
+    pCommands->append(line);
+  }
+  file.close();
+  return true;
+}
+
+/*!
+ * \brief BatchMode::run
+ * Runs the commands in order. A failing command doesn't stop the following ones.
+ * \param commands
+ * \return 0 if all commands succeeded otherwise 1.
+ */
+int BatchMode::run(const QStringList &commands)
+{
+  int exitCode = 0;
+  foreach (QString command, commands) {
+    printf("%s\n", command.toLocal8Bit().constData());
+    fflush(stdout);
+    if (!runCommand(command)) {
+      fprintf(stderr, "Command failed: %s\n", command.toLocal8Bit().constData());
+      exitCode = 1;
+    }
+    mpMainWindow->getOMCProxy()->printMessagesStringInternal();
+    fflush(stdout);
+  }
+  return exitCode;
+}
+
+/*!
+ * \brief BatchMode::runCommand
+ * Dispatches a single command.
+ * \param command
+ * \return true on success.
+ */
+bool BatchMode::runCommand(const QString &command)
+{
+  QStringList arguments = command.split(QRegExp("\\s+"), QString::SkipEmptyParts);
+  if (arguments.isEmpty()) {
+    return true;
+  }
+  QString name = arguments.takeFirst();
+  if (name.compare("loadLibrary") == 0) {
+    return loadLibrary(arguments);
+  } else if (name.compare("loadFile") == 0) {
+    return loadFile(arguments);
+  } else if (name.compare("checkModel") == 0) {
+    return checkModel(arguments, false);
+  } else if (name.compare("checkAllModels") == 0) {
+    return checkModel(arguments, true);
+  } else if (name.compare("exportDiagram") == 0) {
+    return exportImage(arguments, StringHandler::Diagram);
+  } else if (name.compare("exportIcon") == 0) {
+    return exportImage(arguments, StringHandler::Icon);
+  } else if (name.compare("simulate") == 0) {
+    // everything after the class name is passed to simulate as it is.
+    QString simulationOptions = command.trimmed().mid(name.length()).trimmed();
+    simulationOptions = simulationOptions.mid(arguments.isEmpty() ? 0 : arguments.first().length()).trimmed();
+    return simulate(arguments, simulationOptions);
+  }
+  fprintf(stderr, "Unknown command %s\n", name.toLocal8Bit().constData());
+  return false;
+}
+
+/*!
+ * \brief BatchMode::loadLibrary
+ * Loads a library from the MODELICAPATH and adds it and its dependencies to the libraries browser.
+ * \param arguments - the library name and optionally its version.
+ * \return true on success.
+ */
+bool BatchMode::loadLibrary(const QStringList &arguments)
+{
+  if (arguments.isEmpty()) {
+    fprintf(stderr, "Usage: loadLibrary name [version]\n");
+    return false;
+  }
+  QString version = arguments.size() > 1 ? arguments.at(1) : QString("default");
+  OMCProxy *pOMCProxy = mpMainWindow->getOMCProxy();
+  if (!pOMCProxy->loadModel(arguments.at(0), version)) {
+    return false;
+  }
+  mpMainWindow->getLibraryWidget()->getLibraryTreeModel()->loadDependentLibraries(pOMCProxy->getClassNames());
+  return true;
+}
+
+/*!
+ * \brief BatchMode::loadFile
+ * Opens a Modelica or a text file. Used for the files given on the command line.\n
+ * The reasons for not loading the file are printed by LibraryWidget::showLoadError instead of being asked in a message box.
+ * \param fileName
+ * \return true on success.
+ */
+bool BatchMode::loadFile(const QString &fileName)
+{
+  QFileInfo fileInfo(fileName);
+  if (!fileInfo.exists()) {
+    printError(GUIMessages::getMessage(GUIMessages::FILE_NOT_FOUND).arg(fileName));
+    return false;
+  }
+  return mpMainWindow->getLibraryWidget()->openFile(fileInfo.absoluteFilePath(), Helper::utf8, false, false);
+}
+
+/*!
+ * \brief BatchMode::loadFile
+ * Opens a Modelica or a text file.
+ * \param arguments - the file name.
+ * \return true on success.
+ */
+bool BatchMode::loadFile(const QStringList &arguments)
+{
+  if (arguments.isEmpty()) {
+    fprintf(stderr, "Usage: loadFile fileName\n");
+    return false;
+  }
+  return loadFile(arguments.at(0));
+}
+
+/*!
+ * \brief BatchMode::checkModel
+ * Checks a model or all models inside a package and prints the result.
+ * \param arguments - the class name.
+ * \param recursive - if true checks all models inside the class.
+ * \return true if OMC reports no error.
+ */
+bool BatchMode::checkModel(const QStringList &arguments, bool recursive)
+{
+  if (arguments.isEmpty()) {
+    fprintf(stderr, "Usage: %s className\n", recursive ? "checkAllModels" : "checkModel");
+    return false;
+  }
+  if (!findModel(arguments.at(0))) {
+    return false;
+  }
+  OMCProxy *pOMCProxy = mpMainWindow->getOMCProxy();
+  QString result = recursive ? pOMCProxy->checkAllModelsRecursive(arguments.at(0)) : pOMCProxy->checkModel(arguments.at(0));
+  printf("%s\n", result.toLocal8Bit().constData());
+  return !result.isEmpty();
+}
+
+/*!
+ * \brief BatchMode::exportImage
+ * Renders the icon or diagram of a model to a svg or png file.
+ * \param arguments - the class name and the file name.
+ * \param viewType
+ * \return true on success.
+ */
+bool BatchMode::exportImage(const QStringList &arguments, StringHandler::ViewType viewType)
+{
+  if (arguments.size() < 2) {
+    fprintf(stderr, "Usage: %s className fileName\n", viewType == StringHandler::Icon ? "exportIcon" : "exportDiagram");
+    return false;
+  }
+  LibraryTreeItem *pLibraryTreeItem = findModel(arguments.at(0));
+  if (!pLibraryTreeItem) {
+    return false;
+  }
+  mpMainWindow->getLibraryWidget()->getLibraryTreeModel()->showModelWidget(pLibraryTreeItem);
+  ModelWidget *pModelWidget = pLibraryTreeItem->getModelWidget();
+  if (!pModelWidget) {
+    return false;
+  }
+  GraphicsView *pGraphicsView;
+  if (viewType == StringHandler::Icon) {
+    pGraphicsView = pModelWidget->getIconGraphicsView();
+  } else {
+    pGraphicsView = pModelWidget->getDiagramGraphicsView();
+  }
+  if (!pGraphicsView) {
+    fprintf(stderr, "%s has no %s view\n", arguments.at(0).toLocal8Bit().constData(),
+            viewType == StringHandler::Icon ? "icon" : "diagram");
+    return false;
+  }
+  QString fileName = QFileInfo(arguments.at(1)).absoluteFilePath();
+  if (!mpMainWindow->exportGraphicsViewToImage(pGraphicsView, fileName)) {
+    printError(GUIMessages::getMessage(GUIMessages::UNABLE_TO_SAVE_FILE).arg(fileName));
+    return false;
+  }
+  return true;
+}
+
+/*!
+ * \brief BatchMode::simulate
+ * Simulates the model and prints the simulation messages.
+ * \param arguments - the class name.
+ * \param simulationOptions - the options passed to simulate. Uses outputFormat="mat" if empty.
+ * \return true if a result file is generated.
+ */
+bool BatchMode::simulate(const QStringList &arguments, const QString &simulationOptions)
+{
+  if (arguments.isEmpty()) {
+    fprintf(stderr, "Usage: simulate className [simulation options]\n");
+    return false;
+  }
+  if (!findModel(arguments.at(0))) {
+    return false;
+  }
+  OMCProxy *pOMCProxy = mpMainWindow->getOMCProxy();
+  bool result = pOMCProxy->simulate(arguments.at(0), simulationOptions.isEmpty() ? "outputFormat=\"mat\"" : simulationOptions);
+  pOMCProxy->sendCommand("OMEdit_simulate_result.messages");
+  printf("%s\n", StringHandler::unparse(pOMCProxy->getResult()).toLocal8Bit().constData());
+  return result;
+}
+
+/*!
+ * \brief BatchMode::findModel
+ * Finds the class in the libraries browser.
+ * \param className
+ * \return the LibraryTreeItem or 0 if the class is not loaded.
+ */
+LibraryTreeItem* BatchMode::findModel(const QString &className)
+{
+  LibraryTreeItem *pLibraryTreeItem = mpMainWindow->getLibraryWidget()->getLibraryTreeModel()->findLibraryTreeItem(className);
+  if (!pLibraryTreeItem) {
+    printError(GUIMessages::getMessage(GUIMessages::CLASS_NOT_FOUND).arg(className));
+  }
+  return pLibraryTreeItem;
+}
@@ -0,0 +1,67 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES RECIPIENT'S ACCEPTANCE
+ * OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3, ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+
+#ifndef BATCHMODE_H
+#define BATCHMODE_H
+
+#include "MainWindow.h"
+
+/*!
+ * \class BatchMode
+ * \brief Runs OMEdit commands without showing any window.
+ * Each command is a line of the form "command arguments". The supported commands are,\n
+ * loadLibrary name [version]\n
+ * loadFile fileName\n
+ * checkModel className\n
+ * checkAllModels className\n
+ * exportDiagram className fileName\n
+ * exportIcon className fileName\n
+ * simulate className [simulation options]
+ */
+class BatchMode
+{
+public:
+  BatchMode(MainWindow *pMainWindow);
+  static void printError(const QString &message);
+  static bool readScript(const QString &fileName, QStringList *pCommands);
+  int run(const QStringList &commands);
+  bool loadFile(const QString &fileName);
+private:
+  MainWindow *mpMainWindow;
+  bool runCommand(const QString &command);
+  bool loadLibrary(const QStringList &arguments);
+  bool loadFile(const QStringList &arguments);
+  bool checkModel(const QStringList &arguments, bool recursive);
+  bool exportImage(const QStringList &arguments, StringHandler::ViewType viewType);
+  bool simulate(const QStringList &arguments, const QString &simulationOptions);
+  LibraryTreeItem* findModel(const QString &className);
+};
+
+#endif // BATCHMODE_H
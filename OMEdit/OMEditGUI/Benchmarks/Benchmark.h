@@ -0,0 +1,85 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES RECIPIENT'S ACCEPTANCE
+ * OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3, ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <stdio.h>
+#include <locale.h>
+#include <QApplication>
+#include <QElapsedTimer>
+
+#include "Helper.h"
+
+/*!
+ * \namespace Benchmark
+ * \brief Helpers shared by the OMEdit benchmarks.
+ */
+namespace Benchmark {
+
+/*!
+ * \brief initialize
+ * Selects the offscreen platform unless the user has chosen one so the benchmarks run without a display.\n
+ * Must be called before the QApplication is created.
+ */
+inline void initialize()
+{
+  if (qgetenv("QT_QPA_PLATFORM").isEmpty()) {
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+  }
+}
+
+/*!
+ * \brief initializeHelper
+ * Initializes the Helper variables. Must be called after the QApplication is created.
+ */
+inline void initializeHelper()
+{
+  Helper::initHelperVariables();
+  /* Force C-style doubles */
+  setlocale(LC_NUMERIC, "C");
+}
+
+/*!
+ * \brief report
+ * Prints the time of a benchmark step.
+ * \param name - the name of the step.
+ * \param nanoseconds - the time of the step.
+ * \param count - the number of items processed in the step.
+ */
+inline void report(const QString &name, qint64 nanoseconds, int count)
+{
+  printf("%-50s %10.2f ms %10.3f us/item\n", name.toLocal8Bit().constData(), nanoseconds / 1e6, count > 0 ? nanoseconds / 1e3 / count : 0.0);
+  fflush(stdout);
+}
+
+} // namespace Benchmark
+
+#endif // BENCHMARK_H
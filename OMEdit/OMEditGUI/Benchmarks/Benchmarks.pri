@@ -0,0 +1,65 @@
+#
+ # This file is part of OpenModelica.
+ #
+ # Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ # c/o Linköpings universitet, Department of Computer and Information Science,
+ # SE-58183 Linköping, Sweden.
+ #
+ # All rights reserved.
+ #
+ # THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ # THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ # ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES RECIPIENT'S ACCEPTANCE
+ # OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3, ACCORDING TO RECIPIENTS CHOICE.
+ #
+ # The OpenModelica software and the Open Source Modelica
+ # Consortium (OSMC) Public License (OSMC-PL) are obtained
+ # from OSMC, either from the above address,
+ # from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ # http://www.openmodelica.org, and in the OpenModelica distribution.
+ # GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ #
+ # This program is distributed WITHOUT ANY WARRANTY; without
+ # even the implied warranty of  MERCHANTABILITY or FITNESS
+ # FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ # IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ #
+ # See the full OSMC Public License conditions for more details.
+ #
+ #/
+
+# Settings shared by the benchmarks that need the OMEdit classes.
+# The benchmark is linked with all the OMEdit sources except main.cpp.
+# Include this file first in the benchmark .pro file and then set TARGET and add the benchmark sources.
+
+lessThan(QT_MAJOR_VERSION, 5) {
+  error("The OMEdit benchmarks need Qt 5.")
+}
+
+OMEDITGUI_DIR = $$clean_path($$PWD/..)
+# the paths in OMEditGUI.pro are relative to OMEditGUI.
+VPATH += $$OMEDITGUI_DIR
+include($$OMEDITGUI_DIR/OMEditGUI.pro)
+SOURCES -= main.cpp
+
+OMEDITGUI_INCLUDEPATH = $$INCLUDEPATH
+INCLUDEPATH = $$PWD
+for(path, OMEDITGUI_INCLUDEPATH) {
+  isRelativePath($$path) {
+    INCLUDEPATH += $$clean_path($$OMEDITGUI_DIR/$$path)
+  } else {
+    INCLUDEPATH += $$path
+  }
+}
+LIBS += -L$$OMEDITGUI_DIR/Debugger/Parser
+
+HEADERS += $$PWD/Benchmark.h
+TRANSLATIONS =
+RESOURCES = $$OMEDITGUI_DIR/resource_omedit.qrc
+CONFIG += console
+CONFIG -= app_bundle
+
+DESTDIR = $$OUT_PWD
+UI_DIR = $$OUT_PWD/generatedfiles/ui
+MOC_DIR = $$OUT_PWD/generatedfiles/moc
+RCC_DIR = $$OUT_PWD/generatedfiles/rcc
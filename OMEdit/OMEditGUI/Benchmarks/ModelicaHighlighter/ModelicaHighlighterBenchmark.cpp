@@ -0,0 +1,148 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES RECIPIENT'S ACCEPTANCE
+ * OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3, ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+
+/*
+ * Highlights a large generated Modelica text with ModelicaTextHighlighter.
+ * Usage: ModelicaHighlighterBenchmark [number of models]. The default is 2000 models i.e., about 70000 lines.
+ * The text is generated so the benchmark doesn't depend on the Modelica Standard Library.
+ * OMEdit is started in batch mode since ModelicaTextHighlighter reads its settings from the OptionsDialog.
+ */
+
+#include "Benchmark.h"
+#include "MainWindow.h"
+#include "ModelicaEditor.h"
+#include "meta/meta_modelica.h"
+
+/*!
+ * \brief generateModelicaText
+ * Generates a package of models with the constructs that ModelicaTextHighlighter handles,
+ * i.e., keywords, types, functions, numbers, quoted strings with escapes, single and multi line comments and annotations.
+ * \param models - the number of models.
+ * \return
+ */
+static QString generateModelicaText(int models)
+{
+  QString modelicaText;
+  QTextStream textStream(&modelicaText);
+  textStream << "package GeneratedPackage \"Generated package for the highlighter benchmark\"\n";
+  for (int i = 0 ; i < models ; i++) {
+    textStream << "  /* Model " << i << " is a damped oscillator.\n"
+               << "   * The comment spans several lines so the state of the next block depends on this one.\n"
+               << "   */\n"
+               << "  model Model" << i << " \"Oscillator number " << i << " with a \\\"quoted\\\" description\"\n"
+               << "    import SI = Modelica.SIunits;\n"
+               << "    parameter Real m(unit = \"kg\") = " << 1.5 + i << " \"Mass\";\n"
+               << "    parameter Real c = 1e-3 \"Damping\";\n"
+               << "    parameter Real k = " << i % 10 + 1 << ".25e2 \"Stiffness\";\n"
+               << "    parameter Integer n(min = 1) = " << i % 5 + 1 << ";\n"
+               << "    Real x(start = 1, fixed = true);\n"
+               << "    Real v(start = 0, fixed = true);\n"
+               << "    Real y[n];\n"
+               << "    Boolean isPositive;\n"
+               << "  protected\n"
+               << "    constant String name = \"Model" << i << " /* not a comment */ // still a string\";\n"
+               << "  equation\n"
+               << "    der(x) = v; // the velocity\n"
+               << "    m * der(v) + c * v + k * x = sin(2 * Modelica.Constants.pi * time);\n"
+               << "    isPositive = x > 0 and not (v < 0) or time >= 10;\n"
+               << "    for j in 1:n loop\n"
+               << "      y[j] = if j == 1 then x else abs(y[j - 1]) * exp(-0.5 * j);\n"
+               << "    end for;\n"
+               << "    when sample(0, 0.1) then\n"
+               << "      assert(x < 1e3, \"x is too large\", level = AssertionLevel.warning);\n"
+               << "    end when;\n"
+               << "    annotation (Icon(coordinateSystem(preserveAspectRatio = false, extent = {{-100, -100}, {100, 100}}),\n"
+               << "      graphics = {Rectangle(extent = {{-100, 100}, {100, -100}}, lineColor = {0, 0, 127}, fillColor = {255, 255, 255},\n"
+               << "        fillPattern = FillPattern.Solid), Text(extent = {{-150, 150}, {150, 110}}, textString = \"%name\")}),\n"
+               << "      Documentation(info = \"<html>\n"
+               << "<p>Generated model " << i << " with a multi line documentation string.</p>\n"
+               << "</html>\"),\n"
+               << "      experiment(StopTime = 10, Interval = 0.002));\n"
+               << "  end Model" << i << ";\n\n";
+  }
+  textStream << "end GeneratedPackage;\n";
+  textStream.flush();
+  return modelicaText;
+}
+
+int main(int argc, char *argv[])
+{
+  MMC_INIT();
+  Benchmark::initialize();
+  QApplication application(argc, argv);
+  Benchmark::initializeHelper();
+  int models = application.arguments().size() > 1 ? application.arguments().at(1).toInt() : 2000;
+  if (models <= 0) {
+    fprintf(stderr, "Usage: ModelicaHighlighterBenchmark [number of models]\n");
+    return 1;
+  }
+  MainWindow mainWindow(0, false, true);
+  if (mainWindow.getExitApplicationStatus()) {
+    fprintf(stderr, "Unable to start OMEdit.\n");
+    return 1;
+  }
+  QString modelicaText = generateModelicaText(models);
+  // the document is set up like BaseEditor::PlainTextEdit does.
+  QPlainTextEdit plainTextEdit;
+  QTextDocument *pTextDocument = plainTextEdit.document();
+  pTextDocument->setDocumentLayout(new BaseEditorDocumentLayout(pTextDocument));
+  ModelicaTextHighlighter modelicaTextHighlighter(mainWindow.getOptionsDialog()->getModelicaEditorPage(), &plainTextEdit);
+  QElapsedTimer timer;
+  // set the text. QSyntaxHighlighter highlights the whole document.
+  timer.start();
+  plainTextEdit.setPlainText(modelicaText);
+  int blocks = pTextDocument->blockCount();
+  Benchmark::report(QString("set the text of %1 lines").arg(blocks), timer.nsecsElapsed(), blocks);
+  // rehighlight e.g., when the settings are changed.
+  timer.restart();
+  modelicaTextHighlighter.rehighlight();
+  Benchmark::report("rehighlight", timer.nsecsElapsed(), blocks);
+  // open a multi line comment at the top and close it again. Each edit changes the state of all the following blocks.
+  QTextCursor cursor(pTextDocument->findBlockByNumber(1));
+  timer.restart();
+  cursor.insertText("/*");
+  cursor.movePosition(QTextCursor::PreviousCharacter, QTextCursor::KeepAnchor, 2);
+  cursor.removeSelectedText();
+  Benchmark::report("open and close a comment at the top", timer.nsecsElapsed(), 2 * blocks);
+  // typing in the middle only highlights the edited block.
+  const int keystrokes = 1000;
+  cursor = QTextCursor(pTextDocument->findBlockByNumber(blocks / 2));
+  cursor.movePosition(QTextCursor::EndOfBlock);
+  timer.restart();
+  for (int i = 0 ; i < keystrokes ; i++) {
+    cursor.insertText(i % 2 == 0 ? "x" : " ");
+  }
+  Benchmark::report(QString("type %1 characters").arg(keystrokes), timer.nsecsElapsed(), keystrokes);
+  if (pTextDocument->toPlainText().length() != modelicaText.length() + keystrokes) {
+    fprintf(stderr, "The text was not edited as expected.\n");
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,183 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES RECIPIENT'S ACCEPTANCE
+ * OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3, ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+
+/*
+ * Compares OMCValueTree with the StringHandler::getStrings based parsing on OMC annotation values.
+ * Usage: OMCValueTreeBenchmark [file] [repetitions].
+ * The file has one value per line e.g., the arguments of the shapes returned by getIconAnnotation for the MSL classes.
+ * Without a file the shapes of some MSL icons and some getComponents entries are used. The default is 20000 repetitions.
+ */
+
+#include "Benchmark.h"
+#include "StringHandler.h"
+
+#include <QFile>
+#include <QTextStream>
+
+/* The arguments of the shapes of Modelica.Electrical.Analog.Basic.Resistor, Capacitor and Ground as returned by getIconAnnotation
+ * and some entries of getComponents(Modelica.Electrical.Analog.Basic.Resistor).
+ */
+static const char *mslValues[] = {
+  "true, {0.0, 0.0}, 0, {0, 0, 255}, {255, 255, 255}, {0, 0, 0}, LinePattern.Solid, FillPattern.Solid, 0.25, BorderPattern.None, "
+  "{{-70.0, 30.0}, {70.0, -30.0}}, 0.0",
+  "true, {0.0, 0.0}, 0, {{-90.0, 0.0}, {-70.0, 0.0}}, {0, 0, 255}, LinePattern.Solid, 0.25, {Arrow.None, Arrow.None}, 3.0, Smooth.None",
+  "true, {0.0, 0.0}, 0, {{70.0, 0.0}, {90.0, 0.0}}, {0, 0, 255}, LinePattern.Solid, 0.25, {Arrow.None, Arrow.None}, 3.0, Smooth.None",
+  "true, {0.0, 0.0}, 0, {{0.0, -100.0}, {0.0, -30.0}}, {127, 0, 0}, LinePattern.Dot, 0.25, {Arrow.None, Arrow.None}, 3.0, Smooth.None",
+  "true, {0.0, 0.0}, 0, {0, 0, 255}, {0, 0, 0}, LinePattern.Solid, FillPattern.None, 0.25, {{-150.0, 90.0}, {150.0, 50.0}}, \"%name\", "
+  "0.0, {-1, -1, -1}, \"\", {}, TextAlignment.Center",
+  "true, {0.0, 0.0}, 0, {0, 0, 0}, {0, 0, 0}, LinePattern.Solid, FillPattern.None, 0.25, {{-150.0, -40.0}, {150.0, -80.0}}, \"R=%R\", "
+  "0.0, {-1, -1, -1}, \"\", {}, TextAlignment.Center",
+  "true, {0.0, 0.0}, 0, {{-6.0, 28.0}, {-6.0, -28.0}}, {0, 0, 255}, LinePattern.Solid, 0.25, {Arrow.None, Arrow.None}, 3.0, Smooth.None",
+  "true, {0.0, 0.0}, 0, {{-90.0, 0.0}, {-6.0, 0.0}, {-6.0, 0.0}, {-6.0, 0.0}}, {0, 0, 255}, LinePattern.Solid, 0.25, "
+  "{Arrow.None, Arrow.None}, 3.0, Smooth.None",
+  "true, {0.0, 0.0}, 0, {{-60.0, 50.0}, {60.0, 50.0}}, {0, 0, 255}, LinePattern.Solid, 0.25, {Arrow.None, Arrow.None}, 3.0, Smooth.None",
+  "true, {0.0, 0.0}, 0, {{-40.0, 30.0}, {40.0, 30.0}}, {0, 0, 255}, LinePattern.Solid, 0.25, {Arrow.None, Arrow.None}, 3.0, Smooth.None",
+  "Modelica.SIunits.Resistance, R, \"Resistance at temperature T_ref\", \"public\", false, false, false, false, \"parameter\", \"none\", "
+  "\"unspecified\", {}",
+  "Modelica.SIunits.Temperature, T_ref, \"Reference temperature\", \"public\", false, false, false, false, \"parameter\", \"none\", "
+  "\"unspecified\", {}",
+  "Modelica.SIunits.LinearTemperatureCoefficient, alpha, \"Temperature coefficient of resistance (R_actual = R*(1 + alpha*(T_heatPort - "
+  "T_ref))\", \"public\", false, false, false, false, \"parameter\", \"none\", \"unspecified\", {}",
+  "Modelica.Electrical.Analog.Interfaces.PositivePin, p, \"Positive pin (potential p.v > n.v for positive voltage drop v)\", \"public\", "
+  "false, false, false, false, \"\", \"none\", \"unspecified\", {}",
+  0
+};
+
+/*!
+ * \brief walkStrings
+ * Reads all the values like the annotation parsing did before OMCValueTree.
+ * \param value
+ * \param pChecksum - the sum of the numbers and the lengths of the other values.
+ * \return the number of leaf values.
+ */
+static int walkStrings(const QString &value, qreal *pChecksum)
+{
+  int count = 0;
+  foreach (QString element, StringHandler::getStrings(value)) {
+    if (element.startsWith("{")) {
+      count += walkStrings(StringHandler::removeFirstLastCurlBrackets(element), pChecksum);
+    } else {
+      bool ok;
+      qreal number = element.toDouble(&ok);
+      *pChecksum += ok ? number : StringHandler::unparse(element).length();
+      count++;
+    }
+  }
+  return count;
+}
+
+/*!
+ * \brief walkNodes
+ * Reads all the values of the OMCValueTree node.
+ * \param node
+ * \param pChecksum - the sum of the numbers and the lengths of the other values.
+ * \return the number of leaf values.
+ */
+static int walkNodes(const OMCValueTree::Node &node, qreal *pChecksum)
+{
+  int count = 0;
+  for (int i = 0 ; i < node.size() ; i++) {
+    OMCValueTree::Node child = node.at(i);
+    if (child.isArray()) {
+      count += walkNodes(child, pChecksum);
+    } else {
+      bool ok;
+      qreal number = child.toStringRef().toString().toDouble(&ok);
+      *pChecksum += ok ? number : child.unparse().length();
+      count++;
+    }
+  }
+  return count;
+}
+
+int main(int argc, char *argv[])
+{
+  Benchmark::initialize();
+  QApplication application(argc, argv);
+  Benchmark::initializeHelper();
+  QStringList values;
+  int repetitions = 20000;
+  QStringList arguments = application.arguments();
+  if (arguments.size() > 1) {
+    QFile file(arguments.at(1));
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+      fprintf(stderr, "Unable to open %s: %s\n", arguments.at(1).toLocal8Bit().constData(), file.errorString().toLocal8Bit().constData());
+      return 1;
+    }
+    QTextStream textStream(&file);
+    while (!textStream.atEnd()) {
+      QString line = textStream.readLine().trimmed();
+      if (!line.isEmpty()) {
+        values.append(line);
+      }
+    }
+    if (arguments.size() > 2) {
+      repetitions = arguments.at(2).toInt();
+    }
+  } else {
+    for (const char **ppValue = mslValues ; *ppValue ; ppValue++) {
+      values.append(QString::fromLatin1(*ppValue));
+    }
+  }
+  if (values.isEmpty() || repetitions <= 0) {
+    fprintf(stderr, "Usage: OMCValueTreeBenchmark [file] [repetitions]\n");
+    return 1;
+  }
+  QElapsedTimer timer;
+  int count = repetitions * values.size();
+  // StringHandler::getStrings
+  qreal stringsChecksum = 0;
+  int stringsLeaves = 0;
+  timer.start();
+  for (int i = 0 ; i < repetitions ; i++) {
+    foreach (const QString &value, values) {
+      stringsLeaves += walkStrings(value, &stringsChecksum);
+    }
+  }
+  Benchmark::report(QString("StringHandler::getStrings %1 values").arg(count), timer.nsecsElapsed(), count);
+  // OMCValueTree
+  qreal treeChecksum = 0;
+  int treeLeaves = 0;
+  timer.restart();
+  for (int i = 0 ; i < repetitions ; i++) {
+    foreach (const QString &value, values) {
+      OMCValueTree valueTree(value);
+      treeLeaves += walkNodes(valueTree.root(), &treeChecksum);
+    }
+  }
+  Benchmark::report(QString("OMCValueTree %1 values").arg(count), timer.nsecsElapsed(), count);
+  // both must read the same values.
+  if (stringsLeaves != treeLeaves || !qFuzzyCompare(1 + stringsChecksum, 1 + treeChecksum)) {
+    fprintf(stderr, "The results differ: %d values with checksum %g and %d values with checksum %g.\n",
+            stringsLeaves, stringsChecksum, treeLeaves, treeChecksum);
+    return 1;
+  }
+  return 0;
+}
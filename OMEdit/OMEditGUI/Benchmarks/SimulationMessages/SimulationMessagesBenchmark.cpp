@@ -0,0 +1,130 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES RECIPIENT'S ACCEPTANCE
+ * OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3, ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+
+/*
+ * Populates and scrolls a SimulationOutputTree with many simulation messages.
+ * Usage: SimulationMessagesBenchmark [number of messages]. The default is 100000 messages.
+ * Every tenth top level message has three nested messages like the LOG_STATS and LOG_NLS output.
+ */
+
+#include "Benchmark.h"
+#include "SimulationOutputHandler.h"
+
+#include <QScrollBar>
+
+/*!
+ * \brief createSimulationMessage
+ * Creates a message like SimulationOutputHandler::startElement does.
+ * \param pParentSimulationMessage
+ * \param number - the number of the message.
+ * \param level
+ * \return
+ */
+static SimulationMessage* createSimulationMessage(SimulationMessage *pParentSimulationMessage, int number, int level)
+{
+  static const char *streams[] = {"LOG_STATS", "LOG_NLS", "stdout", "assert"};
+  SimulationMessage *pSimulationMessage = new SimulationMessage(pParentSimulationMessage);
+  pSimulationMessage->mStream = streams[number % 4];
+  pSimulationMessage->mType = (number % 50 == 0) ? StringHandler::SMWarning : StringHandler::Info;
+  pSimulationMessage->mText = Qt::convertFromPlainText(QString("Message %1 at time %2: the nonlinear system converged after %3 iterations.")
+                                                       .arg(number).arg(number * 0.001).arg(number % 7 + 1));
+  pSimulationMessage->mLevel = level;
+  if (number % 100 == 0) {
+    pSimulationMessage->mIndex = QString::number(number);
+  }
+  return pSimulationMessage;
+}
+
+int main(int argc, char *argv[])
+{
+  Benchmark::initialize();
+  QApplication application(argc, argv);
+  Benchmark::initializeHelper();
+  int count = application.arguments().size() > 1 ? application.arguments().at(1).toInt() : 100000;
+  if (count <= 0) {
+    fprintf(stderr, "Usage: SimulationMessagesBenchmark [number of messages]\n");
+    return 1;
+  }
+  // the view is attached before the messages are inserted like SimulationOutputWidget does.
+  SimulationMessageModel simulationMessageModel(0);
+  SimulationOutputTree simulationOutputTree(0);
+  simulationOutputTree.setModel(&simulationMessageModel);
+  simulationOutputTree.resize(800, 600);
+  simulationOutputTree.show();
+  QElapsedTimer timer;
+  // populate
+  timer.start();
+  int messages = 0;
+  for (int i = 0 ; messages < count ; i++) {
+    SimulationMessage *pSimulationMessage = createSimulationMessage(simulationMessageModel.getRootSimulationMessage(), messages++, 0);
+    if (i % 10 == 0) {
+      for (int j = 0 ; j < 3 && messages < count ; j++) {
+        pSimulationMessage->appendChild(createSimulationMessage(pSimulationMessage, messages++, 1));
+      }
+    }
+    simulationMessageModel.insertSimulationMessage(pSimulationMessage);
+  }
+  QApplication::processEvents();
+  Benchmark::report(QString("populate %1 messages").arg(count), timer.nsecsElapsed(), count);
+  // the lookups the view does while painting and expanding.
+  timer.restart();
+  int rows = simulationMessageModel.rowCount(QModelIndex());
+  for (int row = 0 ; row < rows ; row++) {
+    QModelIndex index = simulationMessageModel.index(row, 0, QModelIndex());
+    if (simulationMessageModel.parent(index).isValid()) {
+      fprintf(stderr, "Wrong parent of the top level message %d.\n", row);
+      return 1;
+    }
+    for (int childRow = 0 ; childRow < simulationMessageModel.rowCount(index) ; childRow++) {
+      QModelIndex childIndex = simulationMessageModel.index(childRow, 0, index);
+      if (simulationMessageModel.parent(childIndex) != index) {
+        fprintf(stderr, "Wrong parent of the message %d of the top level message %d.\n", childRow, row);
+        return 1;
+      }
+    }
+  }
+  Benchmark::report("index and parent of every message", timer.nsecsElapsed(), count);
+  // expand
+  timer.restart();
+  simulationOutputTree.expandAll();
+  QApplication::processEvents();
+  Benchmark::report("expand all", timer.nsecsElapsed(), count);
+  // scroll from top to bottom and back. The texts of the messages not shown recently are read back from the spill file.
+  QScrollBar *pScrollBar = simulationOutputTree.verticalScrollBar();
+  const int steps = 500;
+  timer.restart();
+  for (int step = 0 ; step <= 2 * steps ; step++) {
+    int position = step <= steps ? step : 2 * steps - step;
+    pScrollBar->setValue((qint64)pScrollBar->maximum() * position / steps);
+    simulationOutputTree.viewport()->repaint();
+  }
+  Benchmark::report(QString("scroll down and up in %1 steps").arg(2 * steps), timer.nsecsElapsed(), 2 * steps);
+  return 0;
+}
@@ -138,52 +138,62 @@ void ComponentInfo::parseComponentInfoString(QString value)
   if (value.isEmpty()) {
     return;
   }
-  QStringList list = StringHandler::unparseStrings(value);
+  OMCValueTree valueTree(value);
+  parseComponentInfoString(valueTree.at(0));
+}
+
+/*!
+ * \brief ComponentInfo::parseComponentInfoString
+ * Parses the already tokenized component info array.
+ * \param list
+ */
+void ComponentInfo::parseComponentInfoString(const OMCValueTree::Node &list)
+{
   // read the class name
   if (list.size() > 0) {
-    mClassName = list.at(0);
+    mClassName = list.at(0).unparse();
   } else {
     return;
   }
   // read the name
   if (list.size() > 1) {
-    mName = list.at(1);
+    mName = list.at(1).unparse();
   } else {
     return;
   }
   // read the class comment
   if (list.size() > 2) {
-    mComment = list.at(2);
+    mComment = list.at(2).unparse();
   } else {
     return;
   }
   // read the class access
   if (list.size() > 3) {
-    mIsProtected = StringHandler::removeFirstLastQuotes(list.at(3)).contains("protected");
+    mIsProtected = StringHandler::removeFirstLastQuotes(list.at(3).unparse()).contains("protected");
   } else {
     return;
   }
   // read the final attribute
   if (list.size() > 4) {
-    mIsFinal = list.at(4).contains("true");
+    mIsFinal = list.at(4).unparse().contains("true");
   } else {
     return;
   }
   // read the flow attribute
   if (list.size() > 5) {
-    mIsFlow = list.at(5).contains("true");
+    mIsFlow = list.at(5).unparse().contains("true");
   } else {
     return;
   }
   // read the stream attribute
   if (list.size() > 6) {
-    mIsStream = list.at(6).contains("true");
+    mIsStream = list.at(6).unparse().contains("true");
   } else {
     return;
   }
   // read the replaceable attribute
   if (list.size() > 7) {
-    mIsReplaceable = list.at(7).contains("true");
+    mIsReplaceable = list.at(7).unparse().contains("true");
   } else {
     return;
   }
@@ -191,7 +201,7 @@ void ComponentInfo::parseComponentInfoString(QString value)
   if (list.size() > 8) {
     QMap<QString, QString>::iterator variability_it;
     for (variability_it = mVariabilityMap.begin(); variability_it != mVariabilityMap.end(); ++variability_it) {
-      if (variability_it.key().compare(StringHandler::removeFirstLastQuotes(list.at(8))) == 0) {
+      if (variability_it.key().compare(StringHandler::removeFirstLastQuotes(list.at(8).unparse())) == 0) {
         mVariability = variability_it.value();
         break;
       }
@@ -199,8 +209,8 @@ void ComponentInfo::parseComponentInfoString(QString value)
   }
   // read the inner attribute
   if (list.size() > 9) {
-    mIsInner = list.at(9).contains("inner");
-    mIsOuter = list.at(9).contains("outer");
+    mIsInner = list.at(9).unparse().contains("inner");
+    mIsOuter = list.at(9).unparse().contains("outer");
   } else {
     return;
   }
@@ -208,7 +218,7 @@ void ComponentInfo::parseComponentInfoString(QString value)
   if (list.size() > 10) {
     QMap<QString, QString>::iterator casuality_it;
     for (casuality_it = mCasualityMap.begin(); casuality_it != mCasualityMap.end(); ++casuality_it) {
-      if (casuality_it.key().compare(StringHandler::removeFirstLastQuotes(list.at(10))) == 0) {
+      if (casuality_it.key().compare(StringHandler::removeFirstLastQuotes(list.at(10).unparse())) == 0) {
         mCasuality = casuality_it.value();
         break;
       }
@@ -216,7 +226,7 @@ void ComponentInfo::parseComponentInfoString(QString value)
   }
   // read the array index value
   if (list.size() > 11) {
-    setArrayIndex(list.at(11));
+    setArrayIndex(list.at(11).isArray() ? list.at(11).toString() : list.at(11).unparse());
   }
 }
 
@@ -1194,19 +1204,18 @@ void Component::createClassShapes()
         pGraphicsView = mpLibraryTreeItem->getModelWidget()->getDiagramGraphicsView();
       }
     }
+    /* The instances reference the shapes of the class instead of copying them.
+     * Only the texts get their own copy since they substitute %name, %class and the parameter values of the instance
+     * and are drawn with respect to the orientation of the instance.
+     */
     foreach (ShapeAnnotation *pShapeAnnotation, pGraphicsView->getShapesList()) {
-      if (dynamic_cast<LineAnnotation*>(pShapeAnnotation)) {
-        mShapesList.append(new LineAnnotation(pShapeAnnotation, this));
-      } else if (dynamic_cast<PolygonAnnotation*>(pShapeAnnotation)) {
-        mShapesList.append(new PolygonAnnotation(pShapeAnnotation, this));
-      } else if (dynamic_cast<RectangleAnnotation*>(pShapeAnnotation)) {
-        mShapesList.append(new RectangleAnnotation(pShapeAnnotation, this));
-      } else if (dynamic_cast<EllipseAnnotation*>(pShapeAnnotation)) {
-        mShapesList.append(new EllipseAnnotation(pShapeAnnotation, this));
-      } else if (dynamic_cast<TextAnnotation*>(pShapeAnnotation)) {
-        mShapesList.append(new TextAnnotation(pShapeAnnotation, this));
-      } else if (dynamic_cast<BitmapAnnotation*>(pShapeAnnotation)) {
-        mShapesList.append(new BitmapAnnotation(pShapeAnnotation, this));
+      if (dynamic_cast<TextAnnotation*>(pShapeAnnotation)) {
+        TextAnnotation *pTextAnnotation = new TextAnnotation(pShapeAnnotation, this);
+        mShapesList.append(pTextAnnotation);
+        mShapeItemsList.append(pTextAnnotation);
+      } else {
+        mShapesList.append(pShapeAnnotation);
+        mShapeItemsList.append(new ReferenceShapeItem(pShapeAnnotation, this));
       }
     }
   }
@@ -1246,12 +1255,13 @@ void Component::removeChildren()
     delete pComponent;
   }
   mComponentsList.clear();
-  foreach (ShapeAnnotation *pShapeAnnotation, mShapesList) {
-    pShapeAnnotation->setParentItem(0);
-    mpGraphicsView->removeItem(pShapeAnnotation);
-    pShapeAnnotation = 0;
-    delete pShapeAnnotation;
+  foreach (QGraphicsItem *pShapeItem, mShapeItemsList) {
+    pShapeItem->setParentItem(0);
+    mpGraphicsView->removeItem(pShapeItem);
+    pShapeItem = 0;
+    delete pShapeItem;
   }
+  mShapeItemsList.clear();
   mShapesList.clear();
 }
 
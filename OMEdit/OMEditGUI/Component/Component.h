@@ -69,6 +69,7 @@ public:
   ComponentInfo(ComponentInfo *pComponentInfo, QObject *pParent = 0);
   void updateComponentInfo(const ComponentInfo *pComponentInfo);
   void parseComponentInfoString(QString value);
+  void parseComponentInfoString(const OMCValueTree::Node &list);
   void fetchModifiers(OMCProxy *pOMCProxy, QString className);
   void fetchParameterValue(OMCProxy *pOMCProxy, QString className);
   void setClassName(QString className) {mClassName = className;}
@@ -259,7 +260,10 @@ private:
   qreal mXFactor;
   qreal mYFactor;
   QList<Component*> mInheritedComponentsList;
+  /* the shapes drawn by the component i.e., the shapes of its class and its own texts. */
   QList<ShapeAnnotation*> mShapesList;
+  /* the child items of the component drawing mShapesList. */
+  QList<QGraphicsItem*> mShapeItemsList;
   QList<Component*> mComponentsList;
   QPointF mOldScenePosition;
   QList<TLMInterfacePointInfo*> mInterfacePointsList;
@@ -576,7 +576,7 @@ void GDBAdapter::stackListVariablesCB(GDBMIResultRecord *pGDBMIResultRecord)
           QString name, type, value;
           if (pGDBMIValue->type == GDBMIValue::TupleValue)
           {
-            GDBMIResultList resultsList = pGDBMIValue->miTuple->miResultsList;
+            const GDBMIResultList &resultsList = pGDBMIValue->miTuple->miResultsList;
             name = getGDBMIConstantValue(getGDBMIResult("name", resultsList));
             type = getGDBMIConstantValue(getGDBMIResult("type", resultsList));
             value = getGDBMIConstantValue(getGDBMIResult("value", resultsList));
@@ -755,7 +755,7 @@ void GDBAdapter::getMetaTypeElementCB(GDBMIResultRecord *pGDBMIResultRecord)
           GDBMIResult* pGDBMIResult = getGDBMIResult("omc_element", pGDBMIResponse->miResultRecord->miResultsList);
           if (pGDBMIResult->miValue->type == GDBMIValue::TupleValue)
           {
-            GDBMIResultList resultsList = pGDBMIResult->miValue->miTuple->miResultsList;
+            const GDBMIResultList &resultsList = pGDBMIResult->miValue->miTuple->miResultsList;
             name = getGDBMIConstantValue(getGDBMIResult("name", resultsList));
             displayName = getGDBMIConstantValue(getGDBMIResult("displayName", resultsList));
             type = getGDBMIConstantValue(getGDBMIResult("type", resultsList));
@@ -828,7 +828,7 @@ void GDBAdapter::insertBreakpointCB(GDBMIResultRecord *pGDBMIResultRecord)
   GDBMIResult *pBreakpointGDBMIResult = getGDBMIResult("bkpt", pGDBMIResultRecord->miResultsList);
   if (pBreakpointGDBMIResult) {
     if (pBreakpointGDBMIResult->miValue->type == GDBMIValue::TupleValue) {
-      GDBMIResultList resultsList = pBreakpointGDBMIResult->miValue->miTuple->miResultsList;
+      const GDBMIResultList &resultsList = pBreakpointGDBMIResult->miValue->miTuple->miResultsList;
       QString breakpointID = getGDBMIConstantValue(getGDBMIResult("number", resultsList));
       GDBMICommand cmd = mGDBMICommandsHash.value(pGDBMIResultRecord->token);
       if (BreakpointTreeItem *pBreakpointTreeItem = qobject_cast<BreakpointTreeItem*>(cmd.mpCallbackObject)) {
@@ -843,19 +843,11 @@ void GDBAdapter::insertBreakpointCB(GDBMIResultRecord *pGDBMIResultRecord)
   \param variable -  the name of GDBMIResult to find.
   \param resultsList - GDBMIResultList
   \return GDBMIResult
+  \sa GDBMIResultList::find()
   */
-GDBMIResult* GDBAdapter::getGDBMIResult(const char *variable, GDBMIResultList resultsList)
+GDBMIResult* GDBAdapter::getGDBMIResult(const char *variable, const GDBMIResultList &resultsList)
 {
-  GDBMIResultList::iterator it;
-  for (it = resultsList.begin(); it != resultsList.end(); ++it)
-  {
-    GDBMIResult *pGDBMIResult = *it;
-    if (pGDBMIResult->variable.compare(variable) == 0)
-    {
-      return pGDBMIResult;
-    }
-  }
-  return 0;
+  return resultsList.find(variable);
 }
 
 /*!
@@ -1070,15 +1062,9 @@ void GDBAdapter::processGDBMIResultRecord(GDBMIResultRecord *pGDBMIResultRecord)
     /* handle stopped response */
     if (pGDBMIResultRecord->cls.compare("stopped") == 0) {
       string reason = "";
-      GDBMIResultList::iterator it;
-      for (it = pGDBMIResultRecord->miResultsList.begin(); it != pGDBMIResultRecord->miResultsList.end(); ++it) {
-        GDBMIResult *pGDBMIResult = *it;
-        if (pGDBMIResult->variable.compare("reason") == 0) {
-          if (pGDBMIResult->miValue->type == GDBMIValue::ConstantValue) {
-            reason = pGDBMIResult->miValue->value;
-            break;
-          }
-        }
+      GDBMIResult *pGDBMIResult = getGDBMIResult("reason", pGDBMIResultRecord->miResultsList);
+      if (pGDBMIResult && pGDBMIResult->miValue->type == GDBMIValue::ConstantValue) {
+        reason = pGDBMIResult->miValue->value;
       }
       handleStoppedEvent(reason, pGDBMIResultRecord);
       mPendingConsoleStreamOutput.clear();
@@ -1186,7 +1172,7 @@ bool GDBAdapter::skipSteppedInFrames(GDBMIResultRecord *pGDBMIResultRecord)
 {
   GDBMIResult *pGDBMIResult = getGDBMIResult("frame", pGDBMIResultRecord->miResultsList);
   if (pGDBMIResult && pGDBMIResult->miValue->type == GDBMIValue::TupleValue) {
-    GDBMIResultList resultsList = pGDBMIResult->miValue->miTuple->miResultsList;
+    const GDBMIResultList &resultsList = pGDBMIResult->miValue->miTuple->miResultsList;
     QString file = getGDBMIConstantValue(getGDBMIResult("file", resultsList));
     QFileInfo fileInfo(file);
     if (!StringHandler::isModelicaFile(fileInfo.suffix())) {
@@ -1234,7 +1220,7 @@ void GDBAdapter::handleBreakpointHit(GDBMIResultRecord *pGDBMIResultRecord)
 {
   GDBMIResult *pGDBMIResult = getGDBMIResult("frame", pGDBMIResultRecord->miResultsList);
   if (pGDBMIResult && pGDBMIResult->miValue->type == GDBMIValue::TupleValue) {
-    GDBMIResultList resultsList = pGDBMIResult->miValue->miTuple->miResultsList;
+    const GDBMIResultList &resultsList = pGDBMIResult->miValue->miTuple->miResultsList;
     QString file = getGDBMIConstantValue(getGDBMIResult("file", resultsList));
     if (file.compare("Catch.omc") == 0) {
       disableCatchOMCBreakpoint();
@@ -1305,7 +1291,7 @@ void GDBAdapter::handleSignalReceived(GDBMIResultRecord *pGDBMIResultRecord)
         "thread-id=\"%3\"\n").arg(signalName, signalMeaning, threadId);
     GDBMIResult *pFrameGDBMIResult = getGDBMIResult("frame", pGDBMIResultRecord->miResultsList);
     if (pFrameGDBMIResult && pFrameGDBMIResult->miValue->type == GDBMIValue::TupleValue) {
-      GDBMIResultList resultsList = pFrameGDBMIResult->miValue->miTuple->miResultsList;
+      const GDBMIResultList &resultsList = pFrameGDBMIResult->miValue->miTuple->miResultsList;
       QString level = getGDBMIConstantValue(getGDBMIResult("level", resultsList));
       QString address = getGDBMIConstantValue(getGDBMIResult("addr", resultsList));
       QString function = getGDBMIConstantValue(getGDBMIResult("func", resultsList));
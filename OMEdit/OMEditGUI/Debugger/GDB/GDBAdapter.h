@@ -143,7 +143,7 @@ public:
   void isOptionNoneCB(GDBMIResultRecord *pGDBMIResultRecord);
   void createFullBacktraceCB(GDBMIResultRecord *pGDBMIResultRecord);
   void insertBreakpointCB(GDBMIResultRecord *pGDBMIResultRecord);
-  GDBMIResult* getGDBMIResult(const char *variable, GDBMIResultList resultsList);
+  GDBMIResult* getGDBMIResult(const char *variable, const GDBMIResultList &resultsList);
   QString getGDBMIConstantValue(GDBMIResult *pGDBMIResult);
   void insertBreakpoint(BreakpointTreeItem *pBreakpointTreeItem);
   void suspendDebugger();
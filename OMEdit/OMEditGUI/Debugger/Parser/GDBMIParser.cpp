@@ -53,6 +53,40 @@ GDBMIValue::~GDBMIValue()
   if (miList) delete miList;
 }
 
+GDBMIResultList::GDBMIResultList()
+{
+  mIndexedSize = 0;
+}
+
+/*!
+  Finds the first result named variable.\n
+  Short lists are searched linearly. Longer lists build a variable name index once and reuse it for the later lookups.
+  \param variable - the name of the result.
+  \return the result or 0 if not found.
+  */
+GDBMIResult* GDBMIResultList::find(const char *variable) const
+{
+  if (size() <= 8) {
+    for (const_iterator it = begin(); it != end(); ++it) {
+      if (strcmp((*it)->variable.c_str(), variable) == 0) {
+        return *it;
+      }
+    }
+    return 0;
+  }
+  /* the parser only appends results so rebuild the index if the list has grown. */
+  if (mIndexedSize != size()) {
+    mIndex.clear();
+    for (const_iterator it = begin(); it != end(); ++it) {
+      /* insert doesn't replace the existing key so the first result wins. */
+      mIndex.insert(GDBMIResultIndex::value_type((*it)->variable.c_str(), *it));
+    }
+    mIndexedSize = size();
+  }
+  GDBMIResultIndex::const_iterator it = mIndex.find(variable);
+  return it != mIndex.end() ? it->second : 0;
+}
+
 GDBMITuple::~GDBMITuple()
 {
   /* Delete the GDBMIResultList */
@@ -317,9 +351,9 @@ void printGDBMIResultRecord(GDBMIResultRecord *miResultRecord)
   printGDBMIResultList(miResultRecord->miResultsList);
 }
 
-void printGDBMIResultList(GDBMIResultList miResultsList)
+void printGDBMIResultList(const GDBMIResultList &miResultsList)
 {
-  GDBMIResultList::iterator it;
+  GDBMIResultList::const_iterator it;
   for (it = miResultsList.begin(); it != miResultsList.end(); ++it)
   {
     printGDBMIResult(*it);
@@ -38,6 +38,7 @@
 
 #include <map>
 #include <stdio.h>
+#include <string.h>
 #include <string>
 #include <sstream>
 #include <list>
@@ -67,7 +68,22 @@ public:
 };
 
 class GDBMIResult;
-typedef list<GDBMIResult*>GDBMIResultList;
+/* Compares the borrowed variable names of the index. */
+struct GDBMIVariableLess
+{
+  bool operator()(const char *variable1, const char *variable2) const {return strcmp(variable1, variable2) < 0;}
+};
+typedef map<const char*, GDBMIResult*, GDBMIVariableLess> GDBMIResultIndex;
+class GDBMIResultList : public list<GDBMIResult*>
+{
+public:
+  GDBMIResultList();
+  GDBMIResult* find(const char *variable) const;
+private:
+  /* the keys point to the variable strings owned by the results of the list. */
+  mutable GDBMIResultIndex mIndex;
+  mutable size_type mIndexedSize;
+};
 class GDBMITuple
 {
 public:
@@ -166,7 +182,7 @@ void printGDBMIOutOfBandRecordList(GDBMIOutOfBandRecordList miOutOfBandRecordLis
 void printGDBMIOutOfBandRecord(GDBMIOutOfBandRecord *miOutOfBandRecord);
 void printStreamRecord(GDBMIStreamRecord *miStreamRecord);
 void printGDBMIResultRecord(GDBMIResultRecord *miResultRecord);
-void printGDBMIResultList(GDBMIResultList miResultsList);
+void printGDBMIResultList(const GDBMIResultList &miResultsList);
 void printGDBMIResult(GDBMIResult *miResult);
 void printGDBMIValue(GDBMIValue *miValue);
 void printGDBMITuple(GDBMITuple *miTuple);
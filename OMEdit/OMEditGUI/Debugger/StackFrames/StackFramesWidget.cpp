@@ -266,7 +266,7 @@ void StackFramesTreeWidget::createStackFrames(GDBMIValue *pGDBMIValue)
         if (pGDBMIResult->miValue->type == GDBMIValue::TupleValue)
         {
           GDBAdapter *pGDBAdapter = mpStackFramesWidget->getDebuggerMainWindow()->getGDBAdapter();
-          GDBMIResultList resultsList = pGDBMIResult->miValue->miTuple->miResultsList;
+          const GDBMIResultList &resultsList = pGDBMIResult->miValue->miTuple->miResultsList;
           level = pGDBAdapter->getGDBMIConstantValue(pGDBAdapter->getGDBMIResult("level", resultsList));
           address = pGDBAdapter->getGDBMIConstantValue(pGDBAdapter->getGDBMIResult("addr", resultsList));
           function = pGDBAdapter->getGDBMIConstantValue(pGDBAdapter->getGDBMIResult("func", resultsList));
@@ -617,7 +617,7 @@ void StackFramesWidget::fillThreadComboBox(GDBMIValue *pThreadsGDBMIValue, QStri
       QString threadId;
       if (pGDBMIValue->type == GDBMIValue::TupleValue)
       {
-        GDBMIResultList resultsList = pGDBMIValue->miTuple->miResultsList;
+        const GDBMIResultList &resultsList = pGDBMIValue->miTuple->miResultsList;
         threadId = mpDebuggerMainWindow->getGDBAdapter()->getGDBMIConstantValue(mpDebuggerMainWindow->getGDBAdapter()->getGDBMIResult("id", resultsList));
         if (!threadId.isEmpty())
         {
@@ -588,8 +588,6 @@ void ModelicaTextHighlighter::initializeSettings()
   mpPlainTextEdit->document()->setDefaultFont(font);
   mpPlainTextEdit->setTabStopWidth(mpModelicaEditorPage->getOptionsDialog()->getTextEditorPage()->getTabSizeSpinBox()->value() * QFontMetrics(font).width(QLatin1Char(' ')));
   // set color highlighting
-  mHighlightingRules.clear();
-  HighlightingRule rule;
   mTextFormat.setForeground(mpModelicaEditorPage->getTextRuleColor());
   mKeywordFormat.setForeground(mpModelicaEditorPage->getKeywordRuleColor());
   mTypeFormat.setForeground(mpModelicaEditorPage->getTypeRuleColor());
@@ -597,107 +595,97 @@ void ModelicaTextHighlighter::initializeSettings()
   mMultiLineCommentFormat.setForeground(mpModelicaEditorPage->getCommentRuleColor());
   mFunctionFormat.setForeground(mpModelicaEditorPage->getFunctionRuleColor());
   mQuotationFormat.setForeground(QColor(mpModelicaEditorPage->getQuotesRuleColor()));
-  // Priority: keyword > func() > ident > number. Yes, the order matters :)
   mNumberFormat.setForeground(mpModelicaEditorPage->getNumberRuleColor());
-  rule.mPattern = QRegExp("[0-9][0-9]*([.][0-9]*)?([eE][+-]?[0-9]*)?");
-  rule.mFormat = mNumberFormat;
-  mHighlightingRules.append(rule);
-  rule.mPattern = QRegExp("\\b[A-Za-z_][A-Za-z0-9_]*");
-  rule.mFormat = mTextFormat;
-  mHighlightingRules.append(rule);
-  // keywords
-  QStringList keywordPatterns;
-  keywordPatterns << "\\balgorithm\\b"
-                  << "\\band\\b"
-                  << "\\bannotation\\b"
-                  << "\\bassert\\b"
-                  << "\\bblock\\b"
-                  << "\\bbreak\\b"
-                  << "\\bBoolean\\b"
-                  << "\\bclass\\b"
-                  << "\\bconnect\\b"
-                  << "\\bconnector\\b"
-                  << "\\bconstant\\b"
-                  << "\\bconstrainedby\\b"
-                  << "\\bder\\b"
-                  << "\\bdiscrete\\b"
-                  << "\\beach\\b"
-                  << "\\belse\\b"
-                  << "\\belseif\\b"
-                  << "\\belsewhen\\b"
-                  << "\\bencapsulated\\b"
-                  << "\\bend\\b"
-                  << "\\benumeration\\b"
-                  << "\\bequation\\b"
-                  << "\\bexpandable\\b"
-                  << "\\bextends\\b"
-                  << "\\bexternal\\b"
-                  << "\\bfalse\\b"
-                  << "\\bfinal\\b"
-                  << "\\bflow\\b"
-                  << "\\bfor\\b"
-                  << "\\bfunction\\b"
-                  << "\\bif\\b"
-                  << "\\bimport\\b"
-                  << "\\bimpure\\b"
-                  << "\\bin\\b"
-                  << "\\binitial\\b"
-                  << "\\binner\\b"
-                  << "\\binput\\b"
-                  << "\\bloop\\b"
-                  << "\\bmodel\\b"
-                  << "\\bnot\\b"
-                  << "\\boperator\\b"
-                  << "\\bor\\b"
-                  << "\\bouter\\b"
-                  << "\\boutput\\b"
-                  << "\\boptimization\\b"
-                  << "\\bpackage\\b"
-                  << "\\bparameter\\b"
-                  << "\\bpartial\\b"
-                  << "\\bprotected\\b"
-                  << "\\bpublic\\b"
-                  << "\\bpure\\b"
-                  << "\\brecord\\b"
-                  << "\\bredeclare\\b"
-                  << "\\breplaceable\\b"
-                  << "\\breturn\\b"
-                  << "\\bstream\\b"
-                  << "\\bthen\\b"
-                  << "\\btrue\\b"
-                  << "\\btype\\b"
-                  << "\\bwhen\\b"
-                  << "\\bwhile\\b"
-                  << "\\bwithin\\b";
-  foreach (const QString &pattern, keywordPatterns)
-  {
-    rule.mPattern = QRegExp(pattern);
-    rule.mFormat = mKeywordFormat;
-    mHighlightingRules.append(rule);
+}
+
+/* The Modelica keywords and types highlighted by ModelicaTextHighlighter. */
+static const char *modelicaKeywords[] = {
+  "algorithm", "and", "annotation", "assert", "block", "break", "class", "connect", "connector", "constant", "constrainedby", "der",
+  "discrete", "each", "else", "elseif", "elsewhen", "encapsulated", "end", "enumeration", "equation", "expandable", "extends",
+  "external", "false", "final", "flow", "for", "function", "if", "import", "impure", "in", "initial", "inner", "input", "loop",
+  "model", "not", "operator", "or", "outer", "output", "optimization", "package", "parameter", "partial", "protected", "public",
+  "pure", "record", "redeclare", "replaceable", "return", "stream", "then", "true", "type", "when", "while", "within", 0
+};
+static const char *modelicaTypes[] = {"String", "Integer", "Boolean", "Real", 0};
+
+typedef struct {
+  const char *mpWord;
+  int mLength;
+  bool mIsType;
+} ModelicaWord;
+
+/*!
+ * \brief modelicaWordHash
+ * A perfect hash of the Modelica keywords and types. The factors are chosen so that no two words get the same value.
+ * \param pWord
+ * \param length - must be at least 2.
+ * \return a value between 0 and 255.
+ */
+static inline int modelicaWordHash(const QChar *pWord, int length)
+{
+  return (length + 5 * pWord[0].unicode() + 5 * pWord[1].unicode() + 23 * pWord[length - 1].unicode()) & 255;
+}
+
+/*!
+ * \brief findModelicaWord
+ * Looks up the word in the table of Modelica keywords and types.
+ * \param pWord
+ * \param length
+ * \return the table entry or 0 if the word is not a keyword or type.
+ */
+static const ModelicaWord* findModelicaWord(const QChar *pWord, int length)
+{
+  static ModelicaWord table[256];
+  static bool initialized = false;
+  if (!initialized) {
+    for (int i = 0 ; i < 2 ; i++) {
+      for (const char **ppWord = i == 0 ? modelicaKeywords : modelicaTypes ; *ppWord ; ppWord++) {
+        QString word = QString::fromLatin1(*ppWord);
+        ModelicaWord &entry = table[modelicaWordHash(word.constData(), word.length())];
+        Q_ASSERT(!entry.mpWord);
+        entry.mpWord = *ppWord;
+        entry.mLength = word.length();
+        entry.mIsType = i == 1;
+      }
+    }
+    initialized = true;
+  }
+  if (length < 2) {
+    return 0;
   }
-  // Modelica types
-  QStringList typePatterns;
-  typePatterns << "\\bString\\b"
-               << "\\bInteger\\b"
-               << "\\bBoolean\\b"
-               << "\\bReal\\b";
-  foreach (const QString &pattern, typePatterns)
-  {
-    rule.mPattern = QRegExp(pattern);
-    rule.mFormat = mTypeFormat;
-    mHighlightingRules.append(rule);
+  const ModelicaWord *pEntry = &table[modelicaWordHash(pWord, length)];
+  if (!pEntry->mpWord || pEntry->mLength != length) {
+    return 0;
   }
+  for (int i = 0 ; i < length ; i++) {
+    if (pWord[i].unicode() != (ushort)pEntry->mpWord[i]) {
+      return 0;
+    }
+  }
+  return pEntry;
+}
 
-  rule.mPattern = QRegExp("\\b[A-Za-z0-9_]+(?=\\()");
-  rule.mFormat = mFunctionFormat;
-  mHighlightingRules.append(rule);
+static inline bool isModelicaIdentifierStart(QChar c)
+{
+  ushort u = c.unicode();
+  return (u >= 'a' && u <= 'z') || (u >= 'A' && u <= 'Z') || u == '_';
+}
+
+static inline bool isModelicaDigit(QChar c)
+{
+  return c.unicode() >= '0' && c.unicode() <= '9';
+}
+
+static inline bool isModelicaIdentifierChar(QChar c)
+{
+  return isModelicaIdentifierStart(c) || isModelicaDigit(c);
 }
 
 /*!
  * \brief ModelicaTextHighlighter::highlightMultiLine
- * Highlights the multilines text.
- * Quoted text or multiline comments.
- * \param text
+ * Highlights the text in a single pass.\n
+ * Numbers, identifiers, keywords, types and function calls are recognized outside of comments and quotes.
+ * Multiline comments and quoted text continue in the next block through the block state.
  * \param text
  */
 void ModelicaTextHighlighter::highlightMultiLine(const QString &text)
@@ -705,6 +693,7 @@ void ModelicaTextHighlighter::highlightMultiLine(const QString &text)
   /* Hand-written recognizer beats the crap known as QRegEx ;) */
   int index = 0, startIndex = 0;
   int blockState = previousBlockState();
+  bool matchParenthesesCommentsQuotes = mpModelicaEditorPage->getOptionsDialog()->getTextEditorPage()->getMatchParenthesesCommentsQuotesCheckBox()->isChecked();
   // store parentheses info
   Parentheses parentheses;
   TextBlockUserData *pTextBlockUserData = BaseEditorDocumentLayout::userData(currentBlock());
@@ -747,10 +736,47 @@ void ModelicaTextHighlighter::highlightMultiLine(const QString &text)
         } else if (text[index] == '"') {
           startIndex = index;
           blockState = 3;
+        } else if (isModelicaDigit(text[index])) {
+          /* number [0-9]+([.][0-9]*)?([eE][+-]?[0-9]*)? */
+          startIndex = index;
+          while (index + 1 < text.length() && isModelicaDigit(text[index + 1])) {
+            index++;
+          }
+          if (index + 1 < text.length() && text[index + 1] == '.') {
+            index++;
+            while (index + 1 < text.length() && isModelicaDigit(text[index + 1])) {
+              index++;
+            }
+          }
+          if (index + 1 < text.length() && (text[index + 1] == 'e' || text[index + 1] == 'E')) {
+            index++;
+            if (index + 1 < text.length() && (text[index + 1] == '+' || text[index + 1] == '-')) {
+              index++;
+            }
+            while (index + 1 < text.length() && isModelicaDigit(text[index + 1])) {
+              index++;
+            }
+          }
+          setFormat(startIndex, index - startIndex + 1, mNumberFormat);
+        } else if (isModelicaIdentifierStart(text[index]) && (index == 0 || !isModelicaIdentifierChar(text[index - 1]))) {
+          /* identifier. A function call if followed by ( otherwise check if it is a keyword or a type. */
+          startIndex = index;
+          while (index + 1 < text.length() && isModelicaIdentifierChar(text[index + 1])) {
+            index++;
+          }
+          int length = index - startIndex + 1;
+          if (index + 1 < text.length() && text[index + 1] == '(') {
+            setFormat(startIndex, length, mFunctionFormat);
+          } else {
+            const ModelicaWord *pModelicaWord = findModelicaWord(text.constData() + startIndex, length);
+            if (pModelicaWord) {
+              setFormat(startIndex, length, pModelicaWord->mIsType ? mTypeFormat : mKeywordFormat);
+            }
+          }
         }
     }
     // if no single line comment, no multi line comment and no quotes then store the parentheses
-    if (pTextBlockUserData && (blockState < 1 || blockState > 3 || mpModelicaEditorPage->getOptionsDialog()->getTextEditorPage()->getMatchParenthesesCommentsQuotesCheckBox()->isChecked())) {
+    if (pTextBlockUserData && (blockState < 1 || blockState > 3 || matchParenthesesCommentsQuotes)) {
       if (text[index] == '(' || text[index] == '{' || text[index] == '[') {
         parentheses.append(Parenthesis(Parenthesis::Opened, text[index], index));
       } else if (text[index] == ')' || text[index] == '}' || text[index] == ']') {
@@ -785,16 +811,7 @@ void ModelicaTextHighlighter::highlightBlock(const QString &text)
   }
   // set text block state
   setCurrentBlockState(0);
-  setFormat(0, text.length(), mpModelicaEditorPage->getTextRuleColor());
-  foreach (const HighlightingRule &rule, mHighlightingRules) {
-    QRegExp expression(rule.mPattern);
-    int index = expression.indexIn(text);
-    while (index >= 0) {
-      int length = expression.matchedLength();
-      setFormat(index, length, rule.mFormat);
-      index = expression.indexIn(text, index + length);
-    }
-  }
+  setFormat(0, text.length(), mTextFormat);
   highlightMultiLine(text);
 }
 
@@ -82,6 +82,7 @@ public:
   QString removeLeadingSpaces(QString contents);
   void storeLeadingSpaces(QMap<int, int> leadingSpacesMap);
   QString getPlainText();
+  bool isTextChanged() {return mTextChanged;}
 private:
   QString mLastValidText;
   bool mTextChanged;
@@ -107,12 +108,6 @@ protected:
 private:
   ModelicaEditorPage *mpModelicaEditorPage;
   QPlainTextEdit *mpPlainTextEdit;
-  struct HighlightingRule
-  {
-    QRegExp mPattern;
-    QTextCharFormat mFormat;
-  };
-  QVector<HighlightingRule> mHighlightingRules;
   QTextCharFormat mTextFormat;
   QTextCharFormat mKeywordFormat;
   QTextCharFormat mTypeFormat;
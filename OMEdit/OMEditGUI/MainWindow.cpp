@@ -49,8 +49,8 @@
 #include "omc_config.h"
 #endif
 
-MainWindow::MainWindow(QSplashScreen *pSplashScreen, bool debug, QWidget *parent)
-  : QMainWindow(parent), mDebug(debug), mExitApplicationStatus(false)
+MainWindow::MainWindow(QSplashScreen *pSplashScreen, bool debug, bool batch, QWidget *parent)
+  : QMainWindow(parent), mDebug(debug), mBatch(batch), mExitApplicationStatus(false)
 {
   // This is a very convoluted way of asking for the default system font in Qt
   QFont systmFont("Monospace");
@@ -80,9 +80,13 @@ MainWindow::MainWindow(QSplashScreen *pSplashScreen, bool debug, QWidget *parent
   if (getExitApplicationStatus()) {
     return;
   }
-  pSplashScreen->showMessage(tr("Reading Settings"), Qt::AlignRight, Qt::white);
+  if (pSplashScreen) {
+    pSplashScreen->showMessage(tr("Reading Settings"), Qt::AlignRight, Qt::white);
+  }
   mpOptionsDialog = new OptionsDialog(this);
-  pSplashScreen->showMessage(tr("Loading Widgets"), Qt::AlignRight, Qt::white);
+  if (pSplashScreen) {
+    pSplashScreen->showMessage(tr("Loading Widgets"), Qt::AlignRight, Qt::white);
+  }
   // Create an object of MessagesWidget.
   mpMessagesWidget = new MessagesWidget(this);
   // Create MessagesDockWidget dock
@@ -93,35 +97,40 @@ MainWindow::MainWindow(QSplashScreen *pSplashScreen, bool debug, QWidget *parent
   addDockWidget(Qt::BottomDockWidgetArea, mpMessagesDockWidget);
   mpMessagesDockWidget->hide();
   connect(mpMessagesWidget, SIGNAL(MessageAdded()), mpMessagesDockWidget, SLOT(show()));
-  // Reopen the standard output stream.
-  QString outputFileName = OpenModelica::tempDirectory() + "/omeditoutput.txt";
-  freopen(outputFileName.toStdString().c_str(), "w", stdout);
-  setbuf(stdout, NULL); // used non-buffered stdout
+  /* In batch mode the output of OMC and the messages go to the console. */
   mpOutputFileDataNotifier = 0;
-  mOutputFile.setFileName(outputFileName);
-  if (mOutputFile.open(QIODevice::ReadOnly)) {
-    mpOutputFileDataNotifier = new FileDataNotifier(outputFileName);
-    connect(mpOutputFileDataNotifier, SIGNAL(bytesAvailable(qint64)), SLOT(readOutputFile(qint64)));
-    mpOutputFileDataNotifier->start();
-  } else {
-    mpMessagesWidget->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0, tr("Can't open file %1.").arg(outputFileName), Helper::scriptingKind,
-                                                Helper::errorLevel));
-
-  }
-  // Reopen the standard error stream.
-  QString errorFileName = OpenModelica::tempDirectory() + "/omediterror.txt";
-  freopen(errorFileName.toStdString().c_str(), "w", stderr);
-  setbuf(stderr, NULL); // used non-buffered stderr
   mpErrorFileDataNotifier = 0;
-  mErrorFile.setFileName(errorFileName);
-  if (mErrorFile.open(QIODevice::ReadOnly)) {
-    mpErrorFileDataNotifier = new FileDataNotifier(errorFileName);
-    connect(mpErrorFileDataNotifier, SIGNAL(bytesAvailable(qint64)), SLOT(readErrorFile(qint64)));
-    mpErrorFileDataNotifier->start();
-  } else {
-    mpMessagesWidget->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0, tr("Can't open file %1.").arg(errorFileName), Helper::scriptingKind,
-                                                Helper::errorLevel));
+  if (!mBatch) {
+    // Reopen the standard output stream.
+    QString outputFileName = OpenModelica::tempDirectory() + "/omeditoutput.txt";
+    freopen(outputFileName.toStdString().c_str(), "w", stdout);
+    setbuf(stdout, NULL); // used non-buffered stdout
+    mpOutputFileDataNotifier = 0;
+    mOutputFile.setFileName(outputFileName);
+    if (mOutputFile.open(QIODevice::ReadOnly)) {
+      mpOutputFileDataNotifier = new FileDataNotifier(outputFileName);
+      connect(mpOutputFileDataNotifier, SIGNAL(bytesAvailable(qint64)), SLOT(readOutputFile(qint64)));
+      mpOutputFileDataNotifier->start();
+    } else {
+      mpMessagesWidget->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0, tr("Can't open file %1.").arg(outputFileName), Helper::scriptingKind,
+                                                  Helper::errorLevel));
 
+    }
+    // Reopen the standard error stream.
+    QString errorFileName = OpenModelica::tempDirectory() + "/omediterror.txt";
+    freopen(errorFileName.toStdString().c_str(), "w", stderr);
+    setbuf(stderr, NULL); // used non-buffered stderr
+    mpErrorFileDataNotifier = 0;
+    mErrorFile.setFileName(errorFileName);
+    if (mErrorFile.open(QIODevice::ReadOnly)) {
+      mpErrorFileDataNotifier = new FileDataNotifier(errorFileName);
+      connect(mpErrorFileDataNotifier, SIGNAL(bytesAvailable(qint64)), SLOT(readErrorFile(qint64)));
+      mpErrorFileDataNotifier->start();
+    } else {
+      mpMessagesWidget->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0, tr("Can't open file %1.").arg(errorFileName), Helper::scriptingKind,
+                                                  Helper::errorLevel));
+
+    }
   }
   // Create an object of QStatusBar
   mpStatusBar = new QStatusBar();
@@ -200,7 +209,9 @@ MainWindow::MainWindow(QSplashScreen *pSplashScreen, bool debug, QWidget *parent
   mpVariablesDockWidget->hide();
   mpVariablesDockWidget->setWidget(mpVariablesWidget);
   //Create Actions, Toolbar and Menus
-  pSplashScreen->showMessage(tr("Creating Widgets"), Qt::AlignRight, Qt::white);
+  if (pSplashScreen) {
+    pSplashScreen->showMessage(tr("Creating Widgets"), Qt::AlignRight, Qt::white);
+  }
   setAcceptDrops(true);
   createActions();
   createToolbars();
@@ -238,8 +249,10 @@ MainWindow::MainWindow(QSplashScreen *pSplashScreen, bool debug, QWidget *parent
   pCentralwidget->setLayout(pCentralgrid);
   //Set the centralwidget
   setCentralWidget(pCentralwidget);
-  // Load and add user defined Modelica libraries into the Library Widget.
-  mpLibraryWidget->getLibraryTreeModel()->addModelicaLibraries(pSplashScreen);
+  // Load and add user defined Modelica libraries into the Library Widget. The batch scripts load only the libraries they need.
+  if (!mBatch) {
+    mpLibraryWidget->getLibraryTreeModel()->addModelicaLibraries(pSplashScreen);
+  }
   // set the matching algorithm.
   mpOMCProxy->setMatchingAlgorithm(mpOptionsDialog->getSimulationPage()->getMatchingAlgorithmComboBox()->currentText());
   // set the index reduction methods.
@@ -255,10 +268,10 @@ MainWindow::MainWindow(QSplashScreen *pSplashScreen, bool debug, QWidget *parent
   mpOMCProxy->setCommandLineOptions(QString("+target=%1").arg(mpOptionsDialog->getSimulationPage()->getTargetCompilerComboBox()->currentText()));
   // restore OMEdit widgets state
   QSettings *pSettings = OpenModelica::getApplicationSettings();
-  if (mpOptionsDialog->getGeneralSettingsPage()->getPreserveUserCustomizations())
+  if (!mBatch && mpOptionsDialog->getGeneralSettingsPage()->getPreserveUserCustomizations())
   {
     restoreGeometry(pSettings->value("application/geometry").toByteArray());
-    bool restoreMessagesWidget = !mpMessagesWidget->getMessagesTextBrowser()->toPlainText().isEmpty();
+    bool restoreMessagesWidget = mpMessagesWidget->hasMessages();
     restoreState(pSettings->value("application/windowState").toByteArray());
     if (restoreMessagesWidget) {
       mpMessagesDockWidget->show();
@@ -278,7 +291,7 @@ MainWindow::MainWindow(QSplashScreen *pSplashScreen, bool debug, QWidget *parent
   mpAutoSaveTimer->setInterval(mpOptionsDialog->getGeneralSettingsPage()->getAutoSaveIntervalSpinBox()->value() * 1000);
   connect(mpAutoSaveTimer, SIGNAL(timeout()), SLOT(autoSave()));
   // read auto save settings
-  if (mpOptionsDialog->getGeneralSettingsPage()->getEnableAutoSaveGroupBox()->isChecked()) {
+  if (!mBatch && mpOptionsDialog->getGeneralSettingsPage()->getEnableAutoSaveGroupBox()->isChecked()) {
     mpAutoSaveTimer->start();
   }
 }
@@ -555,19 +568,8 @@ void MainWindow::instantiateModel(LibraryTreeItem *pLibraryTreeItem)
   if (mpOptionsDialog->getMessagesPage()->getResetMessagesNumberBeforeSimulationCheckBox()->isChecked()) {
     mpMessagesWidget->resetMessagesNumber();
   }
-  QString instantiateModelResult = mpOMCProxy->instantiateModel(pLibraryTreeItem->getNameStructure());
-  if (!instantiateModelResult.isEmpty()) {
-    mpMessagesWidget->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0,
-                                                tr("Instantiation of %1 completed successfully.").arg(pLibraryTreeItem->getNameStructure()),
-                                                Helper::scriptingKind, Helper::notificationLevel));
-    QString windowTitle = QString(Helper::instantiateModel).append(" - ").append(pLibraryTreeItem->getNameStructure());
-    InformationDialog *pInformationDialog = new InformationDialog(windowTitle, instantiateModelResult, true, this);
-    pInformationDialog->show();
-  }
-  // hide progress bar
-  hideProgressBar();
-  // clear the status bar message
-  mpStatusBar->clearMessage();
+  OMCFuture future = mpOMCProxy->instantiateModelAsync(pLibraryTreeItem->getNameStructure(), this, SLOT(modelInstantiated(OMCFuture)));
+  startModelQuery(future, pLibraryTreeItem->getNameStructure());
 }
 
 void MainWindow::checkModel(LibraryTreeItem *pLibraryTreeItem)
@@ -587,19 +589,8 @@ void MainWindow::checkModel(LibraryTreeItem *pLibraryTreeItem)
   if (mpOptionsDialog->getMessagesPage()->getResetMessagesNumberBeforeSimulationCheckBox()->isChecked()) {
     mpMessagesWidget->resetMessagesNumber();
   }
-  QString checkModelResult = mpOMCProxy->checkModel(pLibraryTreeItem->getNameStructure());
-  if (!checkModelResult.isEmpty()) {
-    mpMessagesWidget->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0,
-                                                tr("Check of %1 completed successfully.").arg(pLibraryTreeItem->getNameStructure()),
-                                                Helper::scriptingKind, Helper::notificationLevel));
-    QString windowTitle = QString(Helper::checkModel).append(" - ").append(pLibraryTreeItem->getNameStructure());
-    InformationDialog *pInformationDialog = new InformationDialog(windowTitle, checkModelResult, false, this);
-    pInformationDialog->show();
-  }
-  // hide progress bar
-  hideProgressBar();
-  // clear the status bar message
-  mpStatusBar->clearMessage();
+  OMCFuture future = mpOMCProxy->checkModelAsync(pLibraryTreeItem->getNameStructure(), false, this, SLOT(modelChecked(OMCFuture)));
+  startModelQuery(future, pLibraryTreeItem->getNameStructure());
 }
 
 void MainWindow::checkAllModels(LibraryTreeItem *pLibraryTreeItem)
@@ -615,17 +606,44 @@ void MainWindow::checkAllModels(LibraryTreeItem *pLibraryTreeItem)
   // show the progress bar
   mpProgressBar->setRange(0, 0);
   showProgressBar();
-  QString checkAllModelsResult = mpOMCProxy->checkAllModelsRecursive(pLibraryTreeItem->getNameStructure());
-  if (!checkAllModelsResult.isEmpty()) {
-    mpMessagesWidget->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0, checkAllModelsResult, Helper::scriptingKind,
-                                                Helper::notificationLevel));
+  OMCFuture future = mpOMCProxy->checkModelAsync(pLibraryTreeItem->getNameStructure(), true, this, SLOT(allModelsChecked(OMCFuture)));
+  startModelQuery(future, pLibraryTreeItem->getNameStructure());
+}
+
+/*!
+ * \brief MainWindow::startModelQuery
+ * Remembers the class of the queued check or instantiation so the result can be reported when the OMCWorkerThread is done.
+ * \param future
+ * \param className
+ */
+void MainWindow::startModelQuery(const OMCFuture &future, const QString &className)
+{
+  if (future.isValid()) {
+    mModelQueries.insert(future.getId(), className);
+  } else {
+    finishModelQuery(future);
   }
-  // hide progress bar
-  hideProgressBar();
-  // clear the status bar message
-  mpStatusBar->clearMessage();
 }
 
+/*!
+ * \brief MainWindow::finishModelQuery
+ * Returns the class of the finished check or instantiation. Hides the progress bar when no other query is pending.
+ * \param future
+ * \return the class name
+ */
+QString MainWindow::finishModelQuery(const OMCFuture &future)
+{
+  QString className = mModelQueries.take(future.getId());
+  if (mModelQueries.isEmpty()) {
+    // hide progress bar
+    hideProgressBar();
+    // clear the status bar message
+    mpStatusBar->clearMessage();
+  }
+  return className;
+}
+
+
 void MainWindow::exportModelFMU(LibraryTreeItem *pLibraryTreeItem)
 {
   /* if Modelica text is changed manually by user then validate it before saving. */
@@ -1251,7 +1269,10 @@ void MainWindow::undo()
       ((pModelWidget->getIconGraphicsView() && pModelWidget->getIconGraphicsView()->isVisible()) ||
        (pModelWidget->getDiagramGraphicsView() && pModelWidget->getDiagramGraphicsView()->isVisible()))) {
     pModelWidget->clearSelection();
+    // send the component and connection updates of a compound entry as one OMC command.
+    mpOMCProxy->beginCommandsBatch();
     pModelWidget->getUndoStack()->undo();
+    mpOMCProxy->endCommandsBatch();
     pModelWidget->updateClassAnnotationIfNeeded();
     pModelWidget->updateModelText();
   }
@@ -1268,7 +1289,10 @@ void MainWindow::redo()
       ((pModelWidget->getIconGraphicsView() && pModelWidget->getIconGraphicsView()->isVisible()) ||
        (pModelWidget->getDiagramGraphicsView() && pModelWidget->getDiagramGraphicsView()->isVisible()))) {
     pModelWidget->clearSelection();
+    // send the component and connection updates of a compound entry as one OMC command.
+    mpOMCProxy->beginCommandsBatch();
     pModelWidget->getUndoStack()->redo();
+    mpOMCProxy->endCommandsBatch();
     pModelWidget->updateClassAnnotationIfNeeded();
     pModelWidget->updateModelText();
   }
@@ -1483,6 +1507,59 @@ void MainWindow::checkAllModels()
   }
 }
 
+/*!
+ * \brief MainWindow::modelInstantiated
+ * Slot activated when the OMCWorkerThread finishes the instantiation started by MainWindow::instantiateModel.
+ * \param future
+ */
+void MainWindow::modelInstantiated(OMCFuture future)
+{
+  QString className = finishModelQuery(future);
+  QString instantiateModelResult = mpOMCProxy->getModelQueryResult(future);
+  if (!instantiateModelResult.isEmpty()) {
+    mpMessagesWidget->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0,
+                                                tr("Instantiation of %1 completed successfully.").arg(className),
+                                                Helper::scriptingKind, Helper::notificationLevel));
+    QString windowTitle = QString(Helper::instantiateModel).append(" - ").append(className);
+    InformationDialog *pInformationDialog = new InformationDialog(windowTitle, instantiateModelResult, true, this);
+    pInformationDialog->show();
+  }
+}
+
+/*!
+ * \brief MainWindow::modelChecked
+ * Slot activated when the OMCWorkerThread finishes the check started by MainWindow::checkModel.
+ * \param future
+ */
+void MainWindow::modelChecked(OMCFuture future)
+{
+  QString className = finishModelQuery(future);
+  QString checkModelResult = mpOMCProxy->getModelQueryResult(future);
+  if (!checkModelResult.isEmpty()) {
+    mpMessagesWidget->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0,
+                                                tr("Check of %1 completed successfully.").arg(className),
+                                                Helper::scriptingKind, Helper::notificationLevel));
+    QString windowTitle = QString(Helper::checkModel).append(" - ").append(className);
+    InformationDialog *pInformationDialog = new InformationDialog(windowTitle, checkModelResult, false, this);
+    pInformationDialog->show();
+  }
+}
+
+/*!
+ * \brief MainWindow::allModelsChecked
+ * Slot activated when the OMCWorkerThread finishes the check started by MainWindow::checkAllModels.
+ * \param future
+ */
+void MainWindow::allModelsChecked(OMCFuture future)
+{
+  finishModelQuery(future);
+  QString checkAllModelsResult = mpOMCProxy->getModelQueryResult(future);
+  if (!checkAllModelsResult.isEmpty()) {
+    mpMessagesWidget->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0, checkAllModelsResult, Helper::scriptingKind,
+                                                Helper::notificationLevel));
+  }
+}
+
 /*!
   Simualtes the model directly.
   */
@@ -1694,52 +1771,19 @@ void MainWindow::exportModelAsImage(bool copyToClipboard)
         return;
       }
     }
-    bool oldSkipDrawBackground;
     // show the progressbar and set the message in status bar
     mpProgressBar->setRange(0, 0);
     showProgressBar();
     mpStatusBar->showMessage(tr("Exporting model as an Image"));
-    QPainter painter;
-    QSvgGenerator svgGenerator;
     GraphicsView *pGraphicsView;
     if (pLibraryTreeItem->getModelWidget()->getIconGraphicsView()->isVisible()) {
       pGraphicsView = pLibraryTreeItem->getModelWidget()->getIconGraphicsView();
     } else {
       pGraphicsView = pLibraryTreeItem->getModelWidget()->getDiagramGraphicsView();
     }
-    QRect destinationRect = pGraphicsView->itemsBoundingRect().toAlignedRect();
-    QImage modelImage(destinationRect.size(), QImage::Format_ARGB32_Premultiplied);
-    // export svg
-    if (fileName.endsWith(".svg")) {
-      svgGenerator.setTitle(QString(Helper::applicationName).append(" - ").append(Helper::applicationIntroText));
-      svgGenerator.setDescription("Generated by OMEdit - OpenModelica Connection Editor");
-      svgGenerator.setSize(destinationRect.size());
-      svgGenerator.setViewBox(QRect(0, 0, destinationRect.width(), destinationRect.height()));
-      svgGenerator.setFileName(fileName);
-      painter.begin(&svgGenerator);
-    } else {
-      if (fileName.endsWith(".png") || fileName.endsWith(".tiff")) {
-        modelImage.fill(QColor(Qt::transparent));
-      } else if (fileName.endsWith(".bmp") || copyToClipboard) {
-        modelImage.fill(QColor(Qt::white));
-      }
-      painter.begin(&modelImage);
-    }
-    painter.setWindow(destinationRect);
-    // paint all the items
-    oldSkipDrawBackground = pGraphicsView->mSkipBackground;
-    pGraphicsView->mSkipBackground = true;
-    pGraphicsView->render(&painter, destinationRect, destinationRect);
-    painter.end();
-    pGraphicsView->mSkipBackground = oldSkipDrawBackground;
-    if (!fileName.endsWith(".svg") && !copyToClipboard) {
-      if (!modelImage.save(fileName)) {
-        QMessageBox::critical(this, QString(Helper::applicationName).append(" - ").append(Helper::error),
-                              tr("Error saving the image file"), Helper::ok);
-      }
-    } else if (copyToClipboard) {
-      QClipboard *pClipboard = QApplication::clipboard();
-      pClipboard->setImage(modelImage);
+    if (!exportGraphicsViewToImage(pGraphicsView, fileName, copyToClipboard)) {
+      QMessageBox::critical(this, QString(Helper::applicationName).append(" - ").append(Helper::error),
+                            tr("Error saving the image file"), Helper::ok);
     }
     // hide the progressbar and clear the message in status bar
     mpStatusBar->clearMessage();
@@ -1750,6 +1794,54 @@ void MainWindow::exportModelAsImage(bool copyToClipboard)
   }
 }
 
+/*!
+ * \brief MainWindow::exportGraphicsViewToImage
+ * Renders the items of the GraphicsView to an image file or to the clipboard.\n
+ * The file format is chosen by the extension of the file name. svg files are written with QSvgGenerator.
+ * \param pGraphicsView
+ * \param fileName
+ * \param copyToClipboard
+ * \return false if the image file can't be saved.
+ */
+bool MainWindow::exportGraphicsViewToImage(GraphicsView *pGraphicsView, QString fileName, bool copyToClipboard)
+{
+  bool oldSkipDrawBackground;
+  QPainter painter;
+  QSvgGenerator svgGenerator;
+  QRect destinationRect = pGraphicsView->itemsBoundingRect().toAlignedRect();
+  QImage modelImage(destinationRect.size(), QImage::Format_ARGB32_Premultiplied);
+  // export svg
+  if (fileName.endsWith(".svg")) {
+    svgGenerator.setTitle(QString(Helper::applicationName).append(" - ").append(Helper::applicationIntroText));
+    svgGenerator.setDescription("Generated by OMEdit - OpenModelica Connection Editor");
+    svgGenerator.setSize(destinationRect.size());
+    svgGenerator.setViewBox(QRect(0, 0, destinationRect.width(), destinationRect.height()));
+    svgGenerator.setFileName(fileName);
+    painter.begin(&svgGenerator);
+  } else {
+    if (fileName.endsWith(".png") || fileName.endsWith(".tiff")) {
+      modelImage.fill(QColor(Qt::transparent));
+    } else if (fileName.endsWith(".bmp") || copyToClipboard) {
+      modelImage.fill(QColor(Qt::white));
+    }
+    painter.begin(&modelImage);
+  }
+  painter.setWindow(destinationRect);
+  // paint all the items
+  oldSkipDrawBackground = pGraphicsView->mSkipBackground;
+  pGraphicsView->mSkipBackground = true;
+  pGraphicsView->render(&painter, destinationRect, destinationRect);
+  painter.end();
+  pGraphicsView->mSkipBackground = oldSkipDrawBackground;
+  if (!fileName.endsWith(".svg") && !copyToClipboard) {
+    return modelImage.save(fileName);
+  } else if (copyToClipboard) {
+    QClipboard *pClipboard = QApplication::clipboard();
+    pClipboard->setImage(modelImage);
+  }
+  return true;
+}
+
 /*!
   Slot activated when mpExportToClipboardAction triggered signal is raised.\n
   Copies the current model to clipboard.
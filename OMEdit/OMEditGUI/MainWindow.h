@@ -86,6 +86,7 @@ class SimulationDialog;
 class TLMCoSimulationDialog;
 class PlotWindowContainer;
 class ModelWidgetContainer;
+class GraphicsView;
 class DebuggerMainWindow;
 class InfoBar;
 class WelcomePageWidget;
@@ -96,8 +97,9 @@ class MainWindow : public QMainWindow
   Q_OBJECT
 public:
   enum { MaxRecentFiles = 8 };
-  MainWindow(QSplashScreen *pSplashScreen, bool debug, QWidget *parent = 0);
+  MainWindow(QSplashScreen *pSplashScreen, bool debug, bool batch = false, QWidget *parent = 0);
   bool isDebug() {return mDebug;}
+  bool isBatch() {return mBatch;}
   OMCProxy* getOMCProxy() {return mpOMCProxy;}
   void setExitApplicationStatus(bool status) {mExitApplicationStatus = status;}
   bool getExitApplicationStatus() {return mExitApplicationStatus;}
@@ -182,6 +184,7 @@ public:
   void fetchInterfaceData(LibraryTreeItem *pLibraryTreeItem);
   void TLMSimulate(LibraryTreeItem *pLibraryTreeItem);
   void exportModelToOMNotebook(LibraryTreeItem *pLibraryTreeItem);
+  bool exportGraphicsViewToImage(GraphicsView *pGraphicsView, QString fileName, bool copyToClipboard = false);
   void createOMNotebookTitleCell(LibraryTreeItem *pLibraryTreeItem, QDomDocument xmlDocument, QDomElement domElement);
   void createOMNotebookImageCell(LibraryTreeItem *pLibraryTreeItem, QDomDocument xmlDocument, QDomElement domElement, QString filePath);
   void createOMNotebookCodeCell(LibraryTreeItem *pLibraryTreeItem, QDomDocument xmlDocument, QDomElement domElement);
@@ -193,6 +196,7 @@ public:
                                    const char* variables);
 private:
   bool mDebug;
+  bool mBatch;
   OMCProxy *mpOMCProxy;
   bool mExitApplicationStatus;
   OptionsDialog *mpOptionsDialog;
@@ -338,6 +342,7 @@ private:
   QToolBar *mpPlotToolBar;
   QToolBar *mpTLMSimulationToolbar;
   QHash<QString, TransformationsWidget*> mTransformationsWidgetHash;
+  QHash<quint64, QString> mModelQueries;
 public slots:
   void createNewModelicaClass();
   void openModelicaFile();
@@ -405,6 +410,9 @@ public slots:
   void readInterfaceData(LibraryTreeItem *pLibraryTreeItem);
 private slots:
   void perspectiveTabChanged(int tabIndex);
+  void modelInstantiated(OMCFuture future);
+  void modelChecked(OMCFuture future);
+  void allModelsChecked(OMCFuture future);
   void documentationDockWidgetVisibilityChanged(bool visible);
   void autoSave();
   void switchToWelcomePerspectiveSlot();
@@ -412,6 +420,8 @@ private slots:
   void switchToPlottingPerspectiveSlot();
 private:
   void createActions();
+  void startModelQuery(const OMCFuture &future, const QString &className);
+  QString finishModelQuery(const OMCFuture &future);
   void createToolbars();
   void createMenus();
   void autoSaveHelper(LibraryTreeItem *pLibraryTreeItem);
@@ -38,6 +38,12 @@
 #include "LibraryTreeWidget.h"
 #include "VariablesWidget.h"
 #include "SimulationOutputWidget.h"
+#include "BatchMode.h"
+#ifdef WIN32
+#include "version.h"
+#else
+#include "omc_config.h"
+#endif
 
 ItemDelegate::ItemDelegate(QObject *pParent, bool drawRichText, bool drawGrid)
   : QItemDelegate(pParent)
@@ -911,6 +917,11 @@ LibraryTreeModel::LibraryTreeModel(LibraryWidget *pLibraryWidget)
 {
   mpLibraryWidget = pLibraryWidget;
   mpRootLibraryTreeItem = new LibraryTreeItem;
+  // the whole file consistency check after the incremental class text updates is delayed until the user stops editing.
+  mpClassTextConsistencyTimer = new QTimer(this);
+  mpClassTextConsistencyTimer->setSingleShot(true);
+  mpClassTextConsistencyTimer->setInterval(3000);
+  connect(mpClassTextConsistencyTimer, SIGNAL(timeout()), SLOT(checkClassTextConsistency()));
 }
 
 /*!
@@ -1048,7 +1059,8 @@ Qt::ItemFlags LibraryTreeModel::flags(const QModelIndex &index) const
 
 /*!
  * \brief LibraryTreeModel::findLibraryTreeItem
- * Finds the LibraryTreeItem based on the name and case sensitivity.
+ * Finds the LibraryTreeItem based on the name and case sensitivity.\n
+ * Uses the name structure hash so the lookup doesn't depend on the size of the tree.
  * \param name
  * \param root
  * \return
@@ -1061,9 +1073,15 @@ LibraryTreeItem* LibraryTreeModel::findLibraryTreeItem(const QString &name, Libr
   if (root->getNameStructure().compare(name, caseSensitivity) == 0) {
     return root;
   }
-  for (int i = root->getChildren().size(); --i >= 0; ) {
-    if (LibraryTreeItem *item = findLibraryTreeItem(name, root->getChildren().at(i), caseSensitivity)) {
-      return item;
+  QList<LibraryTreeItem*> libraryTreeItems;
+  if (caseSensitivity == Qt::CaseSensitive) {
+    libraryTreeItems = mLibraryTreeItemsHash.values(name);
+  } else {
+    libraryTreeItems = mCaseInsensitiveLibraryTreeItemsHash.values(name.toLower());
+  }
+  foreach (LibraryTreeItem *pLibraryTreeItem, libraryTreeItems) {
+    if (isLibraryTreeItemInSubTree(pLibraryTreeItem, root)) {
+      return pLibraryTreeItem;
     }
   }
   return 0;
@@ -1071,7 +1089,8 @@ LibraryTreeItem* LibraryTreeModel::findLibraryTreeItem(const QString &name, Libr
 
 /*!
  * \brief LibraryTreeModel::findLibraryTreeItem
- * Finds the LibraryTreeItem based on the Regular Expression.
+ * Finds the LibraryTreeItem based on the Regular Expression.\n
+ * Only the name structures starting with the root name structure are matched against the Regular Expression.
  * \param regExp
  * \param root
  * \return
@@ -1084,9 +1103,11 @@ LibraryTreeItem* LibraryTreeModel::findLibraryTreeItem(const QRegExp &regExp, Li
   if (root->getNameStructure().contains(regExp)) {
     return root;
   }
-  for (int i = root->getChildren().size(); --i >= 0; ) {
-    if (LibraryTreeItem *item = findLibraryTreeItem(regExp, root->getChildren().at(i))) {
-      return item;
+  QString prefix = root->isRootItem() ? "" : root->getNameStructure() + ".";
+  QMultiMap<QString, LibraryTreeItem*>::const_iterator iterator = mLibraryTreeItemsPrefixMap.lowerBound(prefix);
+  for (; iterator != mLibraryTreeItemsPrefixMap.constEnd() && iterator.key().startsWith(prefix); ++iterator) {
+    if (iterator.key().contains(regExp) && isLibraryTreeItemInSubTree(iterator.value(), root)) {
+      return iterator.value();
     }
   }
   return 0;
@@ -1117,7 +1138,12 @@ LibraryTreeItem* LibraryTreeModel::findNonExistingLibraryTreeItem(const QString
  */
 QModelIndex LibraryTreeModel::libraryTreeItemIndex(const LibraryTreeItem *pLibraryTreeItem) const
 {
-  return libraryTreeItemIndexHelper(pLibraryTreeItem, mpRootLibraryTreeItem, QModelIndex());
+  LibraryTreeItem *pItem = const_cast<LibraryTreeItem*>(pLibraryTreeItem);
+  // only the items in the index are part of the tree.
+  if (!pItem || pItem == mpRootLibraryTreeItem || !mLibraryTreeItemsHash.contains(pItem->getNameStructure(), pItem)) {
+    return QModelIndex();
+  }
+  return createIndex(pItem->row(), 0, pItem);
 }
 
 /*!
@@ -1153,10 +1179,84 @@ void LibraryTreeModel::addModelicaLibraries(QSplashScreen *pSplashScreen)
 
 /*!
  * \brief LibraryTreeModel::createLibraryTreeItems
- * Creates all the nested Library items.
+ * Creates all the nested Library items.\n
+ * The information of all the nested classes is fetched with one OMC call. The nested items are built before they are
+ * added to the model so the view is notified only once for all the children of pLibraryTreeItem.
  * \param pLibraryTreeItem
  */
 void LibraryTreeModel::createLibraryTreeItems(LibraryTreeItem *pLibraryTreeItem)
+{
+  OMCProxy *pOMCProxy = mpLibraryWidget->getMainWindow()->getOMCProxy();
+  QStringList libs;
+  QList<OMCInterface::getClassInformation_res> classesInformation;
+  if (!pOMCProxy->getClassesInformation(pLibraryTreeItem->getNameStructure(), libs, classesInformation)) {
+    createLibraryTreeItemsOneByOne(pLibraryTreeItem);
+    return;
+  }
+  QHash<QString, LibraryTreeItem*> createdLibraryTreeItems;
+  createdLibraryTreeItems.insert(pLibraryTreeItem->getNameStructure(), pLibraryTreeItem);
+  QList<LibraryTreeItem*> childLibraryTreeItems;
+  QList<LibraryTreeItem*> nonExistingLibraryTreeItems;
+  // skip the first entry since it is pLibraryTreeItem itself.
+  for (int i = 1 ; i < libs.size() ; i++) {
+    const QString &lib = libs.at(i);
+    /* $Code is a special OpenModelica keyword. No API command will work if we use it. */
+    if (lib.contains("$Code")) {
+      continue;
+    }
+    QString name = StringHandler::getLastWordAfterDot(lib);
+    QString parentName = StringHandler::removeLastWordAfterDot(lib);
+    LibraryTreeItem *pParentLibraryTreeItem = createdLibraryTreeItems.value(parentName, 0);
+    if (!pParentLibraryTreeItem) {
+      continue;
+    }
+    bool isSaved = pParentLibraryTreeItem->isSaved();
+    // check if is in non-existing classes.
+    LibraryTreeItem *pChildLibraryTreeItem = findNonExistingLibraryTreeItem(lib);
+    if (pChildLibraryTreeItem && pChildLibraryTreeItem->isNonExisting()) {
+      pChildLibraryTreeItem->setParent(pParentLibraryTreeItem);
+      pChildLibraryTreeItem->setFileName("");
+      pChildLibraryTreeItem->setClassInformation(classesInformation.at(i));
+      pChildLibraryTreeItem->setIsSaved(isSaved);
+      pChildLibraryTreeItem->updateAttributes();
+      pChildLibraryTreeItem->setNonExisting(false);
+      nonExistingLibraryTreeItems.append(pChildLibraryTreeItem);
+    } else {
+      pChildLibraryTreeItem = new LibraryTreeItem(LibraryTreeItem::Modelica, name, lib, classesInformation.at(i), "", isSaved,
+                                                  pParentLibraryTreeItem);
+    }
+    pChildLibraryTreeItem->setSystemLibrary(pParentLibraryTreeItem->isSystemLibrary());
+    createdLibraryTreeItems.insert(lib, pChildLibraryTreeItem);
+    if (pParentLibraryTreeItem == pLibraryTreeItem) {
+      childLibraryTreeItems.append(pChildLibraryTreeItem);
+    } else {
+      // the parent is not part of the model yet so no need to notify the view.
+      pParentLibraryTreeItem->insertChild(pParentLibraryTreeItem->getChildren().size(), pChildLibraryTreeItem);
+    }
+  }
+  if (childLibraryTreeItems.isEmpty()) {
+    return;
+  }
+  int row = pLibraryTreeItem->getChildren().size();
+  beginInsertRows(libraryTreeItemIndex(pLibraryTreeItem), row, row + childLibraryTreeItems.size() - 1);
+  foreach (LibraryTreeItem *pChildLibraryTreeItem, childLibraryTreeItems) {
+    pLibraryTreeItem->insertChild(row++, pChildLibraryTreeItem);
+    addLibraryTreeItemToIndex(pChildLibraryTreeItem);
+  }
+  endInsertRows();
+  // update the items that were referenced before they existed like LibraryTreeModel::createLibraryTreeItem does.
+  foreach (LibraryTreeItem *pNonExistingLibraryTreeItem, nonExistingLibraryTreeItems) {
+    updateLibraryTreeItem(pNonExistingLibraryTreeItem);
+  }
+}
+
+/*!
+ * \brief LibraryTreeModel::createLibraryTreeItemsOneByOne
+ * Creates all the nested Library items by fetching the information of each class separately.
+ * Used when the bulk class information is not available.
+ * \param pLibraryTreeItem
+ */
+void LibraryTreeModel::createLibraryTreeItemsOneByOne(LibraryTreeItem *pLibraryTreeItem)
 {
   OMCProxy *pOMCProxy = mpLibraryWidget->getMainWindow()->getOMCProxy();
   QStringList libs = pOMCProxy->getClassNames(pLibraryTreeItem->getNameStructure(), true, true);
@@ -1217,6 +1317,7 @@ LibraryTreeItem* LibraryTreeModel::createLibraryTreeItem(QString name, LibraryTr
     QModelIndex index = libraryTreeItemIndex(pParentLibraryTreeItem);
     beginInsertRows(index, row, row);
     pParentLibraryTreeItem->insertChild(row, pLibraryTreeItem);
+    addLibraryTreeItemToIndex(pLibraryTreeItem);
     endInsertRows();
     if (load) {
       // create library tree items
@@ -1256,6 +1357,7 @@ LibraryTreeItem* LibraryTreeModel::createLibraryTreeItem(LibraryTreeItem::Librar
   QModelIndex index = libraryTreeItemIndex(mpRootLibraryTreeItem);
   beginInsertRows(index, row, row);
   mpRootLibraryTreeItem->insertChild(row, pLibraryTreeItem);
+  addLibraryTreeItemToIndex(pLibraryTreeItem);
   endInsertRows();
   pMainWindow->getStatusBar()->clearMessage();
   return pLibraryTreeItem;
@@ -1313,6 +1415,7 @@ void LibraryTreeModel::createNonExistingLibraryTreeItem(LibraryTreeItem *pLibrar
   QModelIndex index = libraryTreeItemIndex(pParentLibraryTreeItem);
   beginInsertRows(index, row, row);
   pParentLibraryTreeItem->insertChild(row, pLibraryTreeItem);
+  addLibraryTreeItemToIndex(pLibraryTreeItem);
   endInsertRows();
   pLibraryTreeItem->setNonExisting(false);
 }
@@ -1378,24 +1481,19 @@ void LibraryTreeModel::updateLibraryTreeItemClassText(LibraryTreeItem *pLibraryT
     // we also mark the containing parent class unsaved because it is very important for saving of single file packages.
     pParentLibraryTreeItem->setIsSaved(false);
     updateLibraryTreeItem(pParentLibraryTreeItem);
-    OMCProxy *pOMCProxy = mpLibraryWidget->getMainWindow()->getOMCProxy();
-    QString before = pParentLibraryTreeItem->getClassText(this);
-    QString after = pOMCProxy->listFile(pParentLibraryTreeItem->getNameStructure());
-    QString contents = pOMCProxy->diffModelicaFileListings(before, after);
-    pParentLibraryTreeItem->setClassText(contents);
-    if (pParentLibraryTreeItem->getModelWidget()) {
-      pParentLibraryTreeItem->getModelWidget()->setWindowTitle(QString(pParentLibraryTreeItem->getName()).append("*"));
-      ModelicaEditor *pModelicaEditor = dynamic_cast<ModelicaEditor*>(pParentLibraryTreeItem->getModelWidget()->getEditor());
-      if (pModelicaEditor) {
-        pModelicaEditor->setPlainText(contents);
+    /* For classes nested in a single file package only regenerate the text of the class and splice it into the file.
+     * The whole file is diffed and reloaded later by checkClassTextConsistency().
+     */
+    if (pParentLibraryTreeItem != pLibraryTreeItem && updateLibraryTreeItemClassTextIncrementally(pLibraryTreeItem, pParentLibraryTreeItem)) {
+      if (!mClassTextConsistencyCheckList.contains(pParentLibraryTreeItem)) {
+        mClassTextConsistencyCheckList.append(pParentLibraryTreeItem);
       }
+      mpClassTextConsistencyTimer->start();
+      return;
     }
+    mClassTextConsistencyCheckList.removeOne(pParentLibraryTreeItem);
     // if we first updated the parent class then the child classes needs to be updated as well.
-    if (pParentLibraryTreeItem != pLibraryTreeItem) {
-      pOMCProxy->loadString(pParentLibraryTreeItem->getClassText(this), pParentLibraryTreeItem->getFileName(), Helper::utf8, false, false);
-      updateChildLibraryTreeItemClassText(pParentLibraryTreeItem, contents, pParentLibraryTreeItem->getFileName());
-      pParentLibraryTreeItem->setClassInformation(pOMCProxy->getClassInformation(pParentLibraryTreeItem->getNameStructure()));
-    }
+    updateContainingFileClassText(pParentLibraryTreeItem, pParentLibraryTreeItem != pLibraryTreeItem);
   }
 }
 
@@ -1415,6 +1513,8 @@ void LibraryTreeModel::updateLibraryTreeItemClassTextManually(LibraryTreeItem *p
   // we also mark the containing parent class unsaved because it is very important for saving of single file packages.
   pParentLibraryTreeItem->setIsSaved(false);
   updateLibraryTreeItem(pParentLibraryTreeItem);
+  // the text is reloaded below so no consistency check is needed.
+  mClassTextConsistencyCheckList.removeOne(pParentLibraryTreeItem);
   OMCProxy *pOMCProxy = mpLibraryWidget->getMainWindow()->getOMCProxy();
   pParentLibraryTreeItem->setClassText(contents);
   if (pParentLibraryTreeItem->getModelWidget()) {
@@ -1491,6 +1591,11 @@ LibraryTreeItem* LibraryTreeModel::getContainingFileParentLibraryTreeItem(Librar
  */
 void LibraryTreeModel::loadLibraryTreeItemPixmap(LibraryTreeItem *pLibraryTreeItem)
 {
+  QString cacheKey = getLibraryTreeItemPixmapCacheKey(pLibraryTreeItem);
+  // only build the ModelWidget if the icon is not in the cache.
+  if (!pLibraryTreeItem->getModelWidget() && readLibraryTreeItemPixmapFromCache(pLibraryTreeItem, cacheKey)) {
+    return;
+  }
   if (!pLibraryTreeItem->getModelWidget()) {
     showModelWidget(pLibraryTreeItem, "", false);
   }
@@ -1539,6 +1644,96 @@ void LibraryTreeModel::loadLibraryTreeItemPixmap(LibraryTreeItem *pLibraryTreeIt
     pLibraryTreeItem->setPixmap(QPixmap());
     pLibraryTreeItem->setDragPixmap(QPixmap());
   }
+  writeLibraryTreeItemPixmapToCache(pLibraryTreeItem, cacheKey);
+}
+
+/*!
+ * \brief LibraryTreeModel::getLibraryTreeItemPixmapCacheKey
+ * Returns the key of the LibraryTreeItem pixmaps in the icon cache.\n
+ * The key is made from the class name, the size and modification time of its file, the OMEdit version and the library icon size.
+ * Only the classes of system libraries and read-only files are cached since the icon can also depend on the classes in other files.
+ * \param pLibraryTreeItem
+ * \return the key or an empty string if the LibraryTreeItem pixmaps should not be cached.
+ */
+QString LibraryTreeModel::getLibraryTreeItemPixmapCacheKey(LibraryTreeItem *pLibraryTreeItem)
+{
+  if (pLibraryTreeItem->getLibraryType() != LibraryTreeItem::Modelica || !pLibraryTreeItem->isSaved() || !pLibraryTreeItem->isFilePathValid()
+      || !(pLibraryTreeItem->isSystemLibrary() || pLibraryTreeItem->isReadOnly())) {
+    return "";
+  }
+  QFileInfo fileInfo(pLibraryTreeItem->getFileName());
+  int libraryIconSize = mpLibraryWidget->getMainWindow()->getOptionsDialog()->getGeneralSettingsPage()->getLibraryIconSizeSpinBox()->value();
+  QString key = QString("%1|%2|%3|%4|%5|%6").arg(pLibraryTreeItem->getNameStructure()).arg(fileInfo.absoluteFilePath())
+      .arg(fileInfo.size()).arg(fileInfo.lastModified().toTime_t()).arg(GIT_SHA).arg(libraryIconSize);
+  return QString(QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha1).toHex());
+}
+
+/*!
+ * \brief LibraryTreeModel::getLibraryTreeItemPixmapCacheDirectory
+ * Returns the directory of the icon cache. It is next to the settings file so it survives restarts.
+ * \return
+ */
+QString LibraryTreeModel::getLibraryTreeItemPixmapCacheDirectory()
+{
+  static QString cacheDirectory;
+  if (cacheDirectory.isEmpty()) {
+    cacheDirectory = QFileInfo(OpenModelica::getApplicationSettings()->fileName()).absolutePath() + "/iconcache/";
+    if (!QDir().exists(cacheDirectory)) {
+      QDir().mkpath(cacheDirectory);
+    }
+  }
+  return cacheDirectory;
+}
+
+/*!
+ * \brief LibraryTreeModel::readLibraryTreeItemPixmapFromCache
+ * Reads the library and drag pixmaps of the LibraryTreeItem from the icon cache.
+ * \param pLibraryTreeItem
+ * \param cacheKey
+ * \return true if the pixmaps are found in the cache.
+ */
+bool LibraryTreeModel::readLibraryTreeItemPixmapFromCache(LibraryTreeItem *pLibraryTreeItem, const QString &cacheKey)
+{
+  if (cacheKey.isEmpty()) {
+    return false;
+  }
+  QString fileName = getLibraryTreeItemPixmapCacheDirectory() + cacheKey;
+  // the class has no icon annotation.
+  if (QFile::exists(fileName + ".none")) {
+    pLibraryTreeItem->setPixmap(QPixmap());
+    pLibraryTreeItem->setDragPixmap(QPixmap());
+    return true;
+  }
+  QPixmap libraryPixmap, dragPixmap;
+  if (!libraryPixmap.load(fileName + ".png", "PNG") || !dragPixmap.load(fileName + "-drag.png", "PNG")) {
+    return false;
+  }
+  pLibraryTreeItem->setPixmap(libraryPixmap);
+  pLibraryTreeItem->setDragPixmap(dragPixmap);
+  return true;
+}
+
+/*!
+ * \brief LibraryTreeModel::writeLibraryTreeItemPixmapToCache
+ * Writes the library and drag pixmaps of the LibraryTreeItem to the icon cache.
+ * \param pLibraryTreeItem
+ * \param cacheKey
+ */
+void LibraryTreeModel::writeLibraryTreeItemPixmapToCache(LibraryTreeItem *pLibraryTreeItem, const QString &cacheKey)
+{
+  if (cacheKey.isEmpty()) {
+    return;
+  }
+  QString fileName = getLibraryTreeItemPixmapCacheDirectory() + cacheKey;
+  if (pLibraryTreeItem->getPixmap().isNull()) {
+    QFile file(fileName + ".none");
+    if (file.open(QIODevice::WriteOnly)) {
+      file.close();
+    }
+  } else {
+    pLibraryTreeItem->getPixmap().save(fileName + ".png", "PNG");
+    pLibraryTreeItem->getDragPixmap().save(fileName + "-drag.png", "PNG");
+  }
 }
 
 /*!
@@ -1730,6 +1925,7 @@ bool LibraryTreeModel::unloadMetaModelOrTextFile(LibraryTreeItem *pLibraryTreeIt
   // remove the LibraryTreeItem from Libraries Browser
   int row = pLibraryTreeItem->row();
   beginRemoveRows(libraryTreeItemIndex(pLibraryTreeItem), row, row);
+  removeLibraryTreeItemFromIndex(pLibraryTreeItem);
   mpRootLibraryTreeItem->removeChild(pLibraryTreeItem);
   delete pLibraryTreeItem;
   endRemoveRows();
@@ -1779,6 +1975,7 @@ bool LibraryTreeModel::unloadLibraryTreeItem(LibraryTreeItem *pLibraryTreeItem,
     // remove the LibraryTreeItem from Libraries Browser
     row = pLibraryTreeItem->row();
     beginRemoveRows(libraryTreeItemIndex(pLibraryTreeItem), row, row);
+    removeLibraryTreeItemFromIndex(pLibraryTreeItem);
     pLibraryTreeItem->parent()->removeChild(pLibraryTreeItem);
     endRemoveRows();
     if (pNextLibraryTreeItem) {
@@ -1964,28 +2161,67 @@ QString LibraryTreeModel::getUniqueTopLevelItemName(QString name, int number)
 }
 
 /*!
- * \brief LibraryTreeModel::libraryTreeItemIndexHelper
- * Helper function for LibraryTreeModel::libraryTreeItemIndex()
+ * \brief LibraryTreeModel::addLibraryTreeItemToIndex
+ * Adds the LibraryTreeItem and its children to the name structure hashes.\n
+ * Must be called whenever a LibraryTreeItem becomes part of the tree.
  * \param pLibraryTreeItem
- * \param pParentLibraryTreeItem
- * \param parentIndex
+ */
+void LibraryTreeModel::addLibraryTreeItemToIndex(LibraryTreeItem *pLibraryTreeItem)
+{
+  const QString &nameStructure = pLibraryTreeItem->getNameStructure();
+  if (!mLibraryTreeItemsHash.contains(nameStructure, pLibraryTreeItem)) {
+    mLibraryTreeItemsHash.insert(nameStructure, pLibraryTreeItem);
+    mCaseInsensitiveLibraryTreeItemsHash.insert(nameStructure.toLower(), pLibraryTreeItem);
+    mLibraryTreeItemsPrefixMap.insert(nameStructure, pLibraryTreeItem);
+  }
+  for (int i = 0; i < pLibraryTreeItem->getChildren().size(); i++) {
+    addLibraryTreeItemToIndex(pLibraryTreeItem->child(i));
+  }
+}
+
+/*!
+ * \brief LibraryTreeModel::removeLibraryTreeItemFromIndex
+ * Removes the LibraryTreeItem and its children from the name structure hashes.\n
+ * Must be called whenever a LibraryTreeItem is removed from the tree.
+ * \param pLibraryTreeItem
+ */
+void LibraryTreeModel::removeLibraryTreeItemFromIndex(LibraryTreeItem *pLibraryTreeItem)
+{
+  const QString &nameStructure = pLibraryTreeItem->getNameStructure();
+  mLibraryTreeItemsHash.remove(nameStructure, pLibraryTreeItem);
+  mCaseInsensitiveLibraryTreeItemsHash.remove(nameStructure.toLower(), pLibraryTreeItem);
+  mLibraryTreeItemsPrefixMap.remove(nameStructure, pLibraryTreeItem);
+  mClassTextConsistencyCheckList.removeOne(pLibraryTreeItem);
+  QMutableHashIterator<quint64, QPair<LibraryTreeItem*, QString> > checksIterator(mPendingClassTextConsistencyChecks);
+  while (checksIterator.hasNext()) {
+    if (checksIterator.next().value().first == pLibraryTreeItem) {
+      checksIterator.remove();
+    }
+  }
+  for (int i = 0; i < pLibraryTreeItem->getChildren().size(); i++) {
+    removeLibraryTreeItemFromIndex(pLibraryTreeItem->child(i));
+  }
+}
+
+/*!
+ * \brief LibraryTreeModel::isLibraryTreeItemInSubTree
+ * Returns true if pRootLibraryTreeItem is pLibraryTreeItem or one of its ancestors.
+ * \param pLibraryTreeItem
+ * \param pRootLibraryTreeItem
  * \return
  */
-QModelIndex LibraryTreeModel::libraryTreeItemIndexHelper(const LibraryTreeItem *pLibraryTreeItem,
-                                                         const LibraryTreeItem *pParentLibraryTreeItem, const QModelIndex &parentIndex) const
+bool LibraryTreeModel::isLibraryTreeItemInSubTree(LibraryTreeItem *pLibraryTreeItem, LibraryTreeItem *pRootLibraryTreeItem) const
 {
-  if (pLibraryTreeItem == pParentLibraryTreeItem) {
-    return parentIndex;
+  if (pRootLibraryTreeItem == mpRootLibraryTreeItem) {
+    return true;
   }
-  for (int i = pParentLibraryTreeItem->getChildren().size(); --i >= 0; ) {
-    const LibraryTreeItem *childItem = pParentLibraryTreeItem->getChildren().at(i);
-    QModelIndex childIndex = index(i, 0, parentIndex);
-    QModelIndex index = libraryTreeItemIndexHelper(pLibraryTreeItem, childItem, childIndex);
-    if (index.isValid()) {
-      return index;
+  while (pLibraryTreeItem) {
+    if (pLibraryTreeItem == pRootLibraryTreeItem) {
+      return true;
     }
+    pLibraryTreeItem = pLibraryTreeItem->parent();
   }
-  return QModelIndex();
+  return false;
 }
 
 /*!
@@ -2044,6 +2280,244 @@ void LibraryTreeModel::updateChildLibraryTreeItemClassText(LibraryTreeItem *pLib
   }
 }
 
+/*!
+ * \brief LibraryTreeModel::updateContainingFileClassText
+ * Regenerates the text of the whole file from OMC and keeps the user formatting by diffing it with the current text.
+ * \param pParentLibraryTreeItem - the top most LibraryTreeItem of the file.
+ * \param updateChildren - if true then the text is reloaded in OMC and the nested classes are updated.
+ */
+void LibraryTreeModel::updateContainingFileClassText(LibraryTreeItem *pParentLibraryTreeItem, bool updateChildren)
+{
+  OMCProxy *pOMCProxy = mpLibraryWidget->getMainWindow()->getOMCProxy();
+  QString before = pParentLibraryTreeItem->getClassText(this);
+  QString after = pOMCProxy->listFile(pParentLibraryTreeItem->getNameStructure());
+  QString contents = pOMCProxy->diffModelicaFileListings(before, after);
+  pParentLibraryTreeItem->setClassText(contents);
+  if (pParentLibraryTreeItem->getModelWidget()) {
+    pParentLibraryTreeItem->getModelWidget()->setWindowTitle(QString(pParentLibraryTreeItem->getName()).append("*"));
+    ModelicaEditor *pModelicaEditor = dynamic_cast<ModelicaEditor*>(pParentLibraryTreeItem->getModelWidget()->getEditor());
+    if (pModelicaEditor) {
+      pModelicaEditor->setPlainText(contents);
+    }
+  }
+  if (updateChildren) {
+    pOMCProxy->loadString(pParentLibraryTreeItem->getClassText(this), pParentLibraryTreeItem->getFileName(), Helper::utf8, false, false);
+    updateChildLibraryTreeItemClassText(pParentLibraryTreeItem, contents, pParentLibraryTreeItem->getFileName());
+    pParentLibraryTreeItem->setClassInformation(pOMCProxy->getClassInformation(pParentLibraryTreeItem->getNameStructure()));
+  }
+}
+
+/*!
+ * \brief LibraryTreeModel::updateLibraryTreeItemClassTextIncrementally
+ * Regenerates only the text of a class nested in a single file package and splices it into the text of the file.\n
+ * The line numbers of the classes after the edited class are shifted locally. OMC is not asked to reload the file.
+ * \param pLibraryTreeItem - the edited class.
+ * \param pParentLibraryTreeItem - the top most LibraryTreeItem of the file.
+ * \return false if the class text can't be updated incrementally.
+ */
+bool LibraryTreeModel::updateLibraryTreeItemClassTextIncrementally(LibraryTreeItem *pLibraryTreeItem, LibraryTreeItem *pParentLibraryTreeItem)
+{
+  const QString &fileName = pParentLibraryTreeItem->getFileName();
+  int lineNumberStart = pLibraryTreeItem->mClassInformation.lineNumberStart;
+  int lineNumberEnd = pLibraryTreeItem->mClassInformation.lineNumberEnd;
+  // we need a valid line range of the class.
+  if (!pLibraryTreeItem->isFilePathValid() || lineNumberStart <= 0 || lineNumberEnd < lineNumberStart) {
+    return false;
+  }
+  // the line numbers of the nested classes can't be known without reloading the file.
+  for (int i = 0; i < pLibraryTreeItem->getChildren().size(); i++) {
+    if (pLibraryTreeItem->child(i)->getFileName().compare(fileName) == 0) {
+      return false;
+    }
+  }
+  QString fileContents = pParentLibraryTreeItem->getClassText(this);
+  if (lineNumberEnd > fileContents.count('\n') + 1) {
+    return false;
+  }
+  readLibraryTreeItemClassTextFromText(pLibraryTreeItem, fileContents);
+  QString before = pLibraryTreeItem->getClassText(this);
+  if (before.isEmpty()) {
+    return false;
+  }
+  OMCProxy *pOMCProxy = mpLibraryWidget->getMainWindow()->getOMCProxy();
+  QString after = pOMCProxy->listFile(pLibraryTreeItem->getNameStructure());
+  // the listing of a nested class starts with the within clause.
+  if (after.startsWith("within ")) {
+    after.remove(0, after.indexOf('\n') + 1);
+  }
+  QString contents = pOMCProxy->diffModelicaFileListings(before, after);
+  if (contents.isEmpty()) {
+    return false;
+  }
+  if (!contents.endsWith('\n')) {
+    contents.append('\n');
+  }
+  fileContents = pLibraryTreeItem->getClassTextBefore() + contents + pLibraryTreeItem->getClassTextAfter();
+  pParentLibraryTreeItem->setClassText(fileContents);
+  if (pParentLibraryTreeItem->getModelWidget()) {
+    pParentLibraryTreeItem->getModelWidget()->setWindowTitle(QString(pParentLibraryTreeItem->getName()).append("*"));
+    ModelicaEditor *pModelicaEditor = dynamic_cast<ModelicaEditor*>(pParentLibraryTreeItem->getModelWidget()->getEditor());
+    if (pModelicaEditor) {
+      pModelicaEditor->setPlainText(fileContents);
+    }
+  }
+  shiftLibraryTreeItemsLineNumbers(pParentLibraryTreeItem, fileName, lineNumberEnd, contents.count('\n') - before.count('\n'));
+  refreshChildLibraryTreeItemClassText(pParentLibraryTreeItem, fileContents, fileName);
+  return true;
+}
+
+/*!
+ * \brief LibraryTreeModel::shiftLibraryTreeItemsLineNumbers
+ * Moves the line numbers of the classes in the file after the text of a class ending at lineNumber has changed its size.
+ * \param pLibraryTreeItem
+ * \param fileName
+ * \param lineNumber - the old end line of the changed class.
+ * \param difference - the number of added lines. Negative if lines are removed.
+ */
+void LibraryTreeModel::shiftLibraryTreeItemsLineNumbers(LibraryTreeItem *pLibraryTreeItem, QString fileName, int lineNumber, int difference)
+{
+  if (difference == 0) {
+    return;
+  }
+  if (pLibraryTreeItem->mClassInformation.lineNumberStart > lineNumber) {
+    pLibraryTreeItem->mClassInformation.lineNumberStart += difference;
+    pLibraryTreeItem->mClassInformation.lineNumberEnd += difference;
+  } else if (pLibraryTreeItem->mClassInformation.lineNumberEnd >= lineNumber) {
+    // the changed class or a class containing it.
+    pLibraryTreeItem->mClassInformation.lineNumberEnd += difference;
+  }
+  for (int i = 0; i < pLibraryTreeItem->getChildren().size(); i++) {
+    LibraryTreeItem *pChildLibraryTreeItem = pLibraryTreeItem->child(i);
+    if (pChildLibraryTreeItem && pChildLibraryTreeItem->getFileName().compare(fileName) == 0) {
+      shiftLibraryTreeItemsLineNumbers(pChildLibraryTreeItem, fileName, lineNumber, difference);
+    }
+  }
+}
+
+/*!
+ * \brief LibraryTreeModel::refreshChildLibraryTreeItemClassText
+ * Updates the text of the nested classes from the text of the file without asking OMC.\n
+ * The classes without a ModelWidget only drop their text. It is read again from the file text when needed.
+ * \param pLibraryTreeItem
+ * \param contents
+ * \param fileName
+ */
+void LibraryTreeModel::refreshChildLibraryTreeItemClassText(LibraryTreeItem *pLibraryTreeItem, QString contents, QString fileName)
+{
+  for (int i = 0; i < pLibraryTreeItem->getChildren().size(); i++) {
+    LibraryTreeItem *pChildLibraryTreeItem = pLibraryTreeItem->child(i);
+    if (pChildLibraryTreeItem && pChildLibraryTreeItem->getFileName().compare(fileName) == 0) {
+      if (pChildLibraryTreeItem->getModelWidget()) {
+        QString classText = pChildLibraryTreeItem->getClassText(this);
+        readLibraryTreeItemClassTextFromText(pChildLibraryTreeItem, contents);
+        ModelicaEditor *pModelicaEditor = dynamic_cast<ModelicaEditor*>(pChildLibraryTreeItem->getModelWidget()->getEditor());
+        if (pModelicaEditor) {
+          if (classText.compare(pChildLibraryTreeItem->getClassText(this)) != 0) {
+            pModelicaEditor->setPlainText(pChildLibraryTreeItem->getClassText(this));
+          }
+          if (pModelicaEditor->isVisible()) {
+            pModelicaEditor->getPlainTextEdit()->getLineNumberArea()->update();
+          }
+        }
+      } else {
+        pChildLibraryTreeItem->setClassText("");
+      }
+      if (pChildLibraryTreeItem->getChildren().size() > 0) {
+        refreshChildLibraryTreeItemClassText(pChildLibraryTreeItem, contents, fileName);
+      }
+    }
+  }
+}
+
+/*!
+ * \brief LibraryTreeModel::hasUnappliedTextChanges
+ * Returns true if the text of any class of the file is changed in its editor and is not yet loaded in OMC.
+ * \param pLibraryTreeItem
+ * \param fileName
+ * \return
+ */
+bool LibraryTreeModel::hasUnappliedTextChanges(LibraryTreeItem *pLibraryTreeItem, QString fileName)
+{
+  if (pLibraryTreeItem->getModelWidget()) {
+    ModelicaEditor *pModelicaEditor = dynamic_cast<ModelicaEditor*>(pLibraryTreeItem->getModelWidget()->getEditor());
+    if (pModelicaEditor && pModelicaEditor->isTextChanged()) {
+      return true;
+    }
+  }
+  for (int i = 0; i < pLibraryTreeItem->getChildren().size(); i++) {
+    LibraryTreeItem *pChildLibraryTreeItem = pLibraryTreeItem->child(i);
+    if (pChildLibraryTreeItem && pChildLibraryTreeItem->getFileName().compare(fileName) == 0
+        && hasUnappliedTextChanges(pChildLibraryTreeItem, fileName)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/*!
+ * \brief LibraryTreeModel::checkClassTextConsistency
+ * Slot activated when mpClassTextConsistencyTimer timeout SIGNAL is raised.\n
+ * Queues the regeneration and reload of the whole text of the files that were updated incrementally on the OMCWorkerThread.
+ * \sa LibraryTreeModel::updateLibraryTreeItemClassTextIncrementally()
+ * \sa LibraryTreeModel::classTextConsistencyChecked()
+ */
+void LibraryTreeModel::checkClassTextConsistency()
+{
+  OMCProxy *pOMCProxy = mpLibraryWidget->getMainWindow()->getOMCProxy();
+  while (!mClassTextConsistencyCheckList.isEmpty()) {
+    LibraryTreeItem *pParentLibraryTreeItem = mClassTextConsistencyCheckList.first();
+    // don't overwrite the text that the user is typing. Try again later.
+    if (hasUnappliedTextChanges(pParentLibraryTreeItem, pParentLibraryTreeItem->getFileName())) {
+      mpClassTextConsistencyTimer->start();
+      return;
+    }
+    mClassTextConsistencyCheckList.removeFirst();
+    QString before = pParentLibraryTreeItem->getClassText(this);
+    OMCFuture future = pOMCProxy->reloadFileTextAsync(pParentLibraryTreeItem->getNameStructure(), before, pParentLibraryTreeItem->getFileName(),
+                                                      this, SLOT(classTextConsistencyChecked(OMCFuture)));
+    mPendingClassTextConsistencyChecks.insert(future.getId(), qMakePair(pParentLibraryTreeItem, before));
+  }
+}
+
+/*!
+ * \brief LibraryTreeModel::classTextConsistencyChecked
+ * Slot activated when the command queued by LibraryTreeModel::checkClassTextConsistency() is finished.\n
+ * Applies the regenerated text to the file and its nested classes.
+ * The result is dropped if the file text is changed meanwhile and the file is checked again.
+ * \param future
+ */
+void LibraryTreeModel::classTextConsistencyChecked(OMCFuture future)
+{
+  if (!mPendingClassTextConsistencyChecks.contains(future.getId())) {
+    return; // the class is unloaded meanwhile.
+  }
+  QPair<LibraryTreeItem*, QString> check = mPendingClassTextConsistencyChecks.take(future.getId());
+  LibraryTreeItem *pParentLibraryTreeItem = check.first;
+  OMCProxy *pOMCProxy = mpLibraryWidget->getMainWindow()->getOMCProxy();
+  QString contents = pOMCProxy->getReloadFileTextResult(future, check.second);
+  if (contents.isEmpty()) {
+    return;
+  }
+  if (pParentLibraryTreeItem->getClassText(this).compare(check.second) != 0
+      || hasUnappliedTextChanges(pParentLibraryTreeItem, pParentLibraryTreeItem->getFileName())) {
+    if (!mClassTextConsistencyCheckList.contains(pParentLibraryTreeItem)) {
+      mClassTextConsistencyCheckList.append(pParentLibraryTreeItem);
+    }
+    mpClassTextConsistencyTimer->start();
+    return;
+  }
+  pParentLibraryTreeItem->setClassText(contents);
+  if (pParentLibraryTreeItem->getModelWidget()) {
+    pParentLibraryTreeItem->getModelWidget()->setWindowTitle(QString(pParentLibraryTreeItem->getName()).append("*"));
+    ModelicaEditor *pModelicaEditor = dynamic_cast<ModelicaEditor*>(pParentLibraryTreeItem->getModelWidget()->getEditor());
+    if (pModelicaEditor) {
+      pModelicaEditor->setPlainText(contents);
+    }
+  }
+  updateChildLibraryTreeItemClassText(pParentLibraryTreeItem, contents, pParentLibraryTreeItem->getFileName());
+  pParentLibraryTreeItem->setClassInformation(pOMCProxy->getClassInformation(pParentLibraryTreeItem->getNameStructure()));
+}
+
 /*!
  * \brief LibraryTreeModel::readLibraryTreeItemClassTextFromText
  * Reads the contents of the Modelica class nested in another class.
@@ -2122,6 +2596,7 @@ void LibraryTreeModel::unloadClassHelper(LibraryTreeItem *pLibraryTreeItem, Libr
   // remove the LibraryTreeItem from Libraries Browser
   int row = pLibraryTreeItem->row();
   beginRemoveRows(libraryTreeItemIndex(pLibraryTreeItem), row, row);
+  removeLibraryTreeItemFromIndex(pLibraryTreeItem);
   pParentLibraryTreeItem->removeChild(pLibraryTreeItem);
   endRemoveRows();
 }
@@ -2889,15 +3364,15 @@ LibraryWidget::LibraryWidget(MainWindow *pMainWindow)
  * \param encoding
  * \param showProgress
  * \param checkFileExists
+ * \return true if the file is loaded.
  */
-void LibraryWidget::openFile(QString fileName, QString encoding, bool showProgress, bool checkFileExists)
+bool LibraryWidget::openFile(QString fileName, QString encoding, bool showProgress, bool checkFileExists)
 {
   /* if the file doesn't exist then remove it from the recent files list. */
   QFileInfo fileInfo(fileName);
   if (checkFileExists) {
     if (!fileInfo.exists()) {
-      QMessageBox::information(mpMainWindow, QString(Helper::applicationName).append(" - ").append(Helper::information),
-                               GUIMessages::getMessage(GUIMessages::FILE_NOT_FOUND).arg(fileName), Helper::ok);
+      showLoadError(QMessageBox::Information, GUIMessages::getMessage(GUIMessages::FILE_NOT_FOUND).arg(fileName));
       QSettings *pSettings = OpenModelica::getApplicationSettings();
       QList<QVariant> files = pSettings->value("recentFilesList/files").toList();
       // remove the RecentFile instance from the list.
@@ -2909,13 +3384,13 @@ void LibraryWidget::openFile(QString fileName, QString encoding, bool showProgre
       }
       pSettings->setValue("recentFilesList/files", files);
       mpMainWindow->updateRecentFileActions();
-      return;
+      return false;
     }
   }
   if (fileInfo.suffix().compare("mo") == 0) {
-    openModelicaFile(fileName, encoding, showProgress);
+    return openModelicaFile(fileName, encoding, showProgress);
   } else {
-    openMetaModelOrTextFile(fileInfo, showProgress);
+    return openMetaModelOrTextFile(fileInfo, showProgress);
   }
 }
 
@@ -2925,9 +3400,11 @@ void LibraryWidget::openFile(QString fileName, QString encoding, bool showProgre
  * \param fileName
  * \param encoding
  * \param showProgress
+ * \return true if the file is loaded.
  */
-void LibraryWidget::openModelicaFile(QString fileName, QString encoding, bool showProgress)
+bool LibraryWidget::openModelicaFile(QString fileName, QString encoding, bool showProgress)
 {
+  bool success = false;
   // get the class names now to check if they are already loaded or not
   QStringList existingmodelsList;
   if (showProgress) mpMainWindow->getStatusBar()->showMessage(QString(Helper::loading).append(": ").append(fileName));
@@ -2940,16 +3417,10 @@ void LibraryWidget::openModelicaFile(QString fileName, QString encoding, bool sh
        matching the name of the nonstructured entity."
       */
     if (classesList.size() > 1) {
-      QMessageBox *pMessageBox = new QMessageBox(mpMainWindow);
-      pMessageBox->setWindowTitle(QString(Helper::applicationName).append(" - ").append(Helper::error));
-      pMessageBox->setIcon(QMessageBox::Critical);
-      pMessageBox->setAttribute(Qt::WA_DeleteOnClose);
-      pMessageBox->setText(QString(GUIMessages::getMessage(GUIMessages::UNABLE_TO_LOAD_FILE).arg(fileName)));
-      pMessageBox->setInformativeText(QString(GUIMessages::getMessage(GUIMessages::MULTIPLE_TOP_LEVEL_CLASSES)).arg(fileName)
-                                      .arg(classesList.join(",")));
-      pMessageBox->setStandardButtons(QMessageBox::Ok);
-      pMessageBox->exec();
-      return;
+      showLoadError(QMessageBox::Critical, GUIMessages::getMessage(GUIMessages::UNABLE_TO_LOAD_FILE).arg(fileName),
+                    GUIMessages::getMessage(GUIMessages::MULTIPLE_TOP_LEVEL_CLASSES).arg(fileName).arg(classesList.join(",")));
+      if (showProgress) mpMainWindow->getStatusBar()->clearMessage();
+      return false;
     }
     bool existModel = false;
     // check if the model already exists
@@ -2961,16 +3432,10 @@ void LibraryWidget::openModelicaFile(QString fileName, QString encoding, bool sh
     }
     // if existModel is true, show user an error message
     if (existModel) {
-      QMessageBox *pMessageBox = new QMessageBox(mpMainWindow);
-      pMessageBox->setWindowTitle(QString(Helper::applicationName).append(" - ").append(Helper::information));
-      pMessageBox->setIcon(QMessageBox::Information);
-      pMessageBox->setAttribute(Qt::WA_DeleteOnClose);
-      pMessageBox->setText(QString(GUIMessages::getMessage(GUIMessages::UNABLE_TO_LOAD_FILE).arg(fileName)));
-      pMessageBox->setInformativeText(QString(GUIMessages::getMessage(GUIMessages::REDEFINING_EXISTING_CLASSES))
-                                      .arg(existingmodelsList.join(",")).append("\n")
-                                      .append(GUIMessages::getMessage(GUIMessages::DELETE_AND_LOAD).arg(fileName)));
-      pMessageBox->setStandardButtons(QMessageBox::Ok);
-      pMessageBox->exec();
+      showLoadError(QMessageBox::Information, GUIMessages::getMessage(GUIMessages::UNABLE_TO_LOAD_FILE).arg(fileName),
+                    QString(GUIMessages::getMessage(GUIMessages::REDEFINING_EXISTING_CLASSES))
+                    .arg(existingmodelsList.join(",")).append("\n")
+                    .append(GUIMessages::getMessage(GUIMessages::DELETE_AND_LOAD).arg(fileName)));
     } else { // if no conflicting model found then just load the file simply
       // load the file in OMC
       if (mpMainWindow->getOMCProxy()->loadFile(fileName, encoding)) {
@@ -2988,10 +3453,12 @@ void LibraryWidget::openModelicaFile(QString fileName, QString encoding, bool sh
         mpMainWindow->addRecentFile(fileName, encoding);
         mpLibraryTreeModel->loadDependentLibraries(mpMainWindow->getOMCProxy()->getClassNames());
         if (showProgress) mpMainWindow->hideProgressBar();
+        success = true;
       }
     }
   }
   if (showProgress) mpMainWindow->getStatusBar()->clearMessage();
+  return success;
 }
 
 /*!
@@ -2999,25 +3466,21 @@ void LibraryWidget::openModelicaFile(QString fileName, QString encoding, bool sh
  * Opens a MetaModel/Text file and creates a LibraryTreeItem for it.
  * \param fileInfo
  * \param showProgress
+ * \return true if the file is loaded.
  */
-void LibraryWidget::openMetaModelOrTextFile(QFileInfo fileInfo, bool showProgress)
+bool LibraryWidget::openMetaModelOrTextFile(QFileInfo fileInfo, bool showProgress)
 {
   if (showProgress) mpMainWindow->getStatusBar()->showMessage(QString(Helper::loading).append(": ").append(fileInfo.absoluteFilePath()));
   // check if the file is already loaded.
   for (int i = 0; i < mpLibraryTreeModel->getRootLibraryTreeItem()->getChildren().size(); ++i) {
     LibraryTreeItem *pLibraryTreeItem = mpLibraryTreeModel->getRootLibraryTreeItem()->child(i);
     if (pLibraryTreeItem && pLibraryTreeItem->getFileName().compare(fileInfo.absoluteFilePath()) == 0) {
-      QMessageBox *pMessageBox = new QMessageBox(mpMainWindow);
-      pMessageBox->setWindowTitle(QString(Helper::applicationName).append(" - ").append(Helper::information));
-      pMessageBox->setIcon(QMessageBox::Information);
-      pMessageBox->setAttribute(Qt::WA_DeleteOnClose);
-      pMessageBox->setText(QString(GUIMessages::getMessage(GUIMessages::UNABLE_TO_LOAD_FILE).arg(fileInfo.absoluteFilePath())));
-      pMessageBox->setInformativeText(QString(GUIMessages::getMessage(GUIMessages::REDEFINING_EXISTING_CLASSES))
-                                      .arg(fileInfo.fileName()).append("\n")
-                                      .append(GUIMessages::getMessage(GUIMessages::DELETE_AND_LOAD).arg(fileInfo.absoluteFilePath())));
-      pMessageBox->setStandardButtons(QMessageBox::Ok);
-      pMessageBox->exec();
-      return;
+      showLoadError(QMessageBox::Information, GUIMessages::getMessage(GUIMessages::UNABLE_TO_LOAD_FILE).arg(fileInfo.absoluteFilePath()),
+                    QString(GUIMessages::getMessage(GUIMessages::REDEFINING_EXISTING_CLASSES))
+                    .arg(fileInfo.fileName()).append("\n")
+                    .append(GUIMessages::getMessage(GUIMessages::DELETE_AND_LOAD).arg(fileInfo.absoluteFilePath())));
+      if (showProgress) mpMainWindow->getStatusBar()->clearMessage();
+      return false;
     }
   }
   // create a LibraryTreeItem for new loaded file.
@@ -3037,6 +3500,7 @@ void LibraryWidget::openMetaModelOrTextFile(QFileInfo fileInfo, bool showProgres
     mpMainWindow->addRecentFile(fileInfo.absoluteFilePath(), Helper::utf8);
   }
   if (showProgress) mpMainWindow->getStatusBar()->clearMessage();
+  return pLibraryTreeItem != 0;
 }
 
 /*!
@@ -3050,9 +3514,8 @@ bool LibraryWidget::parseMetaModelFile(QFileInfo fileInfo)
   QString contents = "";
   QFile file(fileInfo.absoluteFilePath());
   if (!file.open(QIODevice::ReadOnly)) {
-    QMessageBox::critical(mpMainWindow, QString(Helper::applicationName).append(" - ").append(Helper::error),
-                          GUIMessages::getMessage(GUIMessages::ERROR_OPENING_FILE).arg(fileInfo.absoluteFilePath()).arg(file.errorString()),
-                          Helper::ok);
+    showLoadError(QMessageBox::Critical,
+                  GUIMessages::getMessage(GUIMessages::ERROR_OPENING_FILE).arg(fileInfo.absoluteFilePath()).arg(file.errorString()));
     return false;
   } else {
     contents = QString(file.readAll());
@@ -3076,6 +3539,31 @@ bool LibraryWidget::parseMetaModelFile(QFileInfo fileInfo)
   }
 }
 
+/*!
+ * \brief LibraryWidget::showLoadError
+ * Tells the user why a file is not loaded.\n
+ * In batch mode the message is printed to stderr since there is nobody to close a message box.
+ * \param icon
+ * \param text
+ * \param informativeText
+ */
+void LibraryWidget::showLoadError(QMessageBox::Icon icon, QString text, QString informativeText)
+{
+  if (mpMainWindow->isBatch()) {
+    BatchMode::printError(informativeText.isEmpty() ? text : QString("%1\n%2").arg(text, informativeText));
+    return;
+  }
+  QMessageBox *pMessageBox = new QMessageBox(mpMainWindow);
+  pMessageBox->setWindowTitle(QString(Helper::applicationName).append(" - ")
+                              .append(icon == QMessageBox::Critical ? Helper::error : Helper::information));
+  pMessageBox->setIcon(icon);
+  pMessageBox->setAttribute(Qt::WA_DeleteOnClose);
+  pMessageBox->setText(text);
+  pMessageBox->setInformativeText(informativeText);
+  pMessageBox->setStandardButtons(QMessageBox::Ok);
+  pMessageBox->exec();
+}
+
 /*!
  * \brief LibraryWidget::parseAndLoadModelicaText
  * Parses and loads the Modelica text and creates a LibraryTreeItems based on the text.
@@ -232,6 +232,7 @@ public:
   QModelIndex libraryTreeItemIndex(const LibraryTreeItem *pLibraryTreeItem) const;
   void addModelicaLibraries(QSplashScreen *pSplashScreen);
   void createLibraryTreeItems(LibraryTreeItem *pLibraryTreeItem);
+  void createLibraryTreeItemsOneByOne(LibraryTreeItem *pLibraryTreeItem);
   LibraryTreeItem* createLibraryTreeItem(QString name, LibraryTreeItem *pParentLibraryTreeItem, bool isSaved = true,
                                          bool isSystemLibrary = false, bool load = false, int row = -1);
   LibraryTreeItem* createLibraryTreeItem(LibraryTreeItem::LibraryType type, QString name, bool isSaved);
@@ -265,14 +266,33 @@ private:
   LibraryWidget *mpLibraryWidget;
   LibraryTreeItem *mpRootLibraryTreeItem;
   QList<LibraryTreeItem*> mNonExistingLibraryTreeItemsList;
-  QModelIndex libraryTreeItemIndexHelper(const LibraryTreeItem *pLibraryTreeItem, const LibraryTreeItem *pParentLibraryTreeItem,
-                                         const QModelIndex &parentIndex) const;
+  QMultiHash<QString, LibraryTreeItem*> mLibraryTreeItemsHash;
+  QMultiHash<QString, LibraryTreeItem*> mCaseInsensitiveLibraryTreeItemsHash;
+  QMultiMap<QString, LibraryTreeItem*> mLibraryTreeItemsPrefixMap;
+  QTimer *mpClassTextConsistencyTimer;
+  QList<LibraryTreeItem*> mClassTextConsistencyCheckList;
+  QHash<quint64, QPair<LibraryTreeItem*, QString> > mPendingClassTextConsistencyChecks;
+  void addLibraryTreeItemToIndex(LibraryTreeItem *pLibraryTreeItem);
+  void removeLibraryTreeItemFromIndex(LibraryTreeItem *pLibraryTreeItem);
+  bool isLibraryTreeItemInSubTree(LibraryTreeItem *pLibraryTreeItem, LibraryTreeItem *pRootLibraryTreeItem) const;
   LibraryTreeItem* getLibraryTreeItemFromFileHelper(LibraryTreeItem *pLibraryTreeItem, QString fileName, int lineNumber);
+  void updateContainingFileClassText(LibraryTreeItem *pParentLibraryTreeItem, bool updateChildren);
+  bool updateLibraryTreeItemClassTextIncrementally(LibraryTreeItem *pLibraryTreeItem, LibraryTreeItem *pParentLibraryTreeItem);
+  void shiftLibraryTreeItemsLineNumbers(LibraryTreeItem *pLibraryTreeItem, QString fileName, int lineNumber, int difference);
+  void refreshChildLibraryTreeItemClassText(LibraryTreeItem *pLibraryTreeItem, QString contents, QString fileName);
+  bool hasUnappliedTextChanges(LibraryTreeItem *pLibraryTreeItem, QString fileName);
   void updateChildLibraryTreeItemClassText(LibraryTreeItem *pLibraryTreeItem, QString contents, QString fileName);
   void readLibraryTreeItemClassTextFromText(LibraryTreeItem *pLibraryTreeItem, QString contents);
   QString readLibraryTreeItemClassTextFromFile(LibraryTreeItem *pLibraryTreeItem);
   void unloadClassHelper(LibraryTreeItem *pLibraryTreeItem, LibraryTreeItem *pParentLibraryTreeItem);
   void unloadClassChildren(LibraryTreeItem *pLibraryTreeItem);
+  QString getLibraryTreeItemPixmapCacheKey(LibraryTreeItem *pLibraryTreeItem);
+  QString getLibraryTreeItemPixmapCacheDirectory();
+  bool readLibraryTreeItemPixmapFromCache(LibraryTreeItem *pLibraryTreeItem, const QString &cacheKey);
+  void writeLibraryTreeItemPixmapToCache(LibraryTreeItem *pLibraryTreeItem, const QString &cacheKey);
+private slots:
+  void checkClassTextConsistency();
+  void classTextConsistencyChecked(OMCFuture future);
 protected:
   Qt::DropActions supportedDropActions() const;
 };
@@ -361,10 +381,11 @@ public:
   LibraryTreeModel* getLibraryTreeModel() {return mpLibraryTreeModel;}
   LibraryTreeProxyModel* getLibraryTreeProxyModel() {return mpLibraryTreeProxyModel;}
   LibraryTreeView* getLibraryTreeView() {return mpLibraryTreeView;}
-  void openFile(QString fileName, QString encoding = Helper::utf8, bool showProgress = true, bool checkFileExists = false);
-  void openModelicaFile(QString fileName, QString encoding = Helper::utf8, bool showProgress = true);
-  void openMetaModelOrTextFile(QFileInfo fileInfo, bool showProgress = true);
+  bool openFile(QString fileName, QString encoding = Helper::utf8, bool showProgress = true, bool checkFileExists = false);
+  bool openModelicaFile(QString fileName, QString encoding = Helper::utf8, bool showProgress = true);
+  bool openMetaModelOrTextFile(QFileInfo fileInfo, bool showProgress = true);
   bool parseMetaModelFile(QFileInfo fileInfo);
+  void showLoadError(QMessageBox::Icon icon, QString text, QString informativeText = QString());
   void parseAndLoadModelicaText(QString modelText);
   bool saveFile(QString fileName, QString contents, LibraryTreeItem *pLibraryTreeItem = 0);
   bool saveLibraryTreeItem(LibraryTreeItem *pLibraryTreeItem);
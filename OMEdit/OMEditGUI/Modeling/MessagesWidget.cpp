@@ -68,6 +68,7 @@ MessageItem::MessageItem(MessageItemType type, QString filename, bool readOnly,
   mMessage = message;
   mErrorKind = StringHandler::getErrorKind(errorKind);
   mErrorType = StringHandler::getErrorType(errorType);
+  mMessageNumber = 0;
 }
 
 /*!
@@ -82,6 +83,285 @@ QString MessageItem::getLocation()
       .arg(QString::number(mColumnEnd));
 }
 
+/*!
+  \class MessagesModel
+  \brief Holds the messages shown in the Messages Browser.
+  Keeps at most getCapacity() messages. The oldest messages are dropped when the capacity is exceeded.
+  */
+/*!
+  \param pParent - pointer to QObject
+  */
+MessagesModel::MessagesModel(QObject *pParent)
+  : QAbstractItemModel(pParent)
+{
+  mCapacity = MESSAGES_MAXIMUM_ROWS;
+}
+
+/*!
+  Sets the maximum number of messages kept by the model. Zero means MESSAGES_MAXIMUM_ROWS.\n
+  Removes the oldest messages if the model already has more messages than the new capacity.
+  \param capacity
+  */
+void MessagesModel::setCapacity(int capacity)
+{
+  mCapacity = (capacity <= 0 || capacity > MESSAGES_MAXIMUM_ROWS) ? MESSAGES_MAXIMUM_ROWS : capacity;
+  int overflow = mMessageItems.size() - mCapacity;
+  if (overflow > 0) {
+    beginRemoveRows(QModelIndex(), 0, overflow - 1);
+    mMessageItems.erase(mMessageItems.begin(), mMessageItems.begin() + overflow);
+    endRemoveRows();
+  }
+}
+
+/*!
+  Sets the color used for the messages of type errorType.
+  \param errorType
+  \param color
+  */
+void MessagesModel::setErrorTypeColor(StringHandler::OpenModelicaErrors errorType, QColor color)
+{
+  switch (errorType) {
+    case StringHandler::Warning:
+      mWarningColor = color;
+      break;
+    case StringHandler::OMError:
+      mErrorColor = color;
+      break;
+    case StringHandler::Notification:
+    default:
+      mNotificationColor = color;
+      break;
+  }
+  if (!mMessageItems.isEmpty()) {
+    emit dataChanged(index(0, 0), index(mMessageItems.size() - 1, ColumnsCount - 1));
+  }
+}
+
+/*!
+  Appends the messages to the model with one row insertion.\n
+  Removes the oldest messages if the capacity is exceeded.
+  \param messageItems
+  */
+void MessagesModel::addMessageItems(const QList<MessageItem> &messageItems)
+{
+  if (messageItems.isEmpty()) {
+    return;
+  }
+  // only the newest mCapacity messages can survive the insertion.
+  int first = qMax(0, messageItems.size() - mCapacity);
+  int count = messageItems.size() - first;
+  int overflow = mMessageItems.size() + count - mCapacity;
+  if (overflow > 0) {
+    beginRemoveRows(QModelIndex(), 0, overflow - 1);
+    mMessageItems.erase(mMessageItems.begin(), mMessageItems.begin() + overflow);
+    endRemoveRows();
+  }
+  beginInsertRows(QModelIndex(), mMessageItems.size(), mMessageItems.size() + count - 1);
+  for (int i = first ; i < messageItems.size() ; i++) {
+    mMessageItems.append(messageItems.at(i));
+  }
+  endInsertRows();
+}
+
+/*!
+  Removes all the messages.
+  */
+void MessagesModel::clearMessageItems()
+{
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
+  beginResetModel();
+  mMessageItems.clear();
+  endResetModel();
+#else /* Qt4 */
+  mMessageItems.clear();
+  reset();
+#endif
+}
+
+/*!
+  Returns the message text of messageItem without any markup.
+  \param messageItem
+  \return the plain message text.
+  */
+QString MessagesModel::plainMessage(MessageItem messageItem)
+{
+  QString message = messageItem.getMessage();
+  if (messageItem.getMessageItemType() == MessageItem::MetaModel || Qt::mightBeRichText(message)) {
+    return QTextDocumentFragment::fromHtml(message).toPlainText();
+  }
+  return message;
+}
+
+/*!
+  Returns the message as plain text with its number, time, kind, type and location.
+  \param messageItem
+  \return the message text.
+  */
+QString MessagesModel::messageText(MessageItem messageItem)
+{
+  QString message = QString("[%1] %2 %3 %4\n")
+      .arg(QString::number(messageItem.getMessageNumber()))
+      .arg(messageItem.getTime())
+      .arg(StringHandler::getErrorKindString(messageItem.getErrorKind()))
+      .arg(StringHandler::getErrorTypeDisplayString(messageItem.getErrorType()));
+  if (!messageItem.getFileName().isEmpty()) {
+    message.append(QString("[%1: %2]: ").arg(messageItem.getFileName()).arg(messageItem.getLocation()));
+  }
+  message.append(plainMessage(messageItem));
+  return message;
+}
+
+QModelIndex MessagesModel::index(int row, int column, const QModelIndex &parent) const
+{
+  return hasIndex(row, column, parent) ? createIndex(row, column) : QModelIndex();
+}
+
+QModelIndex MessagesModel::parent(const QModelIndex &index) const
+{
+  Q_UNUSED(index);
+  return QModelIndex();
+}
+
+int MessagesModel::rowCount(const QModelIndex &parent) const
+{
+  return parent.isValid() ? 0 : mMessageItems.size();
+}
+
+int MessagesModel::columnCount(const QModelIndex &parent) const
+{
+  Q_UNUSED(parent);
+  return ColumnsCount;
+}
+
+QVariant MessagesModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+  if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+    return QVariant();
+  }
+  switch (section) {
+    case NumberColumn:
+      return tr("#");
+    case TimeColumn:
+      return tr("Time");
+    case KindColumn:
+      return tr("Kind");
+    case TypeColumn:
+      return tr("Type");
+    case LocationColumn:
+      return tr("Location");
+    case MessageColumn:
+      return tr("Message");
+    default:
+      return QVariant();
+  }
+}
+
+/*!
+  Returns the data of the message.\n
+  The message text is only converted for the rows that are actually shown.
+  */
+QVariant MessagesModel::data(const QModelIndex &index, int role) const
+{
+  if (!index.isValid() || index.row() >= mMessageItems.size()) {
+    return QVariant();
+  }
+  MessageItem messageItem = mMessageItems.at(index.row());
+  if (role == Qt::ForegroundRole) {
+    switch (messageItem.getErrorType()) {
+      case StringHandler::Warning:
+        return mWarningColor.isValid() ? QVariant(mWarningColor) : QVariant();
+      case StringHandler::OMError:
+        return mErrorColor.isValid() ? QVariant(mErrorColor) : QVariant();
+      case StringHandler::Notification:
+      default:
+        return mNotificationColor.isValid() ? QVariant(mNotificationColor) : QVariant();
+    }
+  }
+  if (role != Qt::DisplayRole && role != Qt::ToolTipRole) {
+    return QVariant();
+  }
+  switch (index.column()) {
+    case NumberColumn:
+      return messageItem.getMessageNumber();
+    case TimeColumn:
+      return messageItem.getTime();
+    case KindColumn:
+      return StringHandler::getErrorKindString(messageItem.getErrorKind());
+    case TypeColumn:
+      return StringHandler::getErrorTypeDisplayString(messageItem.getErrorType());
+    case LocationColumn:
+      if (messageItem.getFileName().isEmpty()) {
+        return QVariant();
+      } else if (role == Qt::ToolTipRole) {
+        return tr("%1\nDouble click to open the class.").arg(messageItem.getFileName());
+      } else {
+        return QString("%1: %2").arg(messageItem.getFileName()).arg(messageItem.getLocation());
+      }
+    case MessageColumn:
+      if (role == Qt::ToolTipRole) {
+        return plainMessage(messageItem);
+      } else {
+        return plainMessage(messageItem).simplified();
+      }
+    default:
+      return QVariant();
+  }
+}
+
+/*!
+  \class MessagesProxyModel
+  \brief Filters the messages by their type and kind.
+  */
+/*!
+  \param pParent - pointer to QObject
+  */
+MessagesProxyModel::MessagesProxyModel(QObject *pParent)
+  : QSortFilterProxyModel(pParent)
+{
+  mVisibleErrorTypes = ~0;
+  mErrorKindFilter = -1;
+  setDynamicSortFilter(true);
+}
+
+/*!
+  Shows or hides the messages of type errorType.
+  \param errorType
+  \param visible
+  */
+void MessagesProxyModel::setErrorTypeVisible(StringHandler::OpenModelicaErrors errorType, bool visible)
+{
+  if (visible) {
+    mVisibleErrorTypes |= (1 << errorType);
+  } else {
+    mVisibleErrorTypes &= ~(1 << errorType);
+  }
+  invalidateFilter();
+}
+
+/*!
+  Shows only the messages of kind errorKind. -1 shows the messages of all kinds.
+  \param errorKind
+  */
+void MessagesProxyModel::setErrorKindFilter(int errorKind)
+{
+  mErrorKindFilter = errorKind;
+  invalidateFilter();
+}
+
+bool MessagesProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const
+{
+  Q_UNUSED(sourceParent);
+  MessagesModel *pMessagesModel = qobject_cast<MessagesModel*>(sourceModel());
+  if (!pMessagesModel) {
+    return true;
+  }
+  MessageItem messageItem = pMessagesModel->messageItemAt(sourceRow);
+  if (!(mVisibleErrorTypes & (1 << messageItem.getErrorType()))) {
+    return false;
+  }
+  return mErrorKindFilter < 0 || messageItem.getErrorKind() == mErrorKindFilter;
+}
+
 /*!
   \class MessagesWidget
   \brief Shows warnings, notifications and error messages.
@@ -95,39 +375,94 @@ MessagesWidget::MessagesWidget(MainWindow *pMainWindow)
 {
   mpMainWindow = pMainWindow;
   mMessageNumber = 1;
-  mpMessagesTextBrowser = new QTextBrowser;
-  mpMessagesTextBrowser->setOpenLinks(false);
-  mpMessagesTextBrowser->setOpenExternalLinks(false);
+  // messages model and filter
+  mpMessagesModel = new MessagesModel(this);
+  mpMessagesProxyModel = new MessagesProxyModel(this);
+  mpMessagesProxyModel->setSourceModel(mpMessagesModel);
+  // messages are added in batches
+  mFlushMessagesTimer.setSingleShot(true);
+  mFlushMessagesTimer.setInterval(MESSAGES_FLUSH_INTERVAL);
+  connect(&mFlushMessagesTimer, SIGNAL(timeout()), SLOT(flushPendingMessages()));
+  // filter buttons
+  mpShowNotificationsToolButton = new QToolButton;
+  mpShowNotificationsToolButton->setText(StringHandler::getErrorTypeDisplayString(StringHandler::Notification));
+  mpShowNotificationsToolButton->setCheckable(true);
+  mpShowNotificationsToolButton->setChecked(true);
+  mpShowNotificationsToolButton->setAutoRaise(true);
+  connect(mpShowNotificationsToolButton, SIGNAL(toggled(bool)), SLOT(filterMessages()));
+  mpShowWarningsToolButton = new QToolButton;
+  mpShowWarningsToolButton->setText(StringHandler::getErrorTypeDisplayString(StringHandler::Warning));
+  mpShowWarningsToolButton->setCheckable(true);
+  mpShowWarningsToolButton->setChecked(true);
+  mpShowWarningsToolButton->setAutoRaise(true);
+  connect(mpShowWarningsToolButton, SIGNAL(toggled(bool)), SLOT(filterMessages()));
+  mpShowErrorsToolButton = new QToolButton;
+  mpShowErrorsToolButton->setText(StringHandler::getErrorTypeDisplayString(StringHandler::OMError));
+  mpShowErrorsToolButton->setCheckable(true);
+  mpShowErrorsToolButton->setChecked(true);
+  mpShowErrorsToolButton->setAutoRaise(true);
+  connect(mpShowErrorsToolButton, SIGNAL(toggled(bool)), SLOT(filterMessages()));
+  mpErrorKindComboBox = new QComboBox;
+  mpErrorKindComboBox->addItem(tr("All Kinds"), -1);
+  for (int errorKind = StringHandler::Syntax ; errorKind < StringHandler::NoOMErrorKind ; errorKind++) {
+    mpErrorKindComboBox->addItem(StringHandler::getErrorKindString((StringHandler::OpenModelicaErrorKinds)errorKind), errorKind);
+  }
+  connect(mpErrorKindComboBox, SIGNAL(currentIndexChanged(int)), SLOT(filterMessages()));
+  // messages tree view
+  mpMessagesTreeView = new QTreeView;
+  mpMessagesTreeView->setModel(mpMessagesProxyModel);
+  mpMessagesTreeView->setIndentation(0);
+  mpMessagesTreeView->setRootIsDecorated(false);
+  mpMessagesTreeView->setUniformRowHeights(true);
+  mpMessagesTreeView->setTextElideMode(Qt::ElideMiddle);
+  mpMessagesTreeView->setSelectionBehavior(QAbstractItemView::SelectRows);
+  mpMessagesTreeView->setSelectionMode(QAbstractItemView::ExtendedSelection);
+  mpMessagesTreeView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+  mpMessagesTreeView->header()->setStretchLastSection(true);
+  mpMessagesTreeView->setColumnWidth(MessagesModel::NumberColumn, 50);
+  mpMessagesTreeView->setColumnWidth(MessagesModel::TimeColumn, 70);
+  mpMessagesTreeView->setColumnWidth(MessagesModel::KindColumn, 80);
+  mpMessagesTreeView->setColumnWidth(MessagesModel::TypeColumn, 80);
+  mpMessagesTreeView->setColumnWidth(MessagesModel::LocationColumn, 200);
   // since the QFrame::StyledPanel is not a grey rectangle around it so we need to put it in a QFrame.
-  mpMessagesTextBrowser->setFrameStyle(QFrame::NoFrame);
-  QFrame *pMessagesTextBrowserFrame = new QFrame;
-  pMessagesTextBrowserFrame->setFrameStyle(QFrame::StyledPanel);
-  mpMessagesTextBrowser->setContextMenuPolicy(Qt::CustomContextMenu);
-  connect(mpMessagesTextBrowser, SIGNAL(anchorClicked(QUrl)), SLOT(openErrorMessageClass(QUrl)));
-  connect(mpMessagesTextBrowser, SIGNAL(customContextMenuRequested(QPoint)), SLOT(showContextMenu(QPoint)));
+  mpMessagesTreeView->setFrameStyle(QFrame::NoFrame);
+  QFrame *pMessagesTreeViewFrame = new QFrame;
+  pMessagesTreeViewFrame->setFrameStyle(QFrame::StyledPanel);
+  mpMessagesTreeView->setContextMenuPolicy(Qt::CustomContextMenu);
+  connect(mpMessagesTreeView, SIGNAL(doubleClicked(QModelIndex)), SLOT(openErrorMessageClass(QModelIndex)));
+  connect(mpMessagesTreeView, SIGNAL(customContextMenuRequested(QPoint)), SLOT(showContextMenu(QPoint)));
   applyMessagesSettings();
   // create actions
   mpSelectAllAction = new QAction(tr("Select All"), this);
   mpSelectAllAction->setShortcut(QKeySequence("Ctrl+a"));
   mpSelectAllAction->setStatusTip(tr("Selects all the Messages"));
-  connect(mpSelectAllAction, SIGNAL(triggered()), mpMessagesTextBrowser, SLOT(selectAll()));
+  connect(mpSelectAllAction, SIGNAL(triggered()), mpMessagesTreeView, SLOT(selectAll()));
   mpCopyAction = new QAction(QIcon(":/Resources/icons/copy.svg"), Helper::copy, this);
   mpCopyAction->setShortcut(QKeySequence("Ctrl+c"));
   mpCopyAction->setStatusTip(tr("Copy the Message"));
-  connect(mpCopyAction, SIGNAL(triggered()), mpMessagesTextBrowser, SLOT(copy()));
+  connect(mpCopyAction, SIGNAL(triggered()), SLOT(copyMessages()));
   mpClearAllAction = new QAction(tr("Clear All"), this);
   mpClearAllAction->setStatusTip(tr("clears the Messages Browser"));
   connect(mpClearAllAction, SIGNAL(triggered()), SLOT(clearMessages()));
-  // set layout for MessagesTextBrowser frame
-  QVBoxLayout *pMessagesTextBrowserLayout = new QVBoxLayout;
-  pMessagesTextBrowserLayout->setContentsMargins(0, 0, 0, 0);
-  pMessagesTextBrowserLayout->addWidget(mpMessagesTextBrowser);
-  pMessagesTextBrowserFrame->setLayout(pMessagesTextBrowserLayout);
+  // set layout for filters
+  QHBoxLayout *pFiltersLayout = new QHBoxLayout;
+  pFiltersLayout->setContentsMargins(0, 0, 0, 0);
+  pFiltersLayout->addWidget(mpShowNotificationsToolButton);
+  pFiltersLayout->addWidget(mpShowWarningsToolButton);
+  pFiltersLayout->addWidget(mpShowErrorsToolButton);
+  pFiltersLayout->addWidget(mpErrorKindComboBox);
+  pFiltersLayout->addStretch();
+  // set layout for MessagesTreeView frame
+  QVBoxLayout *pMessagesTreeViewLayout = new QVBoxLayout;
+  pMessagesTreeViewLayout->setContentsMargins(0, 0, 0, 0);
+  pMessagesTreeViewLayout->addWidget(mpMessagesTreeView);
+  pMessagesTreeViewFrame->setLayout(pMessagesTreeViewLayout);
   // Main Layout
-  QHBoxLayout *pMainLayout = new QHBoxLayout;
+  QVBoxLayout *pMainLayout = new QVBoxLayout;
   pMainLayout->setContentsMargins(0, 0, 0, 0);
   pMainLayout->setSpacing(1);
-  pMainLayout->addWidget(pMessagesTextBrowserFrame);
+  pMainLayout->addLayout(pFiltersLayout);
+  pMainLayout->addWidget(pMessagesTreeViewFrame);
   setLayout(pMainLayout);
 }
 
@@ -138,148 +473,109 @@ void MessagesWidget::applyMessagesSettings()
 {
   MessagesPage *pMessagesPage = mpMainWindow->getOptionsDialog()->getMessagesPage();
   // set the output size
-  mpMessagesTextBrowser->document()->setMaximumBlockCount(pMessagesPage->getOutputSizeSpinBox()->value());
+  mpMessagesModel->setCapacity(pMessagesPage->getOutputSizeSpinBox()->value());
   // set the font
   QString fontFamily = pMessagesPage->getFontFamilyComboBox()->currentFont().family();
   double fontSize = pMessagesPage->getFontSizeSpinBox()->value();
   QFont font(fontFamily);
   font.setPointSizeF(fontSize);
-  mpMessagesTextBrowser->setFont(font);
-  // set the messages color by setting the style sheet
-  QString messagesCSS = QString(".notification {color: %1}"
-                                ".warning {color: %2}"
-                                ".error {color: %3}")
-      .arg(mpMainWindow->getOptionsDialog()->getMessagesPage()->getNotificationColor().name())
-      .arg(mpMainWindow->getOptionsDialog()->getMessagesPage()->getWarningColor().name())
-      .arg(mpMainWindow->getOptionsDialog()->getMessagesPage()->getErrorColor().name());
-  mpMessagesTextBrowser->document()->setDefaultStyleSheet(messagesCSS);
-  // move the cursor to end.
-  QTextCursor textCursor = mpMessagesTextBrowser->textCursor();
-  textCursor.movePosition(QTextCursor::End);
-  mpMessagesTextBrowser->setTextCursor(textCursor);
+  mpMessagesTreeView->setFont(font);
+  // set the messages color
+  mpMessagesModel->setErrorTypeColor(StringHandler::Notification, pMessagesPage->getNotificationColor());
+  mpMessagesModel->setErrorTypeColor(StringHandler::Warning, pMessagesPage->getWarningColor());
+  mpMessagesModel->setErrorTypeColor(StringHandler::OMError, pMessagesPage->getErrorColor());
 }
 
 /*!
   Adds the error message.\n
-  Moves to the most recent error message in the view.
+  The message is queued and added to the view together with the other messages arriving within MESSAGES_FLUSH_INTERVAL.
+  The queue is trimmed to the capacity of the model.
+  The links to the classes are resolved when the message is double clicked.
+  In batch mode the message is only written to the standard error stream since there is no event loop to flush the queue.
   */
 void MessagesWidget::addGUIMessage(MessageItem messageItem)
 {
-  // move the cursor down before adding message.
-  QTextCursor textCursor = mpMessagesTextBrowser->textCursor();
-  textCursor.movePosition(QTextCursor::End);
-  mpMessagesTextBrowser->setTextCursor(textCursor);
-  // set the CSS class depending on message type
-  QString messageCSSClass;
-  switch (messageItem.getErrorType()) {
-    case StringHandler::Warning:
-      messageCSSClass = "warning";
-      break;
-    case StringHandler::OMError:
-      messageCSSClass = "error";
-      break;
-    case StringHandler::Notification:
-    default:
-      messageCSSClass = "notification";
-      break;
+  messageItem.setMessageNumber(mMessageNumber);
+  mMessageNumber++;
+  // in batch mode nobody looks at the Messages Browser so write the message to the console.
+  if (mpMainWindow->isBatch()) {
+    fprintf(stderr, "%s\n", MessagesModel::messageText(messageItem).toLocal8Bit().constData());
+    return;
   }
-  QString linkFormat = QString("[%1: %2]: <a href=\"omeditmessagesbrowser:///%3?lineNumber=%4\">%5</a>");
-  QString errorMessage;
-  QString message;
-  if(messageItem.getMessageItemType()== MessageItem::Modelica) {
-    // if message already have tags then just use it.
-    if (Qt::mightBeRichText(messageItem.getMessage())) {
-      message = messageItem.getMessage();
-    } else {
-      message = Qt::convertFromPlainText(messageItem.getMessage()).remove("<p>").remove("</p>");
-    }
-  } else if(messageItem.getMessageItemType()== MessageItem::MetaModel) {
-    message = messageItem.getMessage().remove("<p>").remove("</p>");
+  mPendingMessageItems.append(messageItem);
+  // only the newest messages fit in the model so don't queue more than its capacity e.g., when the event loop is blocked.
+  if (mPendingMessageItems.size() > mpMessagesModel->getCapacity()) {
+    mPendingMessageItems.removeFirst();
   }
-  if (messageItem.getFileName().isEmpty()) { // if custom error message
-    errorMessage = message;
-  } else if (messageItem.getMessageItemType()== MessageItem::MetaModel ||
-             mpMainWindow->getLibraryWidget()->getLibraryTreeModel()->findLibraryTreeItem(messageItem.getFileName())) {
-    // If the class is only loaded in AST via loadString then create link for the error message.
-    errorMessage = linkFormat.arg(messageItem.getFileName())
-        .arg(messageItem.getLocation())
-        .arg(messageItem.getFileName())
-        .arg(messageItem.getLineStart())
-        .arg(message);
-  } else {
-    // Find the class name using the file name and line number.
-    LibraryTreeItem *pLibraryTreeItem;
-    pLibraryTreeItem = mpMainWindow->getLibraryWidget()->getLibraryTreeModel()->getLibraryTreeItemFromFile(messageItem.getFileName(),
-                                                                                                           messageItem.getLineStart().toInt());
-    if (pLibraryTreeItem) {
-      errorMessage = linkFormat.arg(pLibraryTreeItem->getNameStructure())
-          .arg(messageItem.getLocation())
-          .arg(pLibraryTreeItem->getNameStructure())
-          .arg(messageItem.getLineStart())
-          .arg(message);
-    } else {
-      // otherwise display filename to user where error occurred.
-      errorMessage = QString("[%1: %2]: %3")
-          .arg(messageItem.getFileName())
-          .arg(messageItem.getLocation())
-          .arg(message);
-    }
+  if (!mFlushMessagesTimer.isActive()) {
+    mFlushMessagesTimer.start();
   }
-  QString errorString = QString("<div class=\"%1\">"
-                                "<b>[%2] %3 %4 %5</b><br>"
-                                "%6"
-                                "</div><br>")
-      .arg(messageCSSClass)
-      .arg(QString::number(mMessageNumber))
-      .arg(QTime::currentTime().toString())
-      .arg(StringHandler::getErrorKindString(messageItem.getErrorKind()))
-      .arg(StringHandler::getErrorTypeDisplayString(messageItem.getErrorType()))
-      .arg(errorMessage);
-  mpMessagesTextBrowser->insertHtml(errorString);
-  mMessageNumber++;
-  // move the cursor down after adding message.
-  textCursor.movePosition(QTextCursor::End);
-  mpMessagesTextBrowser->setTextCursor(textCursor);
   emit MessageAdded();
 }
 
 /*!
-  Slot activated when a link is clicked from MessagesWidget.\n
-  Parses the url and loads the Modelica class with the line selected.
-  \param url - the url that is clicked
+  Adds the pending messages to the model.\n
+  Moves to the most recent error message in the view.
+  Slot activated when mFlushMessagesTimer timeout signal is raised.
   */
-/*
-  <a href="omeditmessagesbrowser:///className?lineNumber=4></a>"
+void MessagesWidget::flushPendingMessages()
+{
+  if (mPendingMessageItems.isEmpty()) {
+    return;
+  }
+  mpMessagesModel->addMessageItems(mPendingMessageItems);
+  mPendingMessageItems.clear();
+  mpMessagesTreeView->scrollToBottom();
+}
+
+/*!
+  Slot activated when a message is double clicked in MessagesWidget.\n
+  Finds the class of the message and opens it with the line selected.
+  \param index - the index of the message that is double clicked.
   */
-void MessagesWidget::openErrorMessageClass(QUrl url)
+void MessagesWidget::openErrorMessageClass(const QModelIndex &index)
 {
-  if (url.scheme() != "omeditmessagesbrowser") {
-    /*! @todo Write error-message?! */
+  QModelIndex sourceIndex = mpMessagesProxyModel->mapToSource(index);
+  if (!sourceIndex.isValid()) {
+    return;
+  }
+  MessageItem messageItem = mpMessagesModel->messageItemAt(sourceIndex.row());
+  if (messageItem.getFileName().isEmpty()) {
     return;
   }
-  QString className = url.path();
-  if (className.startsWith("/")) className.remove(0, 1);
-  LibraryTreeItem *pLibraryTreeItem = mpMainWindow->getLibraryWidget()->getLibraryTreeModel()->findLibraryTreeItem(className);
+  LibraryTreeModel *pLibraryTreeModel = mpMainWindow->getLibraryWidget()->getLibraryTreeModel();
+  // If the class is only loaded in AST via loadString then the file name is the class name.
+  LibraryTreeItem *pLibraryTreeItem = pLibraryTreeModel->findLibraryTreeItem(messageItem.getFileName());
+  if (!pLibraryTreeItem && messageItem.getMessageItemType() == MessageItem::Modelica) {
+    // Find the class name using the file name and line number.
+    pLibraryTreeItem = pLibraryTreeModel->getLibraryTreeItemFromFile(messageItem.getFileName(), messageItem.getLineStart().toInt());
+  }
   if (pLibraryTreeItem) {
     ModelWidget *pModelWidget = pLibraryTreeItem->getModelWidget();
     if (pModelWidget) {
       mpMainWindow->getModelWidgetContainer()->addModelWidget(pModelWidget, false);
     } else {
-      mpMainWindow->getLibraryWidget()->getLibraryTreeModel()->showModelWidget(pLibraryTreeItem);
+      pLibraryTreeModel->showModelWidget(pLibraryTreeItem);
     }
     if (pModelWidget && pModelWidget->getEditor()) {
-#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
-      QUrlQuery query(url);
-	  int lineNumber = query.queryItemValue("lineNumber").toInt();
-#else /* Qt4 */
-      int lineNumber = url.queryItemValue("lineNumber").toInt();
-#endif
       pModelWidget->getTextViewToolButton()->setChecked(true);
-      pModelWidget->getEditor()->goToLineNumber(lineNumber);
+      pModelWidget->getEditor()->goToLineNumber(messageItem.getLineStart().toInt());
     }
   }
 }
 
+/*!
+  Applies the type and kind filters to the messages.
+  Slot activated when the filter buttons are toggled or mpErrorKindComboBox currentIndexChanged signal is raised.
+  */
+void MessagesWidget::filterMessages()
+{
+  mpMessagesProxyModel->setErrorTypeVisible(StringHandler::Notification, mpShowNotificationsToolButton->isChecked());
+  mpMessagesProxyModel->setErrorTypeVisible(StringHandler::Warning, mpShowWarningsToolButton->isChecked());
+  mpMessagesProxyModel->setErrorTypeVisible(StringHandler::OMError, mpShowErrorsToolButton->isChecked());
+  mpMessagesProxyModel->setErrorKindFilter(mpErrorKindComboBox->itemData(mpErrorKindComboBox->currentIndex()).toInt());
+}
+
 /*!
   Shows a context menu when user right click on the Messages tree.
   Slot activated when Message::customContextMenuRequested() signal is raised.
@@ -290,7 +586,22 @@ void MessagesWidget::showContextMenu(QPoint point)
   menu.addAction(mpSelectAllAction);
   menu.addAction(mpCopyAction);
   menu.addAction(mpClearAllAction);
-  menu.exec(mpMessagesTextBrowser->viewport()->mapToGlobal(point));
+  menu.exec(mpMessagesTreeView->viewport()->mapToGlobal(point));
+}
+
+/*!
+  Copies the selected messages to the clipboard.
+  Slot activated when mpCopyAction triggered signal is raised.
+  */
+void MessagesWidget::copyMessages()
+{
+  QModelIndexList selectedRows = mpMessagesTreeView->selectionModel()->selectedRows();
+  qSort(selectedRows);
+  QStringList messages;
+  foreach (QModelIndex index, selectedRows) {
+    messages.append(MessagesModel::messageText(mpMessagesModel->messageItemAt(mpMessagesProxyModel->mapToSource(index).row())));
+  }
+  QApplication::clipboard()->setText(messages.join("\n\n"));
 }
 
 /*!
@@ -300,5 +611,7 @@ void MessagesWidget::showContextMenu(QPoint point)
 void MessagesWidget::clearMessages()
 {
   resetMessagesNumber();
-  mpMessagesTextBrowser->clear();
+  mFlushMessagesTimer.stop();
+  mPendingMessageItems.clear();
+  mpMessagesModel->clearMessageItems();
 }
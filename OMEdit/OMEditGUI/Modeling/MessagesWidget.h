@@ -45,6 +45,11 @@ class StringHandler;
 
 class MessagesWidget;
 
+/* Upper limit of the messages kept by the Messages Browser when the output size is set to unlimited. */
+#define MESSAGES_MAXIMUM_ROWS 100000
+/* Interval in milliseconds at which the pending messages are added to the Messages Browser. */
+#define MESSAGES_FLUSH_INTERVAL 100
+
 class MessageItem
 {
 public:
@@ -63,6 +68,7 @@ public:
   QString mKind;
   StringHandler::OpenModelicaErrorKinds mErrorKind;
   StringHandler::OpenModelicaErrors mErrorType;
+  int mMessageNumber;
 public:
   MessageItem(MessageItemType type ,QString filename, bool readOnly, int lineStart, int columnStart, int lineEnd, int columnEnd, QString message, QString errorKind,
               QString errorType);
@@ -74,31 +80,95 @@ public:
   QString getMessage() {return mMessage;}
   StringHandler::OpenModelicaErrorKinds getErrorKind() {return mErrorKind;}
   StringHandler::OpenModelicaErrors getErrorType() {return mErrorType;}
+  void setMessageNumber(int messageNumber) {mMessageNumber = messageNumber;}
+  int getMessageNumber() {return mMessageNumber;}
 private:
   MessageItemType mMessageItemType;
 };
 
+class MessagesModel : public QAbstractItemModel
+{
+  Q_OBJECT
+public:
+  enum Columns {
+    NumberColumn,
+    TimeColumn,
+    KindColumn,
+    TypeColumn,
+    LocationColumn,
+    MessageColumn,
+    ColumnsCount
+  };
+  MessagesModel(QObject *pParent = 0);
+  void setCapacity(int capacity);
+  int getCapacity() {return mCapacity;}
+  void setErrorTypeColor(StringHandler::OpenModelicaErrors errorType, QColor color);
+  void addMessageItems(const QList<MessageItem> &messageItems);
+  void clearMessageItems();
+  MessageItem messageItemAt(int row) const {return mMessageItems.at(row);}
+  static QString plainMessage(MessageItem messageItem);
+  static QString messageText(MessageItem messageItem);
+  virtual QModelIndex index(int row, int column, const QModelIndex &parent = QModelIndex()) const;
+  virtual QModelIndex parent(const QModelIndex &index) const;
+  virtual int rowCount(const QModelIndex &parent = QModelIndex()) const;
+  virtual int columnCount(const QModelIndex &parent = QModelIndex()) const;
+  virtual QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const;
+  virtual QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const;
+private:
+  QList<MessageItem> mMessageItems;
+  int mCapacity;
+  QColor mNotificationColor;
+  QColor mWarningColor;
+  QColor mErrorColor;
+};
+
+class MessagesProxyModel : public QSortFilterProxyModel
+{
+  Q_OBJECT
+public:
+  MessagesProxyModel(QObject *pParent = 0);
+  void setErrorTypeVisible(StringHandler::OpenModelicaErrors errorType, bool visible);
+  void setErrorKindFilter(int errorKind);
+protected:
+  virtual bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const;
+private:
+  int mVisibleErrorTypes;
+  int mErrorKindFilter;
+};
+
 class MessagesWidget : public QWidget
 {
   Q_OBJECT
 private:
   MainWindow *mpMainWindow;
   int mMessageNumber;
-  QTextBrowser *mpMessagesTextBrowser;
+  MessagesModel *mpMessagesModel;
+  MessagesProxyModel *mpMessagesProxyModel;
+  QTreeView *mpMessagesTreeView;
+  QToolButton *mpShowNotificationsToolButton;
+  QToolButton *mpShowWarningsToolButton;
+  QToolButton *mpShowErrorsToolButton;
+  QComboBox *mpErrorKindComboBox;
+  QList<MessageItem> mPendingMessageItems;
+  QTimer mFlushMessagesTimer;
   QAction *mpSelectAllAction;
   QAction *mpCopyAction;
   QAction *mpClearAllAction;
 public:
   MessagesWidget(MainWindow *pMainWindow);
   void resetMessagesNumber() {mMessageNumber = 1;}
-  QTextBrowser* getMessagesTextBrowser() {return mpMessagesTextBrowser;}
+  QTreeView* getMessagesTreeView() {return mpMessagesTreeView;}
+  bool hasMessages() {return mpMessagesModel->rowCount() > 0 || !mPendingMessageItems.isEmpty();}
   void applyMessagesSettings();
   void addGUIMessage(MessageItem messageItem);
 signals:
   void MessageAdded();
 private slots:
-  void openErrorMessageClass(QUrl url);
+  void flushPendingMessages();
+  void openErrorMessageClass(const QModelIndex &index);
+  void filterMessages();
   void showContextMenu(QPoint point);
+  void copyMessages();
   void clearMessages();
 };
 
@@ -75,6 +75,13 @@ GraphicsView::GraphicsView(StringHandler::ViewType viewType, ModelWidget *parent
   setViewportUpdateMode(QGraphicsView::FullViewportUpdate);
   setMouseTracking(true);
   mpModelWidget = parent;
+  mGridLinesHorizontalStep = 0;
+  mGridLinesVerticalStep = 0;
+  mFirstVerticalGridLine = 0;
+  mFirstHorizontalGridLine = 0;
+  mPaintFrameCount = 0;
+  mPaintTime = 0;
+  mMaximumPaintTime = 0;
   // set the coOrdinate System
   mCoOrdinateSystem = CoOrdinateSystem();
   GraphicalViewsPage *pGraphicalViewsPage;
@@ -105,6 +112,9 @@ GraphicsView::GraphicsView(StringHandler::ViewType viewType, ModelWidget *parent
   mpClickedComponent = 0;
   setIsMovingComponentsAndShapes(false);
   setRenderingLibraryPixmap(false);
+  mUpdateConnectionsTimer.setSingleShot(true);
+  mUpdateConnectionsTimer.setInterval(0);
+  connect(&mUpdateConnectionsTimer, SIGNAL(timeout()), SLOT(updateScheduledConnections()));
   createActions();
 }
 
@@ -934,6 +944,40 @@ void GraphicsView::removeItem(QGraphicsItem *pGraphicsItem)
   }
 }
 
+/*!
+ * \brief GraphicsView::scheduleConnectionUpdate
+ * Schedules the re-routing of the connection while the components are dragged.\n
+ * All the connections scheduled while handling the pending mouse events are re-routed together by GraphicsView::updateScheduledConnections.
+ * \param pConnectionLineAnnotation
+ */
+void GraphicsView::scheduleConnectionUpdate(LineAnnotation *pConnectionLineAnnotation)
+{
+  mScheduledConnections.append(pConnectionLineAnnotation);
+  if (!mUpdateConnectionsTimer.isActive()) {
+    mUpdateConnectionsTimer.start();
+  }
+}
+
+/*!
+ * \brief GraphicsView::updateScheduledConnections
+ * Re-routes the scheduled connections. The scene position of each connector is computed only once.
+ */
+void GraphicsView::updateScheduledConnections()
+{
+  mUpdateConnectionsTimer.stop();
+  if (mScheduledConnections.isEmpty()) {
+    return;
+  }
+  QList<QPointer<LineAnnotation> > connections = mScheduledConnections;
+  mScheduledConnections.clear();
+  QHash<Component*, QPointF> connectorsScenePositions;
+  foreach (QPointer<LineAnnotation> pConnectionLineAnnotation, connections) {
+    if (pConnectionLineAnnotation) {
+      pConnectionLineAnnotation->updateConnectionPoints(&connectorsScenePositions);
+    }
+  }
+}
+
 /*!
  * \brief GraphicsView::createActions
  * Creates the actions for the GraphicsView.
@@ -1335,11 +1379,11 @@ void GraphicsView::showSimulationParamsDialog()
  */
 void GraphicsView::manhattanizeItems()
 {
-  mpModelWidget->getUndoStack()->beginMacro("Manhattanize by mouse");
+  mpModelWidget->beginMacro("Manhattanize by mouse");
   emit mouseManhattanize();
   mpModelWidget->updateClassAnnotationIfNeeded();
   mpModelWidget->updateModelText();
-  mpModelWidget->getUndoStack()->endMacro();
+  mpModelWidget->endMacro();
 }
 
 /*!
@@ -1374,11 +1418,11 @@ void GraphicsView::duplicateItems()
  */
 void GraphicsView::rotateClockwise()
 {
-  mpModelWidget->getUndoStack()->beginMacro("Rotate clockwise by mouse");
+  mpModelWidget->beginMacro("Rotate clockwise by mouse");
   emit mouseRotateClockwise();
   mpModelWidget->updateClassAnnotationIfNeeded();
   mpModelWidget->updateModelText();
-  mpModelWidget->getUndoStack()->endMacro();
+  mpModelWidget->endMacro();
 }
 
 /*!
@@ -1387,11 +1431,11 @@ void GraphicsView::rotateClockwise()
  */
 void GraphicsView::rotateAntiClockwise()
 {
-  mpModelWidget->getUndoStack()->beginMacro("Rotate anti clockwise by mouse");
+  mpModelWidget->beginMacro("Rotate anti clockwise by mouse");
   emit mouseRotateAntiClockwise();
   mpModelWidget->updateClassAnnotationIfNeeded();
   mpModelWidget->updateModelText();
-  mpModelWidget->getUndoStack()->endMacro();
+  mpModelWidget->endMacro();
 }
 
 /*!
@@ -1400,11 +1444,11 @@ void GraphicsView::rotateAntiClockwise()
  */
 void GraphicsView::flipHorizontal()
 {
-  mpModelWidget->getUndoStack()->beginMacro("Flip horizontal by mouse");
+  mpModelWidget->beginMacro("Flip horizontal by mouse");
   emit mouseFlipHorizontal();
   mpModelWidget->updateClassAnnotationIfNeeded();
   mpModelWidget->updateModelText();
-  mpModelWidget->getUndoStack()->endMacro();
+  mpModelWidget->endMacro();
 }
 
 /*!
@@ -1413,11 +1457,11 @@ void GraphicsView::flipHorizontal()
  */
 void GraphicsView::flipVertical()
 {
-  mpModelWidget->getUndoStack()->beginMacro("Flip vertical by mouse");
+  mpModelWidget->beginMacro("Flip vertical by mouse");
   emit mouseFlipVertical();
   mpModelWidget->updateClassAnnotationIfNeeded();
   mpModelWidget->updateModelText();
-  mpModelWidget->getUndoStack()->endMacro();
+  mpModelWidget->endMacro();
 }
 
 /*!
@@ -1493,38 +1537,22 @@ void GraphicsView::drawBackground(QPainter *painter, const QRectF &rect)
   painter->drawRect(rect);
   painter->setBrush(QBrush(Qt::white, Qt::SolidPattern));
   painter->drawRect(getExtentRectangle());
-  if (mpModelWidget->getModelWidgetContainer()->isShowGridLines()) {
+  int horizontalGridStep = mCoOrdinateSystem.getHorizontalGridStep() * 10;
+  int verticalGridStep = mCoOrdinateSystem.getVerticalGridStep() * 10;
+  if (mpModelWidget->getModelWidgetContainer()->isShowGridLines() && horizontalGridStep > 0 && verticalGridStep > 0) {
     painter->setBrush(Qt::NoBrush);
     painter->setPen(QColor(229, 229, 229));
-    /* Draw left half vertical lines */
-    int horizontalGridStep = mCoOrdinateSystem.getHorizontalGridStep() * 10;
-    qreal xAxisStep = 0;
-    qreal yAxisStep = rect.y();
-    xAxisStep -= horizontalGridStep;
-    while (xAxisStep > rect.left()) {
-      painter->drawLine(QPointF(xAxisStep, yAxisStep), QPointF(xAxisStep, rect.bottom()));
-      xAxisStep -= horizontalGridStep;
+    updateGridLines(rect, horizontalGridStep, verticalGridStep);
+    /* Draw the visible vertical and horizontal lines with one call each. */
+    int first = qMax((int)qCeil(rect.left() / horizontalGridStep) - mFirstVerticalGridLine, 0);
+    int last = qMin((int)qFloor(rect.right() / horizontalGridStep) - mFirstVerticalGridLine, mVerticalGridLines.size() - 1);
+    if (last >= first) {
+      painter->drawLines(mVerticalGridLines.constData() + first, last - first + 1);
     }
-    /* Draw right half vertical lines */
-    xAxisStep = 0;
-    while (xAxisStep < rect.right()) {
-      painter->drawLine(QPointF(xAxisStep, yAxisStep), QPointF(xAxisStep, rect.bottom()));
-      xAxisStep += horizontalGridStep;
-    }
-    /* Draw left half horizontal lines */
-    int verticalGridStep = mCoOrdinateSystem.getVerticalGridStep() * 10;
-    xAxisStep = rect.x();
-    yAxisStep = 0;
-    yAxisStep += verticalGridStep;
-    while (yAxisStep < rect.bottom()) {
-      painter->drawLine(QPointF(xAxisStep, yAxisStep), QPointF(rect.right(), yAxisStep));
-      yAxisStep += verticalGridStep;
-    }
-    /* Draw right half horizontal lines */
-    yAxisStep = 0;
-    while (yAxisStep > rect.top()) {
-      painter->drawLine(QPointF(xAxisStep, yAxisStep), QPointF(rect.right(), yAxisStep));
-      yAxisStep -= verticalGridStep;
+    first = qMax((int)qCeil(rect.top() / verticalGridStep) - mFirstHorizontalGridLine, 0);
+    last = qMin((int)qFloor(rect.bottom() / verticalGridStep) - mFirstHorizontalGridLine, mHorizontalGridLines.size() - 1);
+    if (last >= first) {
+      painter->drawLines(mHorizontalGridLines.constData() + first, last - first + 1);
     }
     /* set the middle horizontal and vertical line gray */
     painter->setPen(QColor(192, 192, 192));
@@ -1536,6 +1564,67 @@ void GraphicsView::drawBackground(QPainter *painter, const QRectF &rect)
   painter->drawRect(getExtentRectangle());
 }
 
+/*!
+ * \brief GraphicsView::updateGridLines
+ * Creates the grid lines if the cached lines don't cover the rect or the grid step has changed.\n
+ * The lines are created for a larger area than needed so that panning doesn't recreate them.
+ * \param rect - the area to draw.
+ * \param horizontalGridStep
+ * \param verticalGridStep
+ */
+void GraphicsView::updateGridLines(const QRectF &rect, int horizontalGridStep, int verticalGridStep)
+{
+  if (mGridLinesRect.contains(rect) && mGridLinesHorizontalStep == horizontalGridStep && mGridLinesVerticalStep == verticalGridStep) {
+    return;
+  }
+  mGridLinesRect = rect.adjusted(-rect.width(), -rect.height(), rect.width(), rect.height()).united(sceneRect());
+  mGridLinesHorizontalStep = horizontalGridStep;
+  mGridLinesVerticalStep = verticalGridStep;
+  mVerticalGridLines.clear();
+  mFirstVerticalGridLine = qCeil(mGridLinesRect.left() / horizontalGridStep);
+  for (int i = mFirstVerticalGridLine ; i <= qFloor(mGridLinesRect.right() / horizontalGridStep) ; i++) {
+    mVerticalGridLines.append(QLineF(i * horizontalGridStep, mGridLinesRect.top(), i * horizontalGridStep, mGridLinesRect.bottom()));
+  }
+  mHorizontalGridLines.clear();
+  mFirstHorizontalGridLine = qCeil(mGridLinesRect.top() / verticalGridStep);
+  for (int i = mFirstHorizontalGridLine ; i <= qFloor(mGridLinesRect.bottom() / verticalGridStep) ; i++) {
+    mHorizontalGridLines.append(QLineF(mGridLinesRect.left(), i * verticalGridStep, mGridLinesRect.right(), i * verticalGridStep));
+  }
+}
+
+/*!
+ * \brief GraphicsView::paintEvent
+ * Reimplementation of QGraphicsView::paintEvent.\n
+ * In debug mode prints the number of frames and the paint time once per second.
+ * \param event
+ */
+void GraphicsView::paintEvent(QPaintEvent *event)
+{
+  if (!mpModelWidget->getModelWidgetContainer()->getMainWindow()->isDebug()) {
+    QGraphicsView::paintEvent(event);
+    return;
+  }
+  QTime paintTime;
+  paintTime.start();
+  QGraphicsView::paintEvent(event);
+  int elapsed = paintTime.elapsed();
+  if (mPaintFrameCount == 0) {
+    mPaintStatisticsTime.start();
+  }
+  mPaintFrameCount++;
+  mPaintTime += elapsed;
+  mMaximumPaintTime = qMax(mMaximumPaintTime, elapsed);
+  if (mPaintStatisticsTime.elapsed() >= 1000) {
+    qDebug() << QString("%1 %2 view: %3 frames, average paint time %4 ms, maximum paint time %5 ms")
+                .arg(mpModelWidget->getLibraryTreeItem()->getNameStructure())
+                .arg(mViewType == StringHandler::Icon ? "icon" : "diagram")
+                .arg(mPaintFrameCount).arg((double)mPaintTime / mPaintFrameCount, 0, 'f', 2).arg(mMaximumPaintTime);
+    mPaintFrameCount = 0;
+    mPaintTime = 0;
+    mMaximumPaintTime = 0;
+  }
+}
+
 //! Defines what happens when clicking in a GraphicsView.
 //! @param event contains information of the mouse click operation.
 void GraphicsView::mousePressEvent(QMouseEvent *event)
@@ -1696,6 +1785,8 @@ void GraphicsView::mouseReleaseEvent(QMouseEvent *event)
   mpClickedComponent = 0;
   if (isMovingComponentsAndShapes()) {
     setIsMovingComponentsAndShapes(false);
+    // the connections must be at their final positions before the connection annotations are sent to OMC.
+    updateScheduledConnections();
     bool hasComponentMoved = false;
     bool hasShapeMoved = false;
     bool beginMacro = false;
@@ -1703,7 +1794,7 @@ void GraphicsView::mouseReleaseEvent(QMouseEvent *event)
     foreach (Component *pComponent, mComponentsList) {
       if (pComponent->getOldPosition() != pComponent->pos()) {
         if (!beginMacro) {
-          mpModelWidget->getUndoStack()->beginMacro("Move items by mouse");
+          mpModelWidget->beginMacro("Move items by mouse");
           beginMacro = true;
         }
         Transformation oldTransformation = pComponent->mTransformation;
@@ -1718,7 +1809,7 @@ void GraphicsView::mouseReleaseEvent(QMouseEvent *event)
     foreach (ShapeAnnotation *pShapeAnnotation, mShapesList) {
       if (pShapeAnnotation->getOldScenePosition() != pShapeAnnotation->scenePos()) {
         if (!beginMacro) {
-          mpModelWidget->getUndoStack()->beginMacro("Move items by mouse");
+          mpModelWidget->beginMacro("Move items by mouse");
           beginMacro = true;
         }
         QString oldAnnotation = pShapeAnnotation->getOMCShapeAnnotation();
@@ -1742,7 +1833,7 @@ void GraphicsView::mouseReleaseEvent(QMouseEvent *event)
     }
     // if we have started he undo stack macro then we should end it.
     if (beginMacro) {
-      mpModelWidget->getUndoStack()->endMacro();
+      mpModelWidget->endMacro();
     }
   }
   QGraphicsView::mouseReleaseEvent(event);
@@ -1828,53 +1919,53 @@ void GraphicsView::keyPressEvent(QKeyEvent *event)
     mpModelWidget->updateModelText();
     mpModelWidget->getUndoStack()->endMacro();
   } else if (!shiftModifier && !controlModifier && event->key() == Qt::Key_Up && isAnyItemSelectedAndEditable(event->key())) {
-    mpModelWidget->getUndoStack()->beginMacro("Move up by key press");
+    mpModelWidget->beginMacro("Move up by key press");
     emit keyPressUp();
-    mpModelWidget->getUndoStack()->endMacro();
+    mpModelWidget->endMacro();
   } else if (shiftModifier && !controlModifier && event->key() == Qt::Key_Up && isAnyItemSelectedAndEditable(event->key())) {
-    mpModelWidget->getUndoStack()->beginMacro("Move shift up by key press");
+    mpModelWidget->beginMacro("Move shift up by key press");
     emit keyPressShiftUp();
-    mpModelWidget->getUndoStack()->endMacro();
+    mpModelWidget->endMacro();
   } else if (!shiftModifier && controlModifier && event->key() == Qt::Key_Up && isAnyItemSelectedAndEditable(event->key())) {
-    mpModelWidget->getUndoStack()->beginMacro("Move control up by key press");
+    mpModelWidget->beginMacro("Move control up by key press");
     emit keyPressCtrlUp();
-    mpModelWidget->getUndoStack()->endMacro();
+    mpModelWidget->endMacro();
   } else if (!shiftModifier && !controlModifier && event->key() == Qt::Key_Down && isAnyItemSelectedAndEditable(event->key())) {
-    mpModelWidget->getUndoStack()->beginMacro("Move down by key press");
+    mpModelWidget->beginMacro("Move down by key press");
     emit keyPressDown();
-    mpModelWidget->getUndoStack()->endMacro();
+    mpModelWidget->endMacro();
   } else if (shiftModifier && !controlModifier && event->key() == Qt::Key_Down && isAnyItemSelectedAndEditable(event->key())) {
-    mpModelWidget->getUndoStack()->beginMacro("Move shift down by key press");
+    mpModelWidget->beginMacro("Move shift down by key press");
     emit keyPressShiftDown();
-    mpModelWidget->getUndoStack()->endMacro();
+    mpModelWidget->endMacro();
   } else if (!shiftModifier && controlModifier && event->key() == Qt::Key_Down && isAnyItemSelectedAndEditable(event->key())) {
-    mpModelWidget->getUndoStack()->beginMacro("Move control down by key press");
+    mpModelWidget->beginMacro("Move control down by key press");
     emit keyPressCtrlDown();
-    mpModelWidget->getUndoStack()->endMacro();
+    mpModelWidget->endMacro();
   } else if (!shiftModifier && !controlModifier && event->key() == Qt::Key_Left && isAnyItemSelectedAndEditable(event->key())) {
-    mpModelWidget->getUndoStack()->beginMacro("Move left by key press");
+    mpModelWidget->beginMacro("Move left by key press");
     emit keyPressLeft();
-    mpModelWidget->getUndoStack()->endMacro();
+    mpModelWidget->endMacro();
   } else if (shiftModifier && !controlModifier && event->key() == Qt::Key_Left && isAnyItemSelectedAndEditable(event->key())) {
-    mpModelWidget->getUndoStack()->beginMacro("Move shift left by key press");
+    mpModelWidget->beginMacro("Move shift left by key press");
     emit keyPressShiftLeft();
-    mpModelWidget->getUndoStack()->endMacro();
+    mpModelWidget->endMacro();
   } else if (!shiftModifier && controlModifier && event->key() == Qt::Key_Left && isAnyItemSelectedAndEditable(event->key())) {
-    mpModelWidget->getUndoStack()->beginMacro("Move control left by key press");
+    mpModelWidget->beginMacro("Move control left by key press");
     emit keyPressCtrlLeft();
-    mpModelWidget->getUndoStack()->endMacro();
+    mpModelWidget->endMacro();
   } else if (!shiftModifier && !controlModifier && event->key() == Qt::Key_Right && isAnyItemSelectedAndEditable(event->key())) {
-    mpModelWidget->getUndoStack()->beginMacro("Move right by key press");
+    mpModelWidget->beginMacro("Move right by key press");
     emit keyPressRight();
-    mpModelWidget->getUndoStack()->endMacro();
+    mpModelWidget->endMacro();
   } else if (shiftModifier && !controlModifier && event->key() == Qt::Key_Right && isAnyItemSelectedAndEditable(event->key())) {
-    mpModelWidget->getUndoStack()->beginMacro("Move shift right by key press");
+    mpModelWidget->beginMacro("Move shift right by key press");
     emit keyPressShiftRight();
-    mpModelWidget->getUndoStack()->endMacro();
+    mpModelWidget->endMacro();
   } else if (!shiftModifier && controlModifier && event->key() == Qt::Key_Right && isAnyItemSelectedAndEditable(event->key())) {
-    mpModelWidget->getUndoStack()->beginMacro("Move control right by key press");
+    mpModelWidget->beginMacro("Move control right by key press");
     emit keyPressCtrlRight();
-    mpModelWidget->getUndoStack()->endMacro();
+    mpModelWidget->endMacro();
   } else if (controlModifier && event->key() == Qt::Key_A) {
     selectAll();
   } else if (controlModifier && event->key() == Qt::Key_D && isAnyItemSelectedAndEditable(event->key())) {
@@ -1882,21 +1973,21 @@ void GraphicsView::keyPressEvent(QKeyEvent *event)
     emit keyPressDuplicate();
     mpModelWidget->getUndoStack()->endMacro();
   } else if (!shiftModifier && controlModifier && event->key() == Qt::Key_R && isAnyItemSelectedAndEditable(event->key())) {
-    mpModelWidget->getUndoStack()->beginMacro("Rotate clockwise by key press");
+    mpModelWidget->beginMacro("Rotate clockwise by key press");
     emit keyPressRotateClockwise();
-    mpModelWidget->getUndoStack()->endMacro();
+    mpModelWidget->endMacro();
   } else if (shiftModifier && controlModifier && event->key() == Qt::Key_R && isAnyItemSelectedAndEditable(event->key())) {
-    mpModelWidget->getUndoStack()->beginMacro("Rotate anti clockwise by key press");
+    mpModelWidget->beginMacro("Rotate anti clockwise by key press");
     emit keyPressRotateAntiClockwise();
-    mpModelWidget->getUndoStack()->endMacro();
+    mpModelWidget->endMacro();
   } else if (!shiftModifier && !controlModifier && event->key() == Qt::Key_H && isAnyItemSelectedAndEditable(event->key())) {
-    mpModelWidget->getUndoStack()->beginMacro("Flip horizontal by key press");
+    mpModelWidget->beginMacro("Flip horizontal by key press");
     emit keyPressFlipHorizontal();
-    mpModelWidget->getUndoStack()->endMacro();
+    mpModelWidget->endMacro();
   } else if (!shiftModifier && !controlModifier && event->key() == Qt::Key_V && isAnyItemSelectedAndEditable(event->key())) {
-    mpModelWidget->getUndoStack()->beginMacro("Flip vertical by key press");
+    mpModelWidget->beginMacro("Flip vertical by key press");
     emit keyPressFlipVertical();
-    mpModelWidget->getUndoStack()->endMacro();
+    mpModelWidget->endMacro();
   } else if (event->key() == Qt::Key_Escape && isCreatingConnection()) {
     removeCurrentConnection();
   } else {
@@ -3046,6 +3137,28 @@ void ModelWidget::updateModelText()
   pLibraryTreeModel->updateLibraryTreeItemClassText(mpLibraryTreeItem);
 }
 
+/*!
+ * \brief ModelWidget::beginMacro
+ * Starts an undo stack macro and batches the OMC component and connection updates made until ModelWidget::endMacro.
+ * So transforming many components is a single undo entry and a single OMC command.
+ * \param text - the text of the undo entry.
+ */
+void ModelWidget::beginMacro(const QString &text)
+{
+  mpModelWidgetContainer->getMainWindow()->getOMCProxy()->beginCommandsBatch();
+  mpUndoStack->beginMacro(text);
+}
+
+/*!
+ * \brief ModelWidget::endMacro
+ * Ends the undo stack macro and sends the batched OMC updates.
+ */
+void ModelWidget::endMacro()
+{
+  mpUndoStack->endMacro();
+  mpModelWidgetContainer->getMainWindow()->getOMCProxy()->endCommandsBatch();
+}
+
 /*!
  * \brief ModelWidget::updateModelicaTextManually
  * Updates the Parent Modelica class text after user has made changes manually in the text view.
@@ -3456,13 +3569,13 @@ void ModelWidget::removeInheritedClassConnections()
 void ModelWidget::getModelConnections()
 {
   MainWindow *pMainWindow = mpModelWidgetContainer->getMainWindow();
-  int connectionCount = pMainWindow->getOMCProxy()->getConnectionCount(mpLibraryTreeItem->getNameStructure());
-  for (int i = 1 ; i <= connectionCount ; i++) {
-    // get the connection from OMC
-    QString connectionString;
-    QStringList connectionList;
-    connectionString = pMainWindow->getOMCProxy()->getNthConnection(mpLibraryTreeItem->getNameStructure(), i);
-    connectionList = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(connectionString));
+  // get all the connections and their annotations from OMC in one go
+  QList<QStringList> connections;
+  QStringList connectionAnnotations;
+  pMainWindow->getOMCProxy()->getConnections(mpLibraryTreeItem->getNameStructure(), connections, connectionAnnotations);
+  for (int i = 0 ; i < connections.size() ; i++) {
+    QStringList connectionList = connections.at(i);
+    QString connectionString = QString("{%1}").arg(connectionList.join(","));
     // if the connectionString only contains two items then continue the loop,
     // because connection is not valid then
     if (connectionList.size() < 3) {
@@ -3542,9 +3655,8 @@ void ModelWidget::getModelConnections()
                                                                   Helper::scriptingKind, Helper::errorLevel));
       continue;
     }
-    // get the connector annotations from OMC
-    QString connectionAnnotationString = pMainWindow->getOMCProxy()->getNthConnectionAnnotation(mpLibraryTreeItem->getNameStructure(), i);
-    QStringList shapesList = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(connectionAnnotationString), '(', ')');
+    // parse the connector annotations
+    QStringList shapesList = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(connectionAnnotations.at(i)), '(', ')');
     // Now parse the shapes available in list
     QString lineShape = "";
     foreach (QString shape, shapesList) {
@@ -3558,8 +3670,42 @@ void ModelWidget::getModelConnections()
     pConnectionLineAnnotation = new LineAnnotation(lineShape, pStartConnectorComponent, pEndConnectorComponent, mpDiagramGraphicsView);
     pConnectionLineAnnotation->setStartComponentName(connectionList.at(0));
     pConnectionLineAnnotation->setEndComponentName(connectionList.at(1));
-    mpUndoStack->push(new AddConnectionCommand(pConnectionLineAnnotation, false));
+    /* Add the connection directly instead of pushing an AddConnectionCommand.
+     * The connections are only loaded here so there is nothing to undo.
+     */
+    addConnection(pConnectionLineAnnotation);
+  }
+}
+
+/*!
+ * \brief ModelWidget::addConnection
+ * Adds the connection loaded from OMC to the diagram GraphicsView.\n
+ * Does the same as AddConnectionCommand::redo() without adding the connection to the class.
+ * \param pConnectionLineAnnotation
+ */
+void ModelWidget::addConnection(LineAnnotation *pConnectionLineAnnotation)
+{
+  pConnectionLineAnnotation->setToolTip(QString("<b>connect</b>(%1, %2)").arg(pConnectionLineAnnotation->getStartComponentName())
+                                        .arg(pConnectionLineAnnotation->getEndComponentName()));
+  pConnectionLineAnnotation->drawCornerItems();
+  pConnectionLineAnnotation->setCornerItemsActiveOrPassive();
+  // Add the start component connection details.
+  Component *pStartComponent = pConnectionLineAnnotation->getStartComponent();
+  if (pStartComponent->getRootParentComponent()) {
+    pStartComponent->getRootParentComponent()->addConnectionDetails(pConnectionLineAnnotation);
+  } else {
+    pStartComponent->addConnectionDetails(pConnectionLineAnnotation);
+  }
+  // Add the end component connection details.
+  Component *pEndComponent = pConnectionLineAnnotation->getEndComponent();
+  if (pEndComponent->getRootParentComponent()) {
+    pEndComponent->getRootParentComponent()->addConnectionDetails(pConnectionLineAnnotation);
+  } else {
+    pEndComponent->addConnectionDetails(pConnectionLineAnnotation);
   }
+  mpDiagramGraphicsView->addConnectionToList(pConnectionLineAnnotation);
+  mpDiagramGraphicsView->addItem(pConnectionLineAnnotation);
+  pConnectionLineAnnotation->emitAdded();
 }
 
 /*!
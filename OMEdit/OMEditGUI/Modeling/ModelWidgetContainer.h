@@ -121,6 +121,23 @@ private:
   QAction *mpFlipHorizontalAction;
   QAction *mpFlipVerticalAction;
   QAction *mpAttributesAction;
+  /* grid lines cache. The lines cover mGridLinesRect and are sorted by their position. */
+  QRectF mGridLinesRect;
+  int mGridLinesHorizontalStep;
+  int mGridLinesVerticalStep;
+  int mFirstVerticalGridLine;
+  int mFirstHorizontalGridLine;
+  QVector<QLineF> mVerticalGridLines;
+  QVector<QLineF> mHorizontalGridLines;
+  /* paint time statistics in debug mode. */
+  int mPaintFrameCount;
+  int mPaintTime;
+  int mMaximumPaintTime;
+  QTime mPaintStatisticsTime;
+  /* connections re-routed once the pending events are processed. See GraphicsView::scheduleConnectionUpdate(). */
+  QList<QPointer<LineAnnotation> > mScheduledConnections;
+  QTimer mUpdateConnectionsTimer;
+  void updateGridLines(const QRectF &rect, int horizontalGridStep, int verticalGridStep);
 public:
   GraphicsView(StringHandler::ViewType viewType, ModelWidget *parent);
   CoOrdinateSystem mCoOrdinateSystem;
@@ -216,6 +233,7 @@ public:
   bool hasAnnotation();
   void addItem(QGraphicsItem *pGraphicsItem);
   void removeItem(QGraphicsItem *pGraphicsItem);
+  void scheduleConnectionUpdate(LineAnnotation *pConnectionLineAnnotation);
 private:
   void createActions();
   bool isClassDroppedOnItself(LibraryTreeItem *pLibraryTreeItem);
@@ -247,6 +265,7 @@ signals:
   void keyPressCtrlRight();
   void keyPressDuplicate();
 public slots:
+  void updateScheduledConnections();
   void addConnection(Component *pComponent);
   void removeCurrentConnection();
   void deleteConnection(LineAnnotation *pConnectionLineAnnotation);
@@ -269,6 +288,7 @@ protected:
   virtual void dragMoveEvent(QDragMoveEvent *event);
   virtual void dropEvent(QDropEvent *event);
   virtual void drawBackground(QPainter *painter, const QRectF &rect);
+  virtual void paintEvent(QPaintEvent *event);
   virtual void mousePressEvent(QMouseEvent *event);
   virtual void mouseMoveEvent(QMouseEvent *event);
   virtual void mouseReleaseEvent(QMouseEvent *event);
@@ -366,6 +386,8 @@ public:
   void clearSelection();
   void updateClassAnnotationIfNeeded();
   void updateModelText();
+  void beginMacro(const QString &text);
+  void endMacro();
   void updateModelicaTextManually(QString contents);
   void updateUndoRedoActions();
 private:
@@ -414,6 +436,7 @@ private:
   void drawModelInheritedClassConnections(ModelWidget *pModelWidget);
   void removeInheritedClassConnections();
   void getModelConnections();
+  void addConnection(LineAnnotation *pConnectionLineAnnotation);
   void getMetaModelSubModels();
   void getMetaModelConnections();
 private slots:
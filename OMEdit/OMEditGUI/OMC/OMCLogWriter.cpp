@@ -0,0 +1,217 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES RECIPIENT'S ACCEPTANCE
+ * OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3, ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+
+#include "OMCLogWriter.h"
+
+/* the text is written when this many characters are pending or at the latest after one second. */
+#define LOG_WRITER_BATCH_SIZE 65536
+#define LOG_WRITER_INTERVAL 1000
+/* OMCLogWriter::flush gives up after this many milliseconds since a crashed thread might hold the mutex. */
+#define LOG_WRITER_FLUSH_TIMEOUT 500
+
+/* the running log writer. Used by OMCLogWriter::flushAll from the crash handlers. */
+static OMCLogWriter *pRunningOMCLogWriter = 0;
+
+/*!
+ * \class OMCLogWriter
+ * \brief Writes the omeditcommunication.log and omeditcommands.mos files in a background thread.
+ */
+/*!
+ * \param pParent
+ */
+OMCLogWriter::OMCLogWriter(QObject *pParent)
+  : QThread(pParent), mPendingSize(0), mStop(false)
+{
+  for (int i = 0 ; i < LogFileCount ; i++) {
+    mMaximumSizes[i] = 0;
+    mOpened[i] = false;
+  }
+}
+
+/*!
+ * \brief OMCLogWriter::flushAll
+ * Writes the pending text of the running log writer right away.
+ * Called from the crash handlers so the log files attached to the crash report are complete.
+ */
+void OMCLogWriter::flushAll()
+{
+  if (pRunningOMCLogWriter) {
+    pRunningOMCLogWriter->flush();
+  }
+}
+
+/*!
+ * \brief OMCLogWriter::open
+ * Opens the log file. Must be called before the thread is started.
+ * \param logFile
+ * \param fileName
+ * \param maximumSize - the size in bytes after which the file is rotated. 0 means no limit.
+ * \return
+ */
+bool OMCLogWriter::open(LogFile logFile, const QString &fileName, qint64 maximumSize)
+{
+  mFiles[logFile].setFileName(fileName);
+  mMaximumSizes[logFile] = maximumSize;
+  mOpened[logFile] = mFiles[logFile].open(QIODevice::WriteOnly | QIODevice::Text);
+  if (mOpened[logFile]) {
+    pRunningOMCLogWriter = this;
+  }
+  return mOpened[logFile];
+}
+
+/*!
+ * \brief OMCLogWriter::write
+ * Queues the text for writing. Returns immediately.
+ * \param logFile
+ * \param text
+ */
+void OMCLogWriter::write(LogFile logFile, const QString &text)
+{
+  QMutexLocker locker(&mMutex);
+  if (!mOpened[logFile]) {
+    return;
+  }
+  mPendingText[logFile].append(text);
+  mPendingSize += text.size();
+  if (mPendingSize >= LOG_WRITER_BATCH_SIZE) {
+    mTextAvailable.wakeOne();
+  }
+}
+
+/*!
+ * \brief OMCLogWriter::flush
+ * Writes the pending text in the calling thread without waiting for the next batch.
+ * \return false if the text could not be written within LOG_WRITER_FLUSH_TIMEOUT.
+ */
+bool OMCLogWriter::flush()
+{
+  if (!mMutex.tryLock(LOG_WRITER_FLUSH_TIMEOUT)) {
+    return false;
+  }
+  if (!mFilesMutex.tryLock(LOG_WRITER_FLUSH_TIMEOUT)) {
+    mMutex.unlock();
+    return false;
+  }
+  QStringList text[LogFileCount];
+  for (int i = 0 ; i < LogFileCount ; i++) {
+    text[i].swap(mPendingText[i]);
+  }
+  mPendingSize = 0;
+  mMutex.unlock();
+  writeText(text);
+  mFilesMutex.unlock();
+  return true;
+}
+
+/*!
+ * \brief OMCLogWriter::stop
+ * Writes the pending text, stops the thread and closes the files.
+ */
+void OMCLogWriter::stop()
+{
+  mMutex.lock();
+  mStop = true;
+  for (int i = 0 ; i < LogFileCount ; i++) {
+    mOpened[i] = false;
+  }
+  if (pRunningOMCLogWriter == this) {
+    pRunningOMCLogWriter = 0;
+  }
+  mTextAvailable.wakeOne();
+  mMutex.unlock();
+  if (isRunning()) {
+    wait();
+  } else {
+    run();
+  }
+  for (int i = 0 ; i < LogFileCount ; i++) {
+    mFiles[i].close();
+  }
+}
+
+void OMCLogWriter::run()
+{
+  QStringList text[LogFileCount];
+  mMutex.lock();
+  forever {
+    if (!mStop && mPendingSize < LOG_WRITER_BATCH_SIZE) {
+      mTextAvailable.wait(&mMutex, LOG_WRITER_INTERVAL);
+    }
+    bool stop = mStop;
+    for (int i = 0 ; i < LogFileCount ; i++) {
+      text[i].swap(mPendingText[i]);
+    }
+    mPendingSize = 0;
+    // take the files mutex before releasing mMutex so OMCLogWriter::flush can't write newer text first.
+    mFilesMutex.lock();
+    mMutex.unlock();
+    writeText(text);
+    mFilesMutex.unlock();
+    if (stop) {
+      return;
+    }
+    mMutex.lock();
+  }
+}
+
+/*!
+ * \brief OMCLogWriter::writeText
+ * Writes and flushes the text of all log files. Called with the files mutex held.
+ * \param pText - array of LogFileCount lists. The lists are cleared.
+ */
+void OMCLogWriter::writeText(QStringList *pText)
+{
+  for (int i = 0 ; i < LogFileCount ; i++) {
+    if (pText[i].isEmpty()) {
+      continue;
+    }
+    QByteArray data = pText[i].join("").toUtf8();
+    pText[i].clear();
+    if (mMaximumSizes[i] > 0 && mFiles[i].size() > 0 && mFiles[i].size() + data.size() > mMaximumSizes[i]) {
+      rotate((LogFile)i);
+    }
+    mFiles[i].write(data);
+    mFiles[i].flush();
+  }
+}
+
+/*!
+ * \brief OMCLogWriter::rotate
+ * Renames the log file to <fileName>.1 and starts a new file.
+ * \param logFile
+ */
+void OMCLogWriter::rotate(LogFile logFile)
+{
+  QString fileName = mFiles[logFile].fileName();
+  mFiles[logFile].close();
+  QFile::remove(fileName + ".1");
+  QFile::rename(fileName, fileName + ".1");
+  mFiles[logFile].open(QIODevice::WriteOnly | QIODevice::Text);
+}
@@ -0,0 +1,78 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES RECIPIENT'S ACCEPTANCE
+ * OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3, ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+
+#ifndef OMCLOGWRITER_H
+#define OMCLOGWRITER_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QStringList>
+#include <QFile>
+
+/*!
+ * \class OMCLogWriter
+ * \brief Writes the omeditcommunication.log and omeditcommands.mos files in a background thread.\n
+ * The text is collected in memory and written in batches. A file that grows above its maximum size is renamed to
+ * <fileName>.1 and a new file is started.
+ */
+class OMCLogWriter : public QThread
+{
+  Q_OBJECT
+public:
+  enum LogFile {
+    CommunicationLog = 0,
+    CommandsLog = 1,
+    LogFileCount = 2
+  };
+  OMCLogWriter(QObject *pParent = 0);
+  bool open(LogFile logFile, const QString &fileName, qint64 maximumSize);
+  void write(LogFile logFile, const QString &text);
+  bool flush();
+  void stop();
+  static void flushAll();
+protected:
+  virtual void run();
+private:
+  QMutex mMutex;
+  QMutex mFilesMutex;
+  QWaitCondition mTextAvailable;
+  QStringList mPendingText[LogFileCount];
+  int mPendingSize;
+  QFile mFiles[LogFileCount];
+  qint64 mMaximumSizes[LogFileCount];
+  bool mOpened[LogFileCount];
+  bool mStop;
+
+  void writeText(QStringList *pText);
+  void rotate(LogFile logFile);
+};
+
+#endif // OMCLOGWRITER_H
@@ -59,9 +59,23 @@ void omc_Main_setWindowsPaths(threadData_t *threadData, void* _inOMHome);
 #include <iostream>
 
 #include "OMCProxy.h"
+#include "BatchMode.h"
 #include "simulation_options.h"
 #include "omc_error.h"
 
+/* the OMC Logger window keeps at most this many lines. */
+#define LOGGER_MAXIMUM_LINES 20000
+/* longer commands and responses are truncated in the OMC Logger window. */
+#define LOGGER_MAXIMUM_ENTRY_LENGTH 10000
+/* the number of truncated texts that can be expanded. */
+#define LOGGER_EXPANDABLE_ENTRIES 20
+/* the number of commands in the OMC Logger history. */
+#define COMMANDS_HISTORY_SIZE 1000
+/* omeditcommunication.log is rotated when it grows above this size. */
+#define LOG_FILE_MAXIMUM_SIZE (64 * 1024 * 1024)
+/* longer responses are truncated in omeditcommunication.log. */
+#define LOG_FILE_MAXIMUM_RESPONSE_LENGTH (256 * 1024)
+
 static QVariant parseExpression(QString result)
 {
   QVariant res;
@@ -93,8 +107,12 @@ static QVariant parseExpression(QString result)
   \param pMainWindow - pointer to MainWindow
   */
 OMCProxy::OMCProxy(MainWindow *pMainWindow)
-  : QObject(pMainWindow), mHasInitialized(false), mResult("")
+  : QObject(pMainWindow), mHasInitialized(false), mResult(""), mOMCMutex(QMutex::Recursive), mInterfaceLockDepth(0),
+    mCommandsBatchDepth(0)
 {
+  mpOMCWorkerThread = 0;
+  mpOMCLogWriter = 0;
+  mLastLoggerEntryId = 0;
   mpMainWindow = pMainWindow;
   mCurrentCommandIndex = -1;
   // OMC Commands Logger Widget
@@ -108,6 +126,8 @@ OMCProxy::OMCProxy(MainWindow *pMainWindow)
   mpOMCLoggerTextBox->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOn);
   mpOMCLoggerTextBox->setReadOnly(true);
   mpOMCLoggerTextBox->setLineWrapMode(QPlainTextEdit::WidgetWidth);
+  mpOMCLoggerTextBox->setMaximumBlockCount(LOGGER_MAXIMUM_LINES);
+  mpOMCLoggerTextBox->viewport()->installEventFilter(this);
   mpOMCLoggerEnableHintLabel = new Label(tr("* To enable OpenModelica Compiler CLI start OMEdit with argument --OMCLogger=true"));
   mpOMCLoggerEnableHintLabel->setFont(QFont(Helper::monospacedFontInfo.family()));
   mpExpressionTextBox = new CustomExpressionBox(this);
@@ -158,6 +178,9 @@ OMCProxy::OMCProxy(MainWindow *pMainWindow)
 
 OMCProxy::~OMCProxy()
 {
+  if (mpOMCLogWriter) {
+    mpOMCLogWriter->stop();
+  }
   delete mpOMCLoggerWidget;
   if (mpMainWindow->isDebug()) {
     delete mpOMCDiffWidget;
@@ -226,20 +249,12 @@ bool OMCProxy::initializeOMC()
 {
   /* create the tmp path */
   QString& tmpPath = OpenModelica::tempDirectory();
-  /* create a file to write OMEdit communication log */
-  mCommunicationLogFile.setFileName(QString("%1omeditcommunication.log").arg(tmpPath));
-  if (mCommunicationLogFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
-    mCommunicationLogFileTextStream.setDevice(&mCommunicationLogFile);
-    mCommunicationLogFileTextStream.setCodec(Helper::utf8.toStdString().data());
-    mCommunicationLogFileTextStream.setGenerateByteOrderMark(false);
-  }
-  /* create a file to write OMEdit commands */
-  mCommandsMosFile.setFileName(QString("%1omeditcommands.mos").arg(tmpPath));
-  if (mCommandsMosFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
-    mCommandsLogFileTextStream.setDevice(&mCommandsMosFile);
-    mCommandsLogFileTextStream.setCodec(Helper::utf8.toStdString().data());
-    mCommandsLogFileTextStream.setGenerateByteOrderMark(false);
-  }
+  /* create the files to write OMEdit communication log and OMEdit commands. The files are written in a background thread. */
+  mpOMCLogWriter = new OMCLogWriter(this);
+  mpOMCLogWriter->open(OMCLogWriter::CommunicationLog, QString("%1omeditcommunication.log").arg(tmpPath), LOG_FILE_MAXIMUM_SIZE);
+  // omeditcommands.mos is never rotated so it stays a complete script that can be replayed.
+  mpOMCLogWriter->open(OMCLogWriter::CommandsLog, QString("%1omeditcommands.mos").arg(tmpPath), 0);
+  mpOMCLogWriter->start(QThread::LowPriority);
   threadData_t *threadData = (threadData_t *) calloc(1, sizeof(threadData_t));
   void *st = 0;
   MMC_TRY_TOP_INTERNAL()
@@ -249,10 +264,15 @@ bool OMCProxy::initializeOMC()
   threadData->plotCB = MainWindow::PlotCallbackFunction;
   MMC_CATCH_TOP(return false;)
   mpOMCInterface = new OMCInterface(threadData, st);
-  connect(mpOMCInterface, SIGNAL(logCommand(QString,QTime*)), this, SLOT(logCommand(QString,QTime*)));
-  connect(mpOMCInterface, SIGNAL(logResponse(QString,QTime*)), this, SLOT(logResponse(QString,QTime*)));
+  connect(mpOMCInterface, SIGNAL(logCommand(QString,QTime*)), this, SLOT(interfaceCommandStarted(QString,QTime*)));
+  connect(mpOMCInterface, SIGNAL(logResponse(QString,QTime*)), this, SLOT(interfaceCommandFinished(QString,QTime*)));
   connect(mpOMCInterface, SIGNAL(throwException(QString)), SLOT(showException(QString)));
   mHasInitialized = true;
+  // start the worker thread for the asynchronous commands.
+  GC_allow_register_threads();
+  mpOMCWorkerThread = new OMCWorkerThread(this, &mOMCMutex);
+  connect(mpOMCWorkerThread, SIGNAL(commandFinished(OMCFuture)), SLOT(asyncCommandFinished(OMCFuture)));
+  mpOMCWorkerThread->start();
   // set the locale
   QSettings *pSettings = OpenModelica::getApplicationSettings();
   QLocale settingsLocale = QLocale(pSettings->value("language").toString());
@@ -283,9 +303,14 @@ bool OMCProxy::initializeOMC()
   */
 void OMCProxy::quitOMC()
 {
+  if (mpOMCWorkerThread) {
+    mpOMCWorkerThread->stop();
+    mpOMCWorkerThread->wait();
+  }
   sendCommand("quit()");
-  mCommunicationLogFile.close();
-  mCommandsMosFile.close();
+  if (mpOMCLogWriter) {
+    mpOMCLogWriter->stop();
+  }
 }
 
 /*!
@@ -302,35 +327,153 @@ void OMCProxy::sendCommand(const QString expression)
       return;
     }
   }
+  // the batched updates must reach OMC before any command that might read them.
+  if (!mBatchedCommands.isEmpty()) {
+    flushBatchedCommands();
+  }
+  QMutexLocker locker(&mOMCMutex);
   // write command to the commands log.
   QTime commandTime;
   commandTime.start();
   logCommand(expression, &commandTime);
-  // TODO: Call this in a thread that loops over received messages? Avoid MMC_TRY_TOP all the time, etc
+  if (!handleCommand(mpOMCInterface->threadData, expression, mResult)) {
+    if (expression == "quit()") {
+      return;
+    }
+    exitApplication();
+  }
+  logResponse(mResult.trimmed(), &commandTime);
+}
+
+/*!
+ * \brief OMCProxy::sendCommandAsync
+ * Queues the command for the OMCWorkerThread and returns immediately.\n
+ * Use it for the long running commands e.g., checkModel and instantiateModel so the GUI stays responsive.
+ * The result is delivered to the pReceiver member slot on the GUI thread. The slot must take an OMCFuture argument.\n
+ * Waiting for the returned future executes the command right away if it is not started yet.
+ * \param expression - the command to send.
+ * \param priority - the scheduling priority of the command.
+ * \param pReceiver - the object to notify. Can be 0.
+ * \param member - the slot of pReceiver given using the SLOT() macro.
+ * \return the future of the command.
+ */
+OMCFuture OMCProxy::sendCommandAsync(const QString &expression, OMCCommand::Priority priority, QObject *pReceiver, const char *member)
+{
+  if (!mHasInitialized) {
+    // if we are unable to start OMC. Exit the application.
+    if(!initializeOMC()) {
+      mpMainWindow->setExitApplicationStatus(true);
+      return OMCFuture();
+    }
+  }
+  if (!mBatchedCommands.isEmpty()) {
+    flushBatchedCommands();
+  }
+  return mpOMCWorkerThread->enqueue(expression, priority, pReceiver, member);
+}
+
+/*!
+ * \brief OMCProxy::beginCommandsBatch
+ * Starts batching the component and connection updates. The updates are queued instead of being sent one by one
+ * and are sent to OMC as a single command by OMCProxy::endCommandsBatch.\n
+ * Any other command sends the queued updates first so the batch never changes what OMC returns. Calls can be nested.
+ */
+void OMCProxy::beginCommandsBatch()
+{
+  mCommandsBatchDepth++;
+}
+
+/*!
+ * \brief OMCProxy::endCommandsBatch
+ * Ends the batch started with OMCProxy::beginCommandsBatch and sends the queued updates.
+ */
+void OMCProxy::endCommandsBatch()
+{
+  if (mCommandsBatchDepth > 0) {
+    mCommandsBatchDepth--;
+  }
+  if (mCommandsBatchDepth == 0 && !mBatchedCommands.isEmpty()) {
+    flushBatchedCommands();
+  }
+}
+
+/*!
+ * \brief OMCProxy::batchCommand
+ * Queues the expression if a batch is started. A queued expression with the same key is replaced.
+ * \param key - identifies what the expression updates.
+ * \param expression
+ * \return true if the expression is queued.
+ */
+bool OMCProxy::batchCommand(const QString &key, const QString &expression)
+{
+  if (mCommandsBatchDepth == 0) {
+    return false;
+  }
+  QHash<QString, int>::const_iterator iterator = mBatchedCommandsIndexes.constFind(key);
+  if (iterator != mBatchedCommandsIndexes.constEnd()) {
+    mBatchedCommands[iterator.value()] = expression;
+  } else {
+    mBatchedCommandsIndexes.insert(key, mBatchedCommands.size());
+    mBatchedCommands.append(expression);
+  }
+  return true;
+}
+
+/*!
+ * \brief OMCProxy::flushBatchedCommands
+ * Sends the queued expressions to OMC as one command.
+ */
+void OMCProxy::flushBatchedCommands()
+{
+  QStringList commands = mBatchedCommands;
+  mBatchedCommands.clear();
+  mBatchedCommandsIndexes.clear();
+  sendCommand(commands.join("; "));
+}
+
+/*!
+ * \brief OMCProxy::handleCommand
+ * Sends the expression to OMC using the given threadData.\n
+ * Used by the GUI thread and the OMCWorkerThread. The caller must hold the OMC mutex. Doesn't touch any widget.
+ * \param threadData - the threadData of the calling thread.
+ * \param expression - the command to send.
+ * \param result - set to the OMC reply.
+ * \return false if OMC is unable to handle the command.
+ */
+bool OMCProxy::handleCommand(threadData_t *threadData, const QString &expression, QString &result)
+{
+  bool success = true;
   void *reply_str = NULL;
-  threadData_t *threadData = mpOMCInterface->threadData;
 
   MMC_TRY_TOP_INTERNAL()
 
   MMC_TRY_STACK()
 
   if (!omc_Main_handleCommand(threadData, mmc_mk_scon(expression.toStdString().c_str()), mpOMCInterface->st, &reply_str, &mpOMCInterface->st)) {
-    if (expression == "quit()") {
-      return;
-    }
-    exitApplication();
+    success = false;
+  } else {
+    result = MMC_STRINGDATA(reply_str);
   }
-  mResult = MMC_STRINGDATA(reply_str);
-  logResponse(mResult.trimmed(), &commandTime);
 
   MMC_ELSE()
-    mResult = "";
+    result = "";
     fprintf(stderr, "Stack overflow detected and was not caught.\nSend us a bug report at https://trac.openmodelica.org/OpenModelica/newticket\n    Include the following trace:\n");
     printStacktraceMessages();
     fflush(NULL);
   MMC_CATCH_STACK()
 
-  MMC_CATCH_TOP(mResult = "");
+  MMC_CATCH_TOP(result = "");
+  return success;
+}
+
+/*!
+ * \brief OMCProxy::getThreadData
+ * Returns the threadData of the GUI thread.
+ * \return
+ */
+threadData_t* OMCProxy::getThreadData()
+{
+  return mpOMCInterface->threadData;
 }
 
 /*!
@@ -352,78 +495,207 @@ QString OMCProxy::getResult()
 }
 
 /*!
-  Writes OMC command in OMC Logger window.
-  Writes the command to the omeditcommunication.log file.
-  Writes the command to the omeditcommands.mos file.
-  \param command - the command to write
-  \param commandTime - the command start time
-  */
-void OMCProxy::logCommand(QString command, QTime *commandTime)
+ * \brief OMCProxy::addLoggerText
+ * Adds the text at the end of the OMC Logger window.\n
+ * Long texts are truncated. The last few truncated texts can be expanded by double clicking them.
+ * \param text
+ * \param suffix - added after the text.
+ * \param weight - the font weight.
+ */
+void OMCProxy::addLoggerText(const QString &text, const QString &suffix, QFont::Weight weight)
 {
   // move the cursor down before adding to the logger.
   QTextCursor textCursor = mpOMCLoggerTextBox->textCursor();
   textCursor.movePosition(QTextCursor::End);
   mpOMCLoggerTextBox->setTextCursor(textCursor);
-  // add the expression to commands list
-  mCommandsList.append(command);
-  // log expression
-  QFont font(Helper::monospacedFontInfo.family(), Helper::monospacedFontInfo.pointSize() - 2, QFont::Bold, false);
+  QFont font(Helper::monospacedFontInfo.family(), Helper::monospacedFontInfo.pointSize() - 2, weight, false);
   QTextCharFormat charFormat = mpOMCLoggerTextBox->currentCharFormat();
   charFormat.setFont(font);
   mpOMCLoggerTextBox->setCurrentCharFormat(charFormat);
-  mpOMCLoggerTextBox->insertPlainText(command + "\n");
+  if (text.size() > LOGGER_MAXIMUM_ENTRY_LENGTH) {
+    // cut at a line end so that the expanded text continues exactly where the truncated text stops.
+    int length = text.lastIndexOf('\n', LOGGER_MAXIMUM_ENTRY_LENGTH);
+    if (length <= 0) {
+      length = LOGGER_MAXIMUM_ENTRY_LENGTH;
+    }
+    mpOMCLoggerTextBox->insertPlainText(text.left(length) + "\n");
+    int id = ++mLastLoggerEntryId;
+    mTruncatedLoggerEntries.insert(id, text.mid(text.at(length) == '\n' ? length + 1 : length));
+    mTruncatedLoggerEntriesQueue.enqueue(id);
+    if (mTruncatedLoggerEntriesQueue.size() > LOGGER_EXPANDABLE_ENTRIES) {
+      mTruncatedLoggerEntries.remove(mTruncatedLoggerEntriesQueue.dequeue());
+    }
+    textCursor = mpOMCLoggerTextBox->textCursor();
+    textCursor.block().setUserState(id);
+    mpOMCLoggerTextBox->insertPlainText(tr("... %1 more characters. Double click to show them.").arg(text.size() - length) + suffix);
+  } else {
+    mpOMCLoggerTextBox->insertPlainText(text + suffix);
+  }
   // move the cursor
   textCursor.movePosition(QTextCursor::End);
   mpOMCLoggerTextBox->setTextCursor(textCursor);
+}
+
+/*!
+ * \brief OMCProxy::expandLoggerEntry
+ * Replaces the truncation note at position with the rest of the truncated text.
+ * \param position - the position in the OMC Logger viewport.
+ * \return true if a truncated text is expanded.
+ */
+bool OMCProxy::expandLoggerEntry(const QPoint &position)
+{
+  QTextBlock block = mpOMCLoggerTextBox->cursorForPosition(position).block();
+  QHash<int, QString>::iterator iterator = mTruncatedLoggerEntries.find(block.userState());
+  if (!block.isValid() || iterator == mTruncatedLoggerEntries.end()) {
+    return false;
+  }
+  QString text = iterator.value();
+  mTruncatedLoggerEntries.erase(iterator);
+  block.setUserState(-1);
+  QTextCursor textCursor(block);
+  textCursor.movePosition(QTextCursor::EndOfBlock, QTextCursor::KeepAnchor);
+  textCursor.insertText(text);
+  return true;
+}
+
+/*!
+ * \brief OMCProxy::eventFilter
+ * Expands the truncated texts of the OMC Logger on double click.
+ * \param pObject
+ * \param pEvent
+ * \return
+ */
+bool OMCProxy::eventFilter(QObject *pObject, QEvent *pEvent)
+{
+  if (pObject == mpOMCLoggerTextBox->viewport() && pEvent->type() == QEvent::MouseButtonDblClick) {
+    QMouseEvent *pMouseEvent = static_cast<QMouseEvent*>(pEvent);
+    if (expandLoggerEntry(pMouseEvent->pos())) {
+      return true;
+    }
+  }
+  return QObject::eventFilter(pObject, pEvent);
+}
+
+/*!
+  Writes OMC command in OMC Logger window.
+  Writes the command to the omeditcommunication.log file.
+  Writes the command to the omeditcommands.mos file.
+  \param command - the command to write
+  \param commandTime - the command start time
+  */
+void OMCProxy::logCommand(QString command, QTime *commandTime)
+{
+  // add the expression to commands list
+  mCommandsList.append(command);
+  if (mCommandsList.size() > COMMANDS_HISTORY_SIZE) {
+    mCommandsList.removeFirst();
+  }
+  // log expression
+  addLoggerText(command, "\n", QFont::Bold);
   // set the current command index.
   mCurrentCommandIndex = mCommandsList.count();
   mpExpressionTextBox->setText("");
-  // write the log to communication log file
-  if (mCommunicationLogFileTextStream.device()) {
-    mCommunicationLogFileTextStream << command << " " << commandTime->currentTime().toString("hh:mm:ss:zzz");
-    mCommunicationLogFileTextStream << "\n";
-    mCommunicationLogFileTextStream.flush();
+  if (!mpOMCLogWriter) {
+    return;
   }
+  // write the log to communication log file
+  mpOMCLogWriter->write(OMCLogWriter::CommunicationLog, command + " " + commandTime->currentTime().toString("hh:mm:ss:zzz") + "\n");
   // write commands mos file
-  if (mCommandsLogFileTextStream.device()) {
-    if (command.compare("quit()") == 0) {
-      mCommandsLogFileTextStream << command << ";\n";
-    } else {
-      mCommandsLogFileTextStream << command << "; getErrorString();\n";
-    }
-    mCommandsLogFileTextStream.flush();
+  if (command.compare("quit()") == 0) {
+    mpOMCLogWriter->write(OMCLogWriter::CommandsLog, command + ";\n");
+  } else {
+    mpOMCLogWriter->write(OMCLogWriter::CommandsLog, command + "; getErrorString();\n");
   }
 }
 
 /*!
   Writes OMC response in OMC Logger window.
   Writes the response to the omeditcommunication.log file.
-  Writes the response to the omeditcommands.mos file.
+  Very long responses are truncated in the log file unless OMEdit is started in debug mode.
   \param response - the response to write
   \param commandTime - the command start time
   */
 void OMCProxy::logResponse(QString response, QTime *responseTime)
 {
-  // move the cursor down before adding to the logger.
-  QTextCursor textCursor = mpOMCLoggerTextBox->textCursor();
-  textCursor.movePosition(QTextCursor::End);
-  mpOMCLoggerTextBox->setTextCursor(textCursor);
   // log expression
-  QFont font(Helper::monospacedFontInfo.family(), Helper::monospacedFontInfo.pointSize() - 2, QFont::Normal, false);
-  QTextCharFormat charFormat = mpOMCLoggerTextBox->currentCharFormat();
-  charFormat.setFont(font);
-  mpOMCLoggerTextBox->setCurrentCharFormat(charFormat);
-  mpOMCLoggerTextBox->insertPlainText(response + "\n\n");
-  // move the cursor
-  textCursor.movePosition(QTextCursor::End);
-  mpOMCLoggerTextBox->setTextCursor(textCursor);
+  addLoggerText(response, "\n\n", QFont::Normal);
   // write the log to communication log file
-  if (mCommunicationLogFileTextStream.device()) {
-    mCommunicationLogFileTextStream << response << " " << responseTime->currentTime().toString("hh:mm:ss:zzz");
-    mCommunicationLogFileTextStream << "\n";
-    mCommunicationLogFileTextStream << "Elapsed Time :: " << QString::number((double)responseTime->elapsed() / 1000).append(" secs");
-    mCommunicationLogFileTextStream << "\n\n";
-    mCommunicationLogFileTextStream.flush();
+  if (mpOMCLogWriter) {
+    QString text = response;
+    if (!mpMainWindow->isDebug() && text.size() > LOG_FILE_MAXIMUM_RESPONSE_LENGTH) {
+      text = text.left(LOG_FILE_MAXIMUM_RESPONSE_LENGTH) + QString(" ... [%1 characters truncated]").arg(response.size() - LOG_FILE_MAXIMUM_RESPONSE_LENGTH);
+    }
+    mpOMCLogWriter->write(OMCLogWriter::CommunicationLog, text + " " + responseTime->currentTime().toString("hh:mm:ss:zzz") + "\n"
+                          + "Elapsed Time :: " + QString::number((double)responseTime->elapsed() / 1000).append(" secs") + "\n\n");
+  }
+}
+
+/*!
+ * \brief OMCProxy::interfaceCommandStarted
+ * Slot activated when OMCInterface starts a command.\n
+ * Locks the OMC mutex so that the OMCWorkerThread doesn't run a command at the same time.
+ * \param command
+ * \param commandTime
+ * \see OMCProxy::interfaceCommandFinished
+ */
+void OMCProxy::interfaceCommandStarted(QString command, QTime *commandTime)
+{
+  if (!mBatchedCommands.isEmpty()) {
+    flushBatchedCommands();
+  }
+  mOMCMutex.lock();
+  mInterfaceLockDepth++;
+  logCommand(command, commandTime);
+}
+
+/*!
+ * \brief OMCProxy::interfaceCommandFinished
+ * Slot activated when OMCInterface finishes a command. Unlocks the OMC mutex.
+ * \param response
+ * \param responseTime
+ */
+void OMCProxy::interfaceCommandFinished(QString response, QTime *responseTime)
+{
+  logResponse(response, responseTime);
+  releaseInterfaceLock();
+}
+
+/*!
+ * \brief OMCProxy::releaseInterfaceLock
+ * Unlocks the OMC mutex locked by OMCProxy::interfaceCommandStarted.
+ * \see OMCProxy::interfaceCommandFinished
+ * \see OMCProxy::showException
+ */
+void OMCProxy::releaseInterfaceLock()
+{
+  if (mInterfaceLockDepth > 0) {
+    mInterfaceLockDepth--;
+    mOMCMutex.unlock();
+  }
+}
+
+/*!
+ * \brief OMCProxy::asyncCommandFinished
+ * Slot activated when OMCWorkerThread finishes a command.\n
+ * Logs the command and its response, shows the messages of the command and notifies the receiver of the command.
+ * \param future
+ */
+void OMCProxy::asyncCommandFinished(OMCFuture future)
+{
+  OMCCommand *pCommand = future.mpCommand.data();
+  // logCommand clears the expression box. Don't lose what the user is typing.
+  QString expressionText = mpExpressionTextBox->text();
+  logCommand(pCommand->mExpression, &pCommand->mCommandTime);
+  logResponse(future.getResult(), &pCommand->mCommandTime);
+  mpExpressionTextBox->setText(expressionText);
+  if (!future.isSuccessful()) {
+    QString msg = tr("OpenModelica Compiler is unable to handle the command <b>%1</b>").arg(pCommand->mExpression);
+    MessageItem messageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0, msg, Helper::scriptingKind, Helper::errorLevel);
+    mpMainWindow->getMessagesWidget()->addGUIMessage(messageItem);
+  }
+  printErrorString(StringHandler::unparse(future.getErrorString()));
+  if (pCommand->mpReceiver && !pCommand->mMember.isEmpty()) {
+    QMetaObject::invokeMethod(pCommand->mpReceiver, pCommand->mMember.constData(), Qt::DirectConnection, Q_ARG(OMCFuture, future));
   }
 }
 
@@ -433,6 +705,8 @@ void OMCProxy::logResponse(QString response, QTime *responseTime)
  */
 void OMCProxy::showException(QString exception)
 {
+  // a failed OMCInterface command emits throwException instead of logResponse. Unlock what interfaceCommandStarted locked.
+  releaseInterfaceLock();
   MessageItem messageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0, exception, Helper::scriptingKind, Helper::errorLevel);
   mpMainWindow->getMessagesWidget()->addGUIMessage(messageItem);
   printMessagesStringInternal();
@@ -494,9 +768,15 @@ void OMCProxy::removeObjectRefFile()
 void OMCProxy::exitApplication()
 {
   removeObjectRefFile();
-  QMessageBox::critical(mpMainWindow, QString(Helper::applicationName).append(" - ").append(Helper::error),
-                        QString(tr("Connection with the OpenModelica Compiler has been lost."))
-                        .append("\n\n").append(Helper::applicationName).append(" will close."), Helper::ok);
+  QString message = QString(tr("Connection with the OpenModelica Compiler has been lost."))
+      .append("\n\n").append(Helper::applicationName).append(" will close.");
+  if (mpMainWindow->isBatch()) {
+    BatchMode::printError(message);
+  } else {
+    QMessageBox::critical(mpMainWindow, QString(Helper::applicationName).append(" - ").append(Helper::error), message, Helper::ok);
+  }
+  // exit() doesn't destroy the OMCLogWriter so write the pending log text now.
+  OMCLogWriter::flushAll();
   exit(EXIT_FAILURE);
 }
 
@@ -533,6 +813,45 @@ bool OMCProxy::printMessagesStringInternal()
   return returnValue;
 }
 
+/*!
+ * \brief OMCProxy::printErrorString
+ * Adds the messages of a getErrorString() result to the Messages Window.\n
+ * Used for the commands executed by the OMCWorkerThread since their messages are not in the error buffer of the GUI thread.
+ * Each message starts with an optional "[file:lineStart:columnStart-lineEnd:columnEnd:readonly|writable]" and its level.
+ * The lines that don't start a message belong to the previous message.
+ * \param errorString - the unparsed getErrorString() result.
+ * \return true if there are any messages.
+ */
+bool OMCProxy::printErrorString(const QString &errorString)
+{
+  QRegExp messageRegExp("^(\\[(.*):(\\d+):(\\d+)-(\\d+):(\\d+):(readonly|writable)\\] )?(\\w+ )?(Error|Warning|Notification): (.*)$");
+  QStringList kinds;
+  kinds << "syntax" << "grammar" << "translation" << "symbolic" << "simulation" << "scripting";
+  QList<MessageItem> messageItems;
+  foreach (QString line, errorString.split("\n", QString::SkipEmptyParts)) {
+    if (messageRegExp.exactMatch(line)) {
+      QString kind = messageRegExp.cap(8).trimmed().toLower();
+      if (!kinds.contains(kind)) {
+        kind = "scripting";
+      }
+      QString level = messageRegExp.cap(9).toLower();
+      QString fileName = messageRegExp.cap(2).compare("<interactive>") == 0 ? "" : messageRegExp.cap(2);
+      messageItems.append(MessageItem(MessageItem::Modelica, fileName, messageRegExp.cap(7).compare("readonly") == 0,
+                                      messageRegExp.cap(3).toInt(), messageRegExp.cap(4).toInt(), messageRegExp.cap(5).toInt(),
+                                      messageRegExp.cap(6).toInt(), messageRegExp.cap(10), ".OpenModelica.Scripting.ErrorKind." + kind,
+                                      ".OpenModelica.Scripting.ErrorLevel." + level));
+    } else if (!messageItems.isEmpty()) {
+      messageItems.last().mMessage.append("\n").append(line);
+    } else {
+      messageItems.append(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0, line, Helper::scriptingKind, Helper::errorLevel));
+    }
+  }
+  foreach (MessageItem messageItem, messageItems) {
+    mpMainWindow->getMessagesWidget()->addGUIMessage(messageItem);
+  }
+  return !messageItems.isEmpty();
+}
+
 /*!
   Retrieves the list of errors from OMC
   \return size of errors
@@ -789,7 +1108,80 @@ QStringList OMCProxy::searchClassNames(QString searchText, bool findInText)
 OMCInterface::getClassInformation_res OMCProxy::getClassInformation(QString className)
 {
   OMCInterface::getClassInformation_res classInformation = mpOMCInterface->getClassInformation(className);
-  QString comment = classInformation.comment.replace("\\\"", "\"");
+  classInformation.comment = makeClassComment(classInformation.comment);
+  return classInformation;
+}
+
+/*!
+ * \brief OMCProxy::getClassesInformation
+ * Gets the information about the class and all its nested classes using just two OMC calls.\n
+ * The class names are retrieved using getClassNames and the information of all of them using one getClassInformation array expression
+ * over the retrieved names. Both lists are in the same order. The first entry is the class itself.
+ * \param className - is the name of the class whose nested classes information is retrieved.
+ * \param classNames - set to the qualified names of the classes.
+ * \param classesInformation - set to the information of the classes.
+ * \return false if the bulk reply could not be parsed. The caller should then use getClassInformation for each class.
+ */
+bool OMCProxy::getClassesInformation(QString className, QStringList &classNames, QList<OMCInterface::getClassInformation_res> &classesInformation)
+{
+  classNames = getClassNames(className, true, true);
+  if (classNames.isEmpty()) {
+    return false;
+  }
+  // reuse the names instead of calling getClassNames again in the array expression.
+  sendCommand(QString("{getClassInformation(cl) for cl in {%1}}").arg(classNames.join(", ")));
+  QVariantList classesList = parseExpression(getResult()).toList();
+  if (classesList.size() != classNames.size()) {
+    classNames.clear();
+    return false;
+  }
+  classesInformation.clear();
+  classesInformation.reserve(classesList.size());
+  foreach (QVariant classVariant, classesList) {
+    QVariantList list = classVariant.toList();
+    // the fields are in the order of the getClassInformation record.
+    if (list.size() < 16) {
+      classNames.clear();
+      classesInformation.clear();
+      return false;
+    }
+    OMCInterface::getClassInformation_res classInformation;
+    classInformation.restriction = StringHandler::unparse(list.at(0).toString());
+    classInformation.comment = makeClassComment(StringHandler::unparse(list.at(1).toString()));
+    classInformation.partialPrefix = list.at(2).toBool();
+    classInformation.finalPrefix = list.at(3).toBool();
+    classInformation.encapsulatedPrefix = list.at(4).toBool();
+    classInformation.fileName = StringHandler::unparse(list.at(5).toString());
+    classInformation.fileReadOnly = list.at(6).toBool();
+    classInformation.lineNumberStart = list.at(7).toInt();
+    classInformation.columnNumberStart = list.at(8).toInt();
+    classInformation.lineNumberEnd = list.at(9).toInt();
+    classInformation.columnNumberEnd = list.at(10).toInt();
+    foreach (QVariant dimension, list.at(11).toList()) {
+      classInformation.dimensions.append(StringHandler::unparse(dimension.toString()));
+    }
+    classInformation.isProtectedClass = list.at(12).toBool();
+    classInformation.isDocumentationClass = list.at(13).toBool();
+    classInformation.version = StringHandler::unparse(list.at(14).toString());
+    classInformation.preferredView = StringHandler::unparse(list.at(15).toString());
+    classesInformation.append(classInformation);
+  }
+  return true;
+}
+
+/*!
+ * \brief OMCProxy::makeClassComment
+ * Converts the class comment into a form usable as a tooltip.\n
+ * The comment is only parsed as HTML when it contains a modelica:// link.
+ * \param comment
+ * \return
+ */
+QString OMCProxy::makeClassComment(QString comment)
+{
+  comment = comment.replace("\\\"", "\"");
+  if (!comment.contains("modelica://")) {
+    return comment;
+  }
   comment = makeDocumentationUriToFileName(comment);
   // since tooltips can't handle file:// scheme so we have to remove it in order to display images and make links work.
 #ifdef WIN32
@@ -797,8 +1189,7 @@ OMCInterface::getClassInformation_res OMCProxy::getClassInformation(QString clas
 #else
   comment.replace("src=\"file://", "src=\"");
 #endif
-  classInformation.comment = comment;
-  return classInformation;
+  return comment;
 }
 
 /*!
@@ -1179,6 +1570,81 @@ QString OMCProxy::getNthConnectionAnnotation(QString className, int num)
   return getResult();
 }
 
+/*!
+ * \brief splitArrayResult
+ * Splits an OMC array result into the text of its elements. The nested braces, parentheses and strings are kept as they are.
+ * \param result - the OMC result.
+ * \param elements - set to the elements.
+ * \return false if the result is not an array.
+ */
+static bool splitArrayResult(QString result, QStringList &elements)
+{
+  elements.clear();
+  result = result.trimmed();
+  if (!result.startsWith("{") || !result.endsWith("}")) {
+    return false;
+  }
+  result = StringHandler::removeFirstLastCurlBrackets(result).trimmed();
+  if (!result.isEmpty()) {
+    elements = StringHandler::getStrings(result);
+  }
+  return true;
+}
+
+/*!
+ * \brief OMCProxy::getConnections
+ * Returns all the connections of a model together with their annotations.\n
+ * Uses one array expression for the connections and one for the annotations instead of 2N separate commands.
+ * The statements of a "; " separated command don't return their results so they can't be used here.
+ * Falls back to the per connection commands if OMC can't evaluate the array expressions.
+ * \param className - is the name of the model.
+ * \param connections - the list of connections. Each connection is the list returned by StringHandler::getStrings.
+ * \param connectionAnnotations - the list of connection annotations.
+ * \return true if the connections are fetched.
+ */
+bool OMCProxy::getConnections(QString className, QList<QStringList> &connections, QStringList &connectionAnnotations)
+{
+  connections.clear();
+  connectionAnnotations.clear();
+  QString rangeExpression = QString("1:getConnectionCount(%1)").arg(className);
+  QStringList connectionsList, annotationsList;
+  sendCommand(QString("{getNthConnection(%1, i) for i in %2}").arg(className, rangeExpression));
+  bool batched = splitArrayResult(getResult(), connectionsList);
+  if (batched) {
+    sendCommand(QString("{getNthConnectionAnnotation(%1, i) for i in %2}").arg(className, rangeExpression));
+    batched = splitArrayResult(getResult(), annotationsList) && annotationsList.size() == connectionsList.size();
+  }
+  if (!batched) {
+    // discard the errors of the array expressions and fetch each connection separately.
+    getErrorString();
+    connectionsList.clear();
+    annotationsList.clear();
+    int connectionCount = getConnectionCount(className);
+    for (int i = 1 ; i <= connectionCount ; i++) {
+      connectionsList.append(getNthConnection(className, i));
+      annotationsList.append(getNthConnectionAnnotation(className, i));
+    }
+  }
+#ifndef QT_NO_DEBUG
+  else {
+    // check the batched results against the per connection commands.
+    for (int i = 0 ; i < connectionsList.size() ; i++) {
+      if (StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(connectionsList.at(i).trimmed())) !=
+          StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(getNthConnection(className, i + 1).trimmed())) ||
+          annotationsList.at(i).trimmed().compare(getNthConnectionAnnotation(className, i + 1).trimmed()) != 0) {
+        qDebug() << "OMCProxy::getConnections: the batched result of connection" << i + 1 << "of" << className << "differs.";
+      }
+    }
+  }
+#endif
+  // parse all the connections and annotations.
+  for (int i = 0 ; i < connectionsList.size() ; i++) {
+    connections.append(StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(connectionsList.at(i).trimmed())));
+    connectionAnnotations.append(annotationsList.at(i).trimmed());
+  }
+  return true;
+}
+
 /*!
  * \brief OMCProxy::getInheritanceCount
  * Returns the inheritance count of a model.
@@ -1246,10 +1712,12 @@ QList<ComponentInfo*> OMCProxy::getComponents(QString className)
   sendCommand(expression);
   QString result = getResult();
   QList<ComponentInfo*> componentInfoList;
-  QStringList list = StringHandler::unparseArrays(result);
+  // tokenize the result once and parse the components from the tree.
+  OMCValueTree resultTree(result);
+  OMCValueTree::Node list = resultTree.at(0);
 
   for (int i = 0 ; i < list.size() ; i++) {
-    if (list.at(i) == "Error") {
+    if (!list.at(i).isArray()) {
       continue;
     }
     ComponentInfo *pComponentInfo = new ComponentInfo();
@@ -1655,6 +2123,67 @@ QString OMCProxy::diffModelicaFileListings(QString before, QString after)
   return result;
 }
 
+/*!
+ * \brief OMCProxy::reloadFileTextAsync
+ * Queues the regeneration of the text of the file on the OMCWorkerThread.\n
+ * listFile, diffModelicaFileListings and loadString run as one command so no other command can modify the class in between.
+ * \param className - the name of the top most class of the file.
+ * \param before - the current text of the file.
+ * \param fileName - the file name of the class.
+ * \param pReceiver - the object to notify.
+ * \param member - the slot of pReceiver. Use OMCProxy::getReloadFileTextResult in it.
+ * \return the future of the command.
+ * \sa OMCProxy::listFile()
+ * \sa OMCProxy::diffModelicaFileListings()
+ */
+OMCFuture OMCProxy::reloadFileTextAsync(QString className, QString before, QString fileName, QObject *pReceiver, const char *member)
+{
+  QString expression = QString("OMEdit_listFile_result:=listFile(%1); ").arg(className);
+  // only use the diffModelicaFileListings when preserve text indentation settings is true
+  if (mpMainWindow->getOptionsDialog()->getModelicaEditorPage()->getPreserveTextIndentationCheckBox()->isChecked()) {
+    expression += QString("OMEdit_diff_result:=diffModelicaFileListings(\"%1\", OMEdit_listFile_result, OpenModelica.Scripting.DiffFormat.plain); ")
+        .arg(StringHandler::escapeString(before));
+    // use omc pretty-printing if diffModelicaFileListings() fails.
+    expression += "OMEdit_diff_result:=if OMEdit_diff_result == \"\" then OMEdit_listFile_result else OMEdit_diff_result; ";
+  } else {
+    expression += "OMEdit_diff_result:=OMEdit_listFile_result; ";
+  }
+  expression += QString("loadString(OMEdit_diff_result, \"%1\", \"%2\", false); ").arg(StringHandler::escapeString(fileName), Helper::utf8);
+  // only the result of the last command is returned.
+  expression += "{OMEdit_listFile_result, OMEdit_diff_result}";
+  return sendCommandAsync(expression, OMCCommand::Background, pReceiver, member);
+}
+
+/*!
+ * \brief OMCProxy::getReloadFileTextResult
+ * Returns the regenerated text of OMCProxy::reloadFileTextAsync.
+ * \param future
+ * \param before - the text passed to OMCProxy::reloadFileTextAsync.
+ * \return the text of the file or an empty string if the command failed.
+ */
+QString OMCProxy::getReloadFileTextResult(const OMCFuture &future, QString before)
+{
+  if (future.isCancelled() || !future.isSuccessful()) {
+    return "";
+  }
+  QString result = future.getResult().trimmed();
+  if (!result.startsWith("{")) {
+    return "";
+  }
+  QStringList results = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(result));
+  if (results.size() != 2) {
+    return "";
+  }
+  QString after = StringHandler::unparse(results.at(0));
+  QString contents = StringHandler::unparse(results.at(1));
+  if (mpMainWindow->isDebug()) {
+    mpOMCDiffBeforeTextBox->setPlainText(before);
+    mpOMCDiffAfterTextBox->setPlainText(after);
+    mpOMCDiffMergedTextBox->setPlainText(contents);
+  }
+  return contents;
+}
+
 /*!
  * \brief OMCProxy::addClassAnnotation
  * Adds annotation to the class.
@@ -1759,7 +2288,11 @@ bool OMCProxy::renameComponent(QString className, QString oldName, QString newNa
   */
 bool OMCProxy::updateComponent(QString name, QString className, QString componentName, QString placementAnnotation)
 {
-  sendCommand("updateComponent(" + name + "," + className + "," + componentName + "," + placementAnnotation + ")");
+  QString expression = "updateComponent(" + name + "," + className + "," + componentName + "," + placementAnnotation + ")";
+  if (batchCommand(QString("updateComponent %1 %2").arg(componentName, name), expression)) {
+    return true;
+  }
+  sendCommand(expression);
   if (StringHandler::unparseBool(getResult()))
     return true;
   else
@@ -1793,7 +2326,11 @@ bool OMCProxy::renameComponentInClass(QString className, QString oldName, QStrin
   */
 bool OMCProxy::updateConnection(QString from, QString to, QString className, QString annotation)
 {
-  sendCommand("updateConnection(" + from + "," + to + "," + className + "," + annotation + ")");
+  QString expression = "updateConnection(" + from + "," + to + "," + className + "," + annotation + ")";
+  if (batchCommand(QString("updateConnection %1 %2 %3").arg(className, from, to), expression)) {
+    return true;
+  }
+  sendCommand(expression);
   if (getResult().contains("Ok"))
     return true;
   else
@@ -2035,6 +2572,49 @@ QString OMCProxy::instantiateModel(QString className)
   return result;
 }
 
+/*!
+ * \brief OMCProxy::checkModelAsync
+ * Queues the model check on the OMCWorkerThread.
+ * \param className - the name of the class.
+ * \param recursive - checks all nested classes if true.
+ * \param pReceiver - the object to notify.
+ * \param member - the slot of pReceiver. Use OMCProxy::getModelQueryResult in it.
+ * \return the future of the command.
+ */
+OMCFuture OMCProxy::checkModelAsync(QString className, bool recursive, QObject *pReceiver, const char *member)
+{
+  QString expression = recursive ? QString("checkAllModelsRecursive(%1, false)").arg(className) : QString("checkModel(%1)").arg(className);
+  return sendCommandAsync(expression, OMCCommand::Interactive, pReceiver, member);
+}
+
+/*!
+ * \brief OMCProxy::instantiateModelAsync
+ * Queues the model instantiation on the OMCWorkerThread.
+ * \param className - the name of the class.
+ * \param pReceiver - the object to notify.
+ * \param member - the slot of pReceiver. Use OMCProxy::getModelQueryResult in it.
+ * \return the future of the command.
+ */
+OMCFuture OMCProxy::instantiateModelAsync(QString className, QObject *pReceiver, const char *member)
+{
+  return sendCommandAsync(QString("instantiateModel(%1)").arg(className), OMCCommand::Interactive, pReceiver, member);
+}
+
+/*!
+ * \brief OMCProxy::getModelQueryResult
+ * Returns the result of OMCProxy::checkModelAsync or OMCProxy::instantiateModelAsync.
+ * Loads the libraries the model depends on like the synchronous versions.
+ * \param future
+ * \return the result string
+ */
+QString OMCProxy::getModelQueryResult(const OMCFuture &future)
+{
+  // the messages of the command are already shown by OMCProxy::asyncCommandFinished.
+  QString result = future.isCancelled() ? QString("") : StringHandler::unparse(future.getResult());
+  mpMainWindow->getLibraryWidget()->getLibraryTreeModel()->loadDependentLibraries(getClassNames());
+  return result;
+}
+
 /*!
  * \brief OMCProxy::isExperiment
  * Returns the simulation options stored in the model.
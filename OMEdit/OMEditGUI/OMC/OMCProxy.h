@@ -43,6 +43,8 @@
 #include "Component.h"
 #include "StringHandler.h"
 #include "Utilities.h"
+#include "OMCWorkerThread.h"
+#include "OMCLogWriter.h"
 
 class MainWindow;
 class CustomExpressionBox;
@@ -50,6 +52,7 @@ class ComponentInfo;
 class StringHandler;
 class OMCInterface;
 class LibraryTreeItem;
+class OMCWorkerThread;
 
 typedef struct {
   QString mFromUnit;
@@ -77,15 +80,27 @@ private:
   Label *mpOMCDiffMergedLabel;
   QPlainTextEdit *mpOMCDiffMergedTextBox;
   QString mObjectRefFile;
+  QString makeClassComment(QString comment);
   QList<QString> mCommandsList;
   int mCurrentCommandIndex;
-  QFile mCommunicationLogFile;
-  QTextStream mCommunicationLogFileTextStream;
-  QFile mCommandsMosFile;
-  QTextStream mCommandsLogFileTextStream;
+  OMCLogWriter *mpOMCLogWriter;
+  int mLastLoggerEntryId;
+  QHash<int, QString> mTruncatedLoggerEntries;
+  QQueue<int> mTruncatedLoggerEntriesQueue;
+  void addLoggerText(const QString &text, const QString &suffix, QFont::Weight weight);
+  bool expandLoggerEntry(const QPoint &position);
   QList<UnitConverion> mUnitConversionList;
   QMap<QString, QList<QString> > mDerivedUnitsMap;
   OMCInterface *mpOMCInterface;
+  QMutex mOMCMutex;
+  int mInterfaceLockDepth;
+  OMCWorkerThread *mpOMCWorkerThread;
+  int mCommandsBatchDepth;
+  QStringList mBatchedCommands;
+  QHash<QString, int> mBatchedCommandsIndexes;
+  bool batchCommand(const QString &key, const QString &expression);
+  void flushBatchedCommands();
+  void releaseInterfaceLock();
 public:
   OMCProxy(MainWindow *pMainWindow);
   ~OMCProxy();
@@ -95,12 +110,20 @@ public:
   bool initializeOMC();
   void quitOMC();
   void sendCommand(const QString expression);
+  OMCFuture sendCommandAsync(const QString &expression, OMCCommand::Priority priority = OMCCommand::Normal, QObject *pReceiver = 0,
+                             const char *member = 0);
+  OMCWorkerThread* getOMCWorkerThread() {return mpOMCWorkerThread;}
+  void beginCommandsBatch();
+  void endCommandsBatch();
+  bool handleCommand(threadData_t *threadData, const QString &expression, QString &result);
+  threadData_t* getThreadData();
   void setResult(QString value);
   QString getResult();
   void exitApplication();
   void removeObjectRefFile();
   QString getErrorString(bool warningsAsErrors = false);
   bool printMessagesStringInternal();
+  bool printErrorString(const QString &errorString);
   int getMessagesStringInternal();
   void setCurrentError(int errorIndex);
   QString getErrorFileName();
@@ -119,6 +142,7 @@ public:
                             bool sort = false, bool builtin = false, bool showProtected = true);
   QStringList searchClassNames(QString searchText, bool findInText = false);
   OMCInterface::getClassInformation_res getClassInformation(QString className);
+  bool getClassesInformation(QString className, QStringList &classNames, QList<OMCInterface::getClassInformation_res> &classesInformation);
   bool isPackage(QString className);
   bool isBuiltinType(QString typeName);
   QString getBuiltinType(QString typeName);
@@ -142,6 +166,7 @@ public:
   int getConnectionCount(QString className);
   QString getNthConnection(QString className, int num);
   QString getNthConnectionAnnotation(QString className, int num);
+  bool getConnections(QString className, QList<QStringList> &connections, QStringList &connectionAnnotations);
   int getInheritanceCount(QString className);
   QString getNthInheritedClass(QString className, int num);
   QList<QString> getInheritedClasses(QString className);
@@ -170,7 +195,12 @@ public:
   QString list(QString className);
   QString listFile(QString className);
   QString diffModelicaFileListings(QString before, QString after);
+  OMCFuture reloadFileTextAsync(QString className, QString before, QString fileName, QObject *pReceiver, const char *member);
+  QString getReloadFileTextResult(const OMCFuture &future, QString before);
   QString instantiateModel(QString className);
+  OMCFuture checkModelAsync(QString className, bool recursive, QObject *pReceiver, const char *member);
+  OMCFuture instantiateModelAsync(QString className, QObject *pReceiver, const char *member);
+  QString getModelQueryResult(const OMCFuture &future);
   bool addClassAnnotation(QString className, QString annotation);
   QString getDefaultComponentName(QString className);
   QString getDefaultComponentPrefixes(QString className);
@@ -232,11 +262,16 @@ public:
   bool moveClassToBottom(QString className);
   bool inferBindings(QString className);
   QList<QList<QString > > getUses(QString className);
+protected:
+  virtual bool eventFilter(QObject *pObject, QEvent *pEvent);
 signals:
   void commandFinished();
 public slots:
   void logCommand(QString command, QTime *commandTime);
   void logResponse(QString response, QTime *responseTime);
+  void interfaceCommandStarted(QString command, QTime *commandTime);
+  void interfaceCommandFinished(QString response, QTime *responseTime);
+  void asyncCommandFinished(OMCFuture future);
   void showException(QString exception);
   void openOMCLoggerWidget();
   void sendCustomExpression();
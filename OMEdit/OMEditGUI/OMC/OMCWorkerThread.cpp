@@ -0,0 +1,394 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES RECIPIENT'S ACCEPTANCE
+ * OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3, ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+
+#include "OMCWorkerThread.h"
+#include "OMCProxy.h"
+
+/*!
+ * \class OMCCommand
+ * \brief Holds the expression and the result of a command submitted to the OMCWorkerThread.
+ */
+/*!
+ * \param expression - the expression to send to OMC.
+ * \param priority - the scheduling priority.
+ * \param pReceiver - the object notified when the command finishes. Can be 0.
+ * \param member - the slot of pReceiver, given with the SLOT() macro. The slot must take an OMCFuture argument.
+ */
+OMCCommand::OMCCommand(const QString &expression, Priority priority, QObject *pReceiver, const char *member)
+  : mId(0), mExpression(expression), mPriority(priority), mResult(""), mSuccess(false), mFinished(false), mCancelled(false),
+    mpReceiver(pReceiver)
+{
+  // SLOT(name(OMCFuture)) expands to "1name(OMCFuture)". QMetaObject::invokeMethod needs only the name.
+  if (member) {
+    mMember = QByteArray(member + 1);
+    mMember = mMember.left(mMember.indexOf('('));
+  }
+}
+
+/*!
+ * \class OMCFuture
+ * \brief A handle to a command submitted to the OMCWorkerThread.
+ */
+/*!
+ * \brief OMCFuture::getId
+ * Returns the id of the command. Use it to tell apart the commands with the same expression.
+ * \return the id or 0 if the future is not valid.
+ */
+quint64 OMCFuture::getId() const
+{
+  return isValid() ? mpCommand->mId : 0;
+}
+
+QString OMCFuture::getExpression() const
+{
+  return isValid() ? mpCommand->mExpression : QString("");
+}
+
+OMCCommand::Priority OMCFuture::getPriority() const
+{
+  return isValid() ? mpCommand->mPriority : OMCCommand::Normal;
+}
+
+/*!
+ * \brief OMCFuture::isFinished
+ * Returns true if the command is executed or cancelled.
+ * \return
+ */
+bool OMCFuture::isFinished() const
+{
+  if (!isValid()) {
+    return true;
+  }
+  QMutexLocker locker(&mpOMCWorkerThread->mQueueMutex);
+  return mpCommand->mFinished;
+}
+
+bool OMCFuture::isCancelled() const
+{
+  if (!isValid()) {
+    return false;
+  }
+  QMutexLocker locker(&mpOMCWorkerThread->mQueueMutex);
+  return mpCommand->mCancelled;
+}
+
+/*!
+ * \brief OMCFuture::isSuccessful
+ * Returns false if OMC failed to handle the command.
+ * \return
+ */
+bool OMCFuture::isSuccessful() const
+{
+  if (!isValid()) {
+    return false;
+  }
+  QMutexLocker locker(&mpOMCWorkerThread->mQueueMutex);
+  return mpCommand->mSuccess;
+}
+
+/*!
+ * \brief OMCFuture::waitForFinished
+ * Blocks until the command is executed.
+ * \see OMCWorkerThread::waitForFinished
+ */
+void OMCFuture::waitForFinished() const
+{
+  if (isValid()) {
+    mpOMCWorkerThread->waitForFinished(mpCommand);
+  }
+}
+
+/*!
+ * \brief OMCFuture::getResult
+ * Returns the trimmed OMC result. Blocks until the command is executed.
+ * \return
+ */
+QString OMCFuture::getResult() const
+{
+  if (!isValid()) {
+    return "";
+  }
+  waitForFinished();
+  QMutexLocker locker(&mpOMCWorkerThread->mQueueMutex);
+  return mpCommand->mResult.trimmed();
+}
+
+/*!
+ * \brief OMCFuture::getErrorString
+ * Returns the messages OMC reported while executing the command. Blocks until the command is executed.\n
+ * OMC keeps the messages per thread so they are read by the thread that executed the command.
+ * \return the unparsed result of getErrorString().
+ */
+QString OMCFuture::getErrorString() const
+{
+  if (!isValid()) {
+    return "";
+  }
+  waitForFinished();
+  QMutexLocker locker(&mpOMCWorkerThread->mQueueMutex);
+  return mpCommand->mErrorString.trimmed();
+}
+
+/*!
+ * \brief OMCFuture::cancel
+ * Cancels the command if it is not started yet.
+ * \return true if the command is cancelled.
+ */
+bool OMCFuture::cancel()
+{
+  return isValid() ? mpOMCWorkerThread->cancel(mpCommand) : false;
+}
+
+/*!
+ * \class OMCWorkerThread
+ * \brief Executes the OMC commands submitted by OMCProxy::sendCommandAsync in a separate thread.
+ * Commands are taken from a queue per OMCCommand::Priority so interactive queries go ahead of the background work.
+ * Each command is executed while holding the OMC mutex of OMCProxy so it never runs concurrently with the synchronous calls of the GUI thread.
+ */
+/*!
+ * \param pOMCProxy - pointer to OMCProxy
+ * \param pOMCMutex - the mutex serializing the access to OMC.
+ */
+OMCWorkerThread::OMCWorkerThread(OMCProxy *pOMCProxy, QMutex *pOMCMutex)
+  : QThread(pOMCProxy), mpOMCProxy(pOMCProxy), mpOMCMutex(pOMCMutex), mStop(false), mNextCommandId(1)
+{
+  qRegisterMetaType<OMCFuture>("OMCFuture");
+  // OMC is deeply recursive. Use the same stack size as the main thread on Windows.
+  setStackSize(16777216);
+}
+
+/*!
+ * \brief OMCWorkerThread::enqueue
+ * Adds the command to the queue of its priority and wakes up the thread.
+ * \param expression
+ * \param priority
+ * \param pReceiver
+ * \param member
+ * \return the future of the command.
+ */
+OMCFuture OMCWorkerThread::enqueue(const QString &expression, OMCCommand::Priority priority, QObject *pReceiver, const char *member)
+{
+  QSharedPointer<OMCCommand> pCommand(new OMCCommand(expression, priority, pReceiver, member));
+  QMutexLocker locker(&mQueueMutex);
+  pCommand->mId = mNextCommandId++;
+  if (mStop) {
+    pCommand->mFinished = true;
+    pCommand->mCancelled = true;
+  } else {
+    mQueues[priority].enqueue(pCommand);
+    mCommandAvailable.wakeOne();
+  }
+  return OMCFuture(pCommand, this);
+}
+
+/*!
+ * \brief OMCWorkerThread::waitForFinished
+ * Blocks the calling thread until the command is executed.\n
+ * A command that is still queued is taken out of the queue and executed in the calling thread since someone is waiting for it now.
+ * The thread only dequeues a command while holding the OMC mutex so this never waits on the thread when the caller holds the OMC mutex.
+ * Must be called from the GUI thread.
+ * \param pCommand
+ */
+void OMCWorkerThread::waitForFinished(QSharedPointer<OMCCommand> pCommand)
+{
+  mQueueMutex.lock();
+  if (!pCommand->mFinished && mQueues[pCommand->mPriority].removeOne(pCommand)) {
+    mQueueMutex.unlock();
+    mpOMCMutex->lock();
+    execute(mpOMCProxy->getThreadData(), pCommand);
+    mpOMCMutex->unlock();
+    // notify the receiver later so the caller is not re-entered.
+    QMetaObject::invokeMethod(mpOMCProxy, "asyncCommandFinished", Qt::QueuedConnection, Q_ARG(OMCFuture, OMCFuture(pCommand, this)));
+    return;
+  }
+  while (!pCommand->mFinished) {
+    mCommandFinished.wait(&mQueueMutex);
+  }
+  mQueueMutex.unlock();
+}
+
+/*!
+ * \brief OMCWorkerThread::cancel
+ * Removes the command from the queue if it is not started yet.
+ * \param pCommand
+ * \return true if the command is cancelled.
+ */
+bool OMCWorkerThread::cancel(QSharedPointer<OMCCommand> pCommand)
+{
+  QMutexLocker locker(&mQueueMutex);
+  if (!mQueues[pCommand->mPriority].removeOne(pCommand)) {
+    return false;
+  }
+  pCommand->mFinished = true;
+  pCommand->mCancelled = true;
+  mCommandFinished.wakeAll();
+  return true;
+}
+
+/*!
+ * \brief OMCWorkerThread::cancelAll
+ * Cancels all the queued commands of the given priority. Used to drop the background work e.g., when libraries are unloaded.
+ * \param priority
+ */
+void OMCWorkerThread::cancelAll(OMCCommand::Priority priority)
+{
+  QMutexLocker locker(&mQueueMutex);
+  while (!mQueues[priority].isEmpty()) {
+    QSharedPointer<OMCCommand> pCommand = mQueues[priority].dequeue();
+    pCommand->mFinished = true;
+    pCommand->mCancelled = true;
+  }
+  mCommandFinished.wakeAll();
+}
+
+/*!
+ * \brief OMCWorkerThread::pendingCommandsCount
+ * Returns the number of queued commands.
+ * \return
+ */
+int OMCWorkerThread::pendingCommandsCount()
+{
+  QMutexLocker locker(&mQueueMutex);
+  int count = 0;
+  for (int i = 0 ; i < OMCCommand::PriorityCount ; i++) {
+    count += mQueues[i].size();
+  }
+  return count;
+}
+
+/*!
+ * \brief OMCWorkerThread::stop
+ * Cancels all the queued commands and asks the thread to finish after the current command.
+ */
+void OMCWorkerThread::stop()
+{
+  for (int i = 0 ; i < OMCCommand::PriorityCount ; i++) {
+    cancelAll((OMCCommand::Priority)i);
+  }
+  QMutexLocker locker(&mQueueMutex);
+  mStop = true;
+  mCommandAvailable.wakeAll();
+}
+
+/*!
+ * \brief OMCWorkerThread::takeNextCommand
+ * Blocks until a command is available and returns the one with the highest priority.\n
+ * The OMC mutex is locked before the command leaves its queue and is returned locked. So a command is either queued, running or finished
+ * and OMCWorkerThread::waitForFinished can always take over a command that is not running.
+ * \return the command or a null pointer if the thread should stop.
+ */
+QSharedPointer<OMCCommand> OMCWorkerThread::takeNextCommand()
+{
+  forever {
+    mQueueMutex.lock();
+    while (!mStop && !hasQueuedCommands()) {
+      mCommandAvailable.wait(&mQueueMutex);
+    }
+    mQueueMutex.unlock();
+    mpOMCMutex->lock();
+    QMutexLocker locker(&mQueueMutex);
+    if (mStop) {
+      mpOMCMutex->unlock();
+      return QSharedPointer<OMCCommand>();
+    }
+    for (int i = 0 ; i < OMCCommand::PriorityCount ; i++) {
+      if (!mQueues[i].isEmpty()) {
+        return mQueues[i].dequeue();
+      }
+    }
+    // the command is taken by OMCWorkerThread::waitForFinished meanwhile.
+    mpOMCMutex->unlock();
+  }
+}
+
+/*!
+ * \brief OMCWorkerThread::hasQueuedCommands
+ * Returns true if any queue has a command. The caller must hold the queue mutex.
+ * \return
+ */
+bool OMCWorkerThread::hasQueuedCommands() const
+{
+  for (int i = 0 ; i < OMCCommand::PriorityCount ; i++) {
+    if (!mQueues[i].isEmpty()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/*!
+ * \brief OMCWorkerThread::execute
+ * Sends the command to OMC and marks it finished. The caller must hold the OMC mutex.\n
+ * The messages of the command are read with getErrorString() on the same threadData since OMC keeps them per thread.
+ * \param threadData - the threadData of the calling thread.
+ * \param pCommand
+ */
+void OMCWorkerThread::execute(threadData_t *threadData, QSharedPointer<OMCCommand> pCommand)
+{
+  QString result, errorString;
+  pCommand->mCommandTime.start();
+  bool success = mpOMCProxy->handleCommand(threadData, pCommand->mExpression, result);
+  if (success) {
+    mpOMCProxy->handleCommand(threadData, "getErrorString()", errorString);
+  }
+  QMutexLocker locker(&mQueueMutex);
+  pCommand->mResult = result;
+  pCommand->mErrorString = errorString;
+  pCommand->mSuccess = success;
+  pCommand->mFinished = true;
+  mCommandFinished.wakeAll();
+}
+
+/*!
+ * \brief OMCWorkerThread::run
+ * Reimplementation of QThread::run().\n
+ * Uses its own threadData since the stack bounds and the jump buffers are per thread. The symbol table is shared with the GUI thread.
+ * The plot callback is not set so plot commands should be sent synchronously.
+ */
+void OMCWorkerThread::run()
+{
+  struct GC_stack_base stackBase;
+  GC_get_stack_base(&stackBase);
+  GC_register_my_thread(&stackBase);
+  threadData_t *threadData = (threadData_t *) calloc(1, sizeof(threadData_t));
+  mmc_init_stackoverflow(threadData);
+  forever {
+    QSharedPointer<OMCCommand> pCommand = takeNextCommand();
+    if (pCommand.isNull()) {
+      break;
+    }
+    // takeNextCommand returns with the OMC mutex locked.
+    execute(threadData, pCommand);
+    mpOMCMutex->unlock();
+    emit commandFinished(OMCFuture(pCommand, this));
+  }
+  free(threadData);
+  GC_unregister_my_thread();
+}
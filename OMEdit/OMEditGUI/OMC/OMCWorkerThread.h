@@ -0,0 +1,143 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES RECIPIENT'S ACCEPTANCE
+ * OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3, ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+
+#ifndef OMCWORKERTHREAD_H
+#define OMCWORKERTHREAD_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QSharedPointer>
+#include <QPointer>
+#include <QQueue>
+#include <QTime>
+#include <QMetaType>
+
+#include "meta/meta_modelica.h"
+
+class OMCProxy;
+class OMCWorkerThread;
+
+/*!
+ * \class OMCCommand
+ * \brief Holds the expression and the result of a command submitted to the OMCWorkerThread.
+ */
+class OMCCommand
+{
+public:
+  /* The order defines the scheduling. Lower values are executed first. */
+  enum Priority {
+    Interactive = 0,  /* queries the user is waiting for. */
+    Normal = 1,
+    Background = 2,   /* icon loading, library indexing etc. */
+    PriorityCount = 3
+  };
+  OMCCommand(const QString &expression, Priority priority, QObject *pReceiver, const char *member);
+  /* unique for the lifetime of the OMCWorkerThread. */
+  quint64 mId;
+  QString mExpression;
+  Priority mPriority;
+  QString mResult;
+  /* the getErrorString() of the thread that executed the command. */
+  QString mErrorString;
+  bool mSuccess;
+  bool mFinished;
+  bool mCancelled;
+  QTime mCommandTime;
+  /* only accessed from the GUI thread. */
+  QPointer<QObject> mpReceiver;
+  QByteArray mMember;
+};
+
+/*!
+ * \class OMCFuture
+ * \brief A handle to a command submitted to the OMCWorkerThread.
+ * Cheap to copy. All copies refer to the same command.
+ */
+class OMCFuture
+{
+public:
+  OMCFuture() : mpOMCWorkerThread(0) {}
+  OMCFuture(QSharedPointer<OMCCommand> pCommand, OMCWorkerThread *pOMCWorkerThread)
+    : mpCommand(pCommand), mpOMCWorkerThread(pOMCWorkerThread) {}
+  bool isValid() const {return !mpCommand.isNull();}
+  quint64 getId() const;
+  QString getExpression() const;
+  OMCCommand::Priority getPriority() const;
+  bool isFinished() const;
+  bool isCancelled() const;
+  bool isSuccessful() const;
+  void waitForFinished() const;
+  QString getResult() const;
+  QString getErrorString() const;
+  bool cancel();
+private:
+  QSharedPointer<OMCCommand> mpCommand;
+  OMCWorkerThread *mpOMCWorkerThread;
+
+  friend class OMCWorkerThread;
+  friend class OMCProxy;
+};
+
+Q_DECLARE_METATYPE(OMCFuture)
+
+class OMCWorkerThread : public QThread
+{
+  Q_OBJECT
+public:
+  OMCWorkerThread(OMCProxy *pOMCProxy, QMutex *pOMCMutex);
+  OMCFuture enqueue(const QString &expression, OMCCommand::Priority priority, QObject *pReceiver, const char *member);
+  void waitForFinished(QSharedPointer<OMCCommand> pCommand);
+  bool cancel(QSharedPointer<OMCCommand> pCommand);
+  void cancelAll(OMCCommand::Priority priority);
+  int pendingCommandsCount();
+  void stop();
+protected:
+  virtual void run();
+private:
+  OMCProxy *mpOMCProxy;
+  QMutex *mpOMCMutex;
+  QMutex mQueueMutex;
+  QWaitCondition mCommandAvailable;
+  QWaitCondition mCommandFinished;
+  QQueue<QSharedPointer<OMCCommand> > mQueues[OMCCommand::PriorityCount];
+  bool mStop;
+  quint64 mNextCommandId;
+
+  QSharedPointer<OMCCommand> takeNextCommand();
+  void execute(threadData_t *threadData, QSharedPointer<OMCCommand> pCommand);
+  bool hasQueuedCommands() const;
+
+  friend class OMCFuture;
+signals:
+  void commandFinished(OMCFuture future);
+};
+
+#endif // OMCWORKERTHREAD_H
@@ -98,12 +98,15 @@ win32 {
 }
 
 SOURCES += main.cpp \
+  BatchMode.cpp \
   Util/Helper.cpp \
   Util/Utilities.cpp \
   Util/StringHandler.cpp \
   MainWindow.cpp \
   $$OPENMODELICAHOME/include/omc/scripting-API/OpenModelicaScriptingAPIQt.cpp \
   OMC/OMCProxy.cpp \
+  OMC/OMCWorkerThread.cpp \
+  OMC/OMCLogWriter.cpp \
   Modeling/MessagesWidget.cpp \
   Modeling/LibraryTreeWidget.cpp \
   Modeling/Commands.cpp \
@@ -164,11 +167,14 @@ SOURCES += main.cpp \
   OMC/Parser/OMCOutputLexer.cpp
 
 HEADERS  += Util/Helper.h \
+  BatchMode.h \
   Util/Utilities.h \
   Util/StringHandler.h \
   MainWindow.h \
   $$OPENMODELICAHOME/include/omc/scripting-API/OpenModelicaScriptingAPIQt.h \
   OMC/OMCProxy.h \
+  OMC/OMCWorkerThread.h \
+  OMC/OMCLogWriter.h \
   Modeling/MessagesWidget.h \
   Modeling/LibraryTreeWidget.h \
   Modeling/Commands.h \
@@ -328,35 +328,67 @@ Qt::ItemFlags VariablesTreeModel::flags(const QModelIndex &index) const
   return flags;
 }
 
+/*!
+ * \brief VariablesTreeModel::findVariablesTreeItem
+ * Finds the VariablesTreeItem by name under root using the items index.
+ * \param name
+ * \param root
+ * \return
+ */
 VariablesTreeItem* VariablesTreeModel::findVariablesTreeItem(const QString &name, VariablesTreeItem *root) const
 {
-  if (root->getVariableName() == name)
+  if (root->getVariableName() == name) {
     return root;
-  for (int i = root->getChildren().size(); --i >= 0; )
-    if (VariablesTreeItem *item = findVariablesTreeItem(name, root->getChildren().at(i)))
-      return item;
+  }
+  VariablesTreeItem *pVariablesTreeItem = mVariablesTreeItemsHash.value(name, 0);
+  // make sure the item is under root.
+  for (VariablesTreeItem *pParentVariablesTreeItem = pVariablesTreeItem ; pParentVariablesTreeItem ;
+       pParentVariablesTreeItem = pParentVariablesTreeItem->parent()) {
+    if (pParentVariablesTreeItem == root) {
+      return pVariablesTreeItem;
+    }
+  }
   return 0;
 }
 
+/*!
+ * \brief VariablesTreeModel::variablesTreeItemIndex
+ * Returns the model index of the VariablesTreeItem.
+ * \param pVariablesTreeItem
+ * \return
+ */
 QModelIndex VariablesTreeModel::variablesTreeItemIndex(const VariablesTreeItem *pVariablesTreeItem) const
 {
-  return variablesTreeItemIndexHelper(pVariablesTreeItem, mpRootVariablesTreeItem, QModelIndex());
+  if (!pVariablesTreeItem || pVariablesTreeItem == mpRootVariablesTreeItem) {
+    return QModelIndex();
+  }
+  return createIndex(pVariablesTreeItem->row(), 0, const_cast<VariablesTreeItem*>(pVariablesTreeItem));
 }
 
-QModelIndex VariablesTreeModel::variablesTreeItemIndexHelper(const VariablesTreeItem *pVariablesTreeItem,
-                                                             const VariablesTreeItem *pParentVariablesTreeItem,
-                                                             const QModelIndex &parentIndex) const
+/*!
+ * \brief VariablesTreeModel::addVariablesTreeItemToIndex
+ * Adds the VariablesTreeItem and its children to the items index.
+ * \param pVariablesTreeItem
+ */
+void VariablesTreeModel::addVariablesTreeItemToIndex(VariablesTreeItem *pVariablesTreeItem)
 {
-  if (pVariablesTreeItem == pParentVariablesTreeItem)
-    return parentIndex;
-  for (int i = pParentVariablesTreeItem->getChildren().size(); --i >= 0; ) {
-    const VariablesTreeItem *childItem = pParentVariablesTreeItem->getChildren().at(i);
-    QModelIndex childIndex = index(i, 0, parentIndex);
-    QModelIndex index = variablesTreeItemIndexHelper(pVariablesTreeItem, childItem, childIndex);
-    if (index.isValid())
-      return index;
+  mVariablesTreeItemsHash.insert(pVariablesTreeItem->getVariableName(), pVariablesTreeItem);
+  foreach (VariablesTreeItem *pChildVariablesTreeItem, pVariablesTreeItem->getChildren()) {
+    addVariablesTreeItemToIndex(pChildVariablesTreeItem);
+  }
+}
+
+/*!
+ * \brief VariablesTreeModel::removeVariablesTreeItemFromIndex
+ * Removes the VariablesTreeItem and its children from the items index.
+ * \param pVariablesTreeItem
+ */
+void VariablesTreeModel::removeVariablesTreeItemFromIndex(VariablesTreeItem *pVariablesTreeItem)
+{
+  mVariablesTreeItemsHash.remove(pVariablesTreeItem->getVariableName());
+  foreach (VariablesTreeItem *pChildVariablesTreeItem, pVariablesTreeItem->getChildren()) {
+    removeVariablesTreeItemFromIndex(pChildVariablesTreeItem);
   }
-  return QModelIndex();
 }
 
 void VariablesTreeModel::parseInitXml(QXmlStreamReader &xmlReader)
@@ -412,21 +444,25 @@ QHash<QString, QString> VariablesTreeModel::parseScalarVariable(QXmlStreamReader
   return scalarVariable;
 }
 
+/*!
+ * \brief VariablesTreeModel::insertVariablesItems
+ * Creates the complete tree of the result file variables and inserts it in the model at once.\n
+ * The items are looked up through a hash of the variable paths and the final values are read from the result file in one go.
+ * \param fileName
+ * \param filePath
+ * \param variablesList
+ * \param simulationOptions
+ */
 void VariablesTreeModel::insertVariablesItems(QString fileName, QString filePath, QStringList variablesList,
                                               SimulationOptions simulationOptions)
 {
   QString toolTip = tr("Simulation Result File: %1\n%2: %3/%4").arg(fileName).arg(Helper::fileLocation).arg(filePath).arg(fileName);
   QRegExp resultTypeRegExp("(_res.mat|_res.plt|_res.csv)");
   QString text = QString(fileName).remove(resultTypeRegExp);
-  QModelIndex index = variablesTreeItemIndex(mpRootVariablesTreeItem);
   QVector<QVariant> Variabledata;
   Variabledata << filePath << fileName << fileName << text << "" << "" << "" << "" << toolTip;
   VariablesTreeItem *pTopVariablesTreeItem = new VariablesTreeItem(Variabledata, mpRootVariablesTreeItem, true);
   pTopVariablesTreeItem->setSimulationOptions(simulationOptions);
-  int row = rowCount();
-  beginInsertRows(index, row, row);
-  mpRootVariablesTreeItem->insertChild(row, pTopVariablesTreeItem);
-  endInsertRows();
   /* open the model_init.xml file for reading */
   if (simulationOptions.isValid()) {
     QString initFileName = QString(simulationOptions.getOutputFileName()).append("_init.xml");
@@ -446,6 +482,7 @@ void VariablesTreeModel::insertVariablesItems(QString fileName, QString filePath
   ModelicaMatReader matReader;
   matReader.file = 0;
   const char *msg[] = {""};
+  QVector<double> finalValues;
   if (fileName.endsWith(".mat"))
   {
     //Read in mat file
@@ -455,8 +492,12 @@ void VariablesTreeModel::insertVariablesItems(QString fileName, QString filePath
       pMessagesWidget->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0,
                                                  GUIMessages::getMessage(GUIMessages::ERROR_OPENING_FILE).arg(fileName)
                                                  .arg(QString(msg[0])), Helper::scriptingKind, Helper::errorLevel));
+    } else {
+      finalValues = readFinalValues(&matReader);
     }
   }
+  /* index of the items created so far by their path in the tree. */
+  QHash<QString, VariablesTreeItem*> variablesTreeItems;
   QStringList variables;
   foreach (QString plotVariable, variablesList)
   {
@@ -472,69 +513,45 @@ void VariablesTreeModel::insertVariablesItems(QString fileName, QString filePath
       variables = StringHandler::makeVariableParts(plotVariable);
     }
     int count = 1;
-    VariablesTreeItem *pParentVariablesTreeItem = 0;
+    VariablesTreeItem *pParentVariablesTreeItem = pTopVariablesTreeItem;
     foreach (QString variable, variables)
     {
-      if (count == 1) /* first loop iteration */
-      {
-        pParentVariablesTreeItem = pTopVariablesTreeItem;
-      }
       QString findVariable;
       /* if last item */
       if (variables.size() == count && plotVariable.startsWith("der("))
         findVariable = parentVariable.isEmpty() ? fileName + ".der(" + variable + ")" : fileName + "." + parentVariable + ".der(" + variable + ")";
       else
         findVariable = parentVariable.isEmpty() ? fileName + "." + variable : fileName + "." + parentVariable + "." + variable;
-      if ((pParentVariablesTreeItem = findVariablesTreeItem(findVariable, pParentVariablesTreeItem)) != NULL)
+      VariablesTreeItem *pVariablesTreeItem = variablesTreeItems.value(findVariable, 0);
+      if (!pVariablesTreeItem)
       {
-        if (count == 1)
-          parentVariable = variable;
+        QVector<QVariant> variableData;
+        /* if last item */
+        if (variables.size() == count && plotVariable.startsWith("der("))
+          variableData << filePath << fileName << fileName + "." + plotVariable << "der(" + variable + ")";
         else
-          parentVariable += "." + variable;
-        count++;
-        continue;
+          variableData << filePath << fileName << pParentVariablesTreeItem->getVariableName() + "." + variable << variable;
+        /* find the variable in the xml file */
+        QString variableToFind = variableData[2].toString().mid(fileName.length() + 1);
+        /* get the variable information i.e value, unit, displayunit, description */
+        QString value, unit, displayUnit, description;
+        bool changeAble = false;
+        getVariableInformation(&matReader, finalValues, variableToFind, &value, &changeAble, &unit, &displayUnit, &description);
+        variableData << StringHandler::unparse(QString("\"").append(value).append("\""));
+        /* set the variable unit */
+        variableData << StringHandler::unparse(QString("\"").append(unit).append("\""));
+        /* set the variable displayUnit */
+        variableData << StringHandler::unparse(QString("\"").append(displayUnit).append("\""));
+        /* set the variable description */
+        variableData << StringHandler::unparse(QString("\"").append(description).append("\""));
+        /* construct tooltip text */
+        variableData << tr("File: %1/%2\nVariable: %3").arg(filePath).arg(fileName).arg(variableToFind);
+        pVariablesTreeItem = new VariablesTreeItem(variableData, pParentVariablesTreeItem);
+        pVariablesTreeItem->setEditable(changeAble);
+        pParentVariablesTreeItem->insertChild(pParentVariablesTreeItem->getChildren().size(), pVariablesTreeItem);
+        variablesTreeItems.insert(findVariable, pVariablesTreeItem);
       }
-      /*
-        If pParentVariablesTreeItem is 0 and it is first loop iteration then use pTopVariablesTreeItem as parent.
-        If loop iteration is not first and pParentVariablesTreeItem is 0 then find the parent item.
-        */
-      if (!pParentVariablesTreeItem && count > 1)
-      {
-        pParentVariablesTreeItem = findVariablesTreeItem(fileName + "." + parentVariable, pTopVariablesTreeItem);
-      }
-      else
-      {
-        pParentVariablesTreeItem = pTopVariablesTreeItem;
-      }
-      QModelIndex index = variablesTreeItemIndex(pParentVariablesTreeItem);
-      QVector<QVariant> variableData;
-      /* if last item */
-      if (variables.size() == count && plotVariable.startsWith("der("))
-        variableData << filePath << fileName << fileName + "." + plotVariable << "der(" + variable + ")";
-      else
-        variableData << filePath << fileName << pParentVariablesTreeItem->getVariableName() + "." + variable << variable;
-      /* find the variable in the xml file */
-      QString variableToFind = variableData[2].toString();
-      variableToFind.remove(QRegExp(pTopVariablesTreeItem->getVariableName() + "."));
-      /* get the variable information i.e value, unit, displayunit, description */
-      QString value, unit, displayUnit, description;
-      bool changeAble = false;
-      getVariableInformation(&matReader, variableToFind, &value, &changeAble, &unit, &displayUnit, &description);
-      variableData << StringHandler::unparse(QString("\"").append(value).append("\""));
-      /* set the variable unit */
-      variableData << StringHandler::unparse(QString("\"").append(unit).append("\""));
-      /* set the variable displayUnit */
-      variableData << StringHandler::unparse(QString("\"").append(displayUnit).append("\""));
-      /* set the variable description */
-      variableData << StringHandler::unparse(QString("\"").append(description).append("\""));
-      /* construct tooltip text */
-      variableData << tr("File: %1/%2\nVariable: %3").arg(filePath).arg(fileName).arg(variableToFind);
-      VariablesTreeItem *pVariablesTreeItem = new VariablesTreeItem(variableData, pParentVariablesTreeItem);
-      pVariablesTreeItem->setEditable(changeAble);
-      int row = rowCount(index);
-      beginInsertRows(index, row, row);
-      pParentVariablesTreeItem->insertChild(row, pVariablesTreeItem);
-      endInsertRows();
+      pParentVariablesTreeItem = pVariablesTreeItem;
       if (count == 1)
         parentVariable = variable;
       else
@@ -548,6 +565,12 @@ void VariablesTreeModel::insertVariablesItems(QString fileName, QString filePath
     if (matReader.file)
       omc_free_matlab4_reader(&matReader);
   }
+  /* insert the complete result tree in the model at once. */
+  int row = rowCount();
+  beginInsertRows(QModelIndex(), row, row);
+  mpRootVariablesTreeItem->insertChild(row, pTopVariablesTreeItem);
+  addVariablesTreeItemToIndex(pTopVariablesTreeItem);
+  endInsertRows();
   mpVariablesTreeView->collapseAll();
   QModelIndex idx = variablesTreeItemIndex(pTopVariablesTreeItem);
   idx = mpVariablesTreeView->getVariablesWidget()->getVariableTreeProxyModel()->mapFromSource(idx);
@@ -564,9 +587,11 @@ void VariablesTreeModel::insertVariablesItems(QString fileName, QString filePath
 bool VariablesTreeModel::removeVariableTreeItem(QString variable)
 {
   VariablesTreeItem *pVariablesTreeItem = findVariablesTreeItem(variable, mpRootVariablesTreeItem);
-  if (pVariablesTreeItem)
+  if (pVariablesTreeItem && pVariablesTreeItem != mpRootVariablesTreeItem)
   {
-    beginRemoveRows(variablesTreeItemIndex(pVariablesTreeItem), 0, pVariablesTreeItem->getChildren().size());
+    int row = pVariablesTreeItem->row();
+    beginRemoveRows(variablesTreeItemIndex(pVariablesTreeItem->parent()), row, row);
+    removeVariablesTreeItemFromIndex(pVariablesTreeItem);
     pVariablesTreeItem->removeChildren();
     VariablesTreeItem *pParentVariablesTreeItem = pVariablesTreeItem->parent();
     pParentVariablesTreeItem->removeChild(pVariablesTreeItem);
@@ -607,8 +632,45 @@ void VariablesTreeModel::plotAllVariables(VariablesTreeItem *pVariablesTreeItem,
   }
 }
 
-void VariablesTreeModel::getVariableInformation(ModelicaMatReader *pMatReader, QString variableToFind, QString *value, bool *changeAble,
-                                                QString *unit, QString *displayUnit, QString *description)
+/*!
+ * \brief VariablesTreeModel::readFinalValues
+ * Reads the values of all the variables at the stop time in one go.\n
+ * The data_2 matrix of the mat file is stored row by row so the last row contains the final values of all the variables.
+ * \param pMatReader
+ * \return the final values indexed by the data_2 column or an empty vector if they can't be read.
+ */
+QVector<double> VariablesTreeModel::readFinalValues(ModelicaMatReader *pMatReader)
+{
+  QVector<double> finalValues;
+  if (!pMatReader->file || pMatReader->nrows == 0 || pMatReader->nvar == 0) {
+    return finalValues;
+  }
+  size_t elementSize = pMatReader->doublePrecision ? sizeof(double) : sizeof(float);
+  long offset = pMatReader->var_offset + (long)(pMatReader->nrows - 1) * pMatReader->nvar * elementSize;
+  if (fseek(pMatReader->file, offset, SEEK_SET) != 0) {
+    return finalValues;
+  }
+  finalValues.resize(pMatReader->nvar);
+  if (pMatReader->doublePrecision) {
+    if (fread(finalValues.data(), sizeof(double), pMatReader->nvar, pMatReader->file) != pMatReader->nvar) {
+      finalValues.clear();
+    }
+  } else {
+    QVector<float> values(pMatReader->nvar);
+    if (fread(values.data(), sizeof(float), pMatReader->nvar, pMatReader->file) != pMatReader->nvar) {
+      finalValues.clear();
+    } else {
+      for (int i = 0 ; i < values.size() ; i++) {
+        finalValues[i] = values.at(i);
+      }
+    }
+  }
+  return finalValues;
+}
+
+void VariablesTreeModel::getVariableInformation(ModelicaMatReader *pMatReader, const QVector<double> &finalValues, QString variableToFind,
+                                                QString *value, bool *changeAble, QString *unit, QString *displayUnit,
+                                                QString *description)
 {
   QHash<QString, QString> hash = mScalarVariablesList.value(variableToFind);
   if (hash["name"].compare(variableToFind) == 0)
@@ -636,7 +698,13 @@ void VariablesTreeModel::getVariableInformation(ModelicaMatReader *pMatReader, Q
             qDebug() << QString("%1 not found in %2").arg(variableToFind).arg(pMatReader->fileName);
           }
           double res;
-          if (var && !omc_matlab4_val(&res, pMatReader, var, omc_matlab4_stopTime(pMatReader)))
+          int index = var ? qAbs(var->index) - 1 : -1;
+          /* use the final values read from data_2 for the variables and read the parameters from data_1. */
+          if (var && !var->isParam && index >= 0 && index < finalValues.size())
+          {
+            *value = QString::number(var->index < 0 ? -finalValues.at(index) : finalValues.at(index));
+          }
+          else if (var && !omc_matlab4_val(&res, pMatReader, var, omc_matlab4_stopTime(pMatReader)))
           {
             *value = QString::number(res);
           }
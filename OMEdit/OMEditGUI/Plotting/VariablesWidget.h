@@ -110,8 +110,6 @@ public:
   Qt::ItemFlags flags(const QModelIndex &index) const;
   VariablesTreeItem* findVariablesTreeItem(const QString &name, VariablesTreeItem *root) const;
   QModelIndex variablesTreeItemIndex(const VariablesTreeItem *pVariablesTreeItem) const;
-  QModelIndex variablesTreeItemIndexHelper(const VariablesTreeItem *pVariablesTreeItem, const VariablesTreeItem *pParentVariablesTreeItem,
-                                           const QModelIndex &parentIndex) const;
   void parseInitXml(QXmlStreamReader &xmlReader);
   QHash<QString, QString> parseScalarVariable(QXmlStreamReader &xmlReader);
   void insertVariablesItems(QString fileName, QString filePath, QStringList variablesList, SimulationOptions simulationOptions);
@@ -122,8 +120,12 @@ private:
   VariablesTreeView *mpVariablesTreeView;
   VariablesTreeItem *mpRootVariablesTreeItem;
   QHash<QString, QHash<QString,QString> > mScalarVariablesList;
-  void getVariableInformation(ModelicaMatReader *pMatReader, QString variableToFind, QString *value, bool *changeAble, QString *unit,
-                              QString *displayUnit, QString *description);
+  QHash<QString, VariablesTreeItem*> mVariablesTreeItemsHash;
+  void addVariablesTreeItemToIndex(VariablesTreeItem *pVariablesTreeItem);
+  void removeVariablesTreeItemFromIndex(VariablesTreeItem *pVariablesTreeItem);
+  QVector<double> readFinalValues(ModelicaMatReader *pMatReader);
+  void getVariableInformation(ModelicaMatReader *pMatReader, const QVector<double> &finalValues, QString variableToFind, QString *value,
+                              bool *changeAble, QString *unit, QString *displayUnit, QString *description);
 signals:
   void itemChecked(const QModelIndex &index, qreal curveThickness, int curveStyle);
   void variableTreeItemRemoved(QString variable);
@@ -41,7 +41,7 @@
   \brief Data model for Simulation output messages.
   */
 /*!
-  \param pSimulationOutputWidget - a pointer to SimulationOutputWidget.
+  \param pSimulationOutputWidget - a pointer to SimulationOutputWidget. Can be 0 e.g., in the benchmarks. The messages have no Debug more links then.
   \param pParent - a pointer to QObject.
   */
 SimulationMessageModel::SimulationMessageModel(SimulationOutputWidget *pSimulationOutputWidget, QObject *pParent)
@@ -49,6 +49,13 @@ SimulationMessageModel::SimulationMessageModel(SimulationOutputWidget *pSimulati
 {
   mpSimulationOutputWidget = pSimulationOutputWidget;
   mpRootSimulationMessage = new SimulationMessage;
+  mSpillFile.setFileTemplate(QString("%1/simulationmessages-XXXXXX").arg(OpenModelica::tempDirectory()));
+  mSpillFileFailed = false;
+}
+
+SimulationMessageModel::~SimulationMessageModel()
+{
+  delete mpRootSimulationMessage;
 }
 
 /*!
@@ -108,7 +115,7 @@ int SimulationMessageModel::rowCount(const QModelIndex &parent) const
   } else {
     pParentSimulationMessage = static_cast<SimulationMessage*>(parent.internalPointer());
   }
-  return pParentSimulationMessage->children().size();
+  return pParentSimulationMessage->childrenCount();
 }
 
 /*!
@@ -135,13 +142,18 @@ QVariant SimulationMessageModel::data(const QModelIndex &index, int role) const
   QString toolTip;
   QVariant variant = QVariant();
   if (pSimulationMessage) {
-    // create debuglink
-    SimulationOptions simulationOptions = mpSimulationOutputWidget->getSimulationOptions();
-    debugLink = QString("&nbsp;<a href=\"omedittransformationsbrowser://%1?index=%2\">Debug more</a>")
-        .arg(QUrl::fromLocalFile(simulationOptions.getWorkingDirectory() + "/" + simulationOptions.getOutputFileName() + "_info.json").path())
-        .arg(pSimulationMessage->mIndex);
+    if (role == Qt::DisplayRole || role == Qt::ToolTipRole) {
+      loadSimulationMessageText(pSimulationMessage);
+    }
+    // create debuglink. Only the messages with an index have it so don't copy the SimulationOptions for the others.
+    if (!pSimulationMessage->mIndex.isEmpty() && mpSimulationOutputWidget) {
+      SimulationOptions simulationOptions = mpSimulationOutputWidget->getSimulationOptions();
+      debugLink = QString("&nbsp;<a href=\"omedittransformationsbrowser://%1?index=%2\">Debug more</a>")
+          .arg(QUrl::fromLocalFile(simulationOptions.getWorkingDirectory() + "/" + simulationOptions.getOutputFileName() + "_info.json").path())
+          .arg(pSimulationMessage->mIndex);
+    }
     // create display text
-    text = pSimulationMessage->mText + (pSimulationMessage->mIndex.isEmpty() ? "" : debugLink);
+    text = pSimulationMessage->mText + debugLink;
     // create tooltip
     toolTip = QString("%1 | %2 | %3")
         .arg(pSimulationMessage->mStream)
@@ -187,16 +199,20 @@ int SimulationMessageModel::getDepth(const QModelIndex &index) const
 }
 
 /*!
-  Inserts the simulation message in the data.
+  Inserts the simulation message in the data.\n
+  Only the texts of the last SIMULATION_OUTPUT_MAXIMUM_MESSAGES messages shown or inserted are kept in memory.
   \param pSimulationMessage - the simulation message to insert.
+  \sa loadSimulationMessageText()
   */
 void SimulationMessageModel::insertSimulationMessage(SimulationMessage *pSimulationMessage)
 {
   if (pSimulationMessage) {
-    int row = mpRootSimulationMessage->children().size();
+    int row = mpRootSimulationMessage->childrenCount();
     beginInsertRows(QModelIndex(), row, row);
-    mpRootSimulationMessage->insertChild(row, pSimulationMessage);
+    mpRootSimulationMessage->appendChild(pSimulationMessage);
     endInsertRows();
+    appendLoadedMessages(pSimulationMessage);
+    unloadSimulationMessagesText();
   }
 }
 
@@ -224,11 +240,86 @@ QModelIndexList SimulationMessageModel::selectedRows()
 }
 
 /*!
-  Finds the QModelIndex represented by the specified SimulationMessage.
+  Finds the QModelIndex represented by the specified SimulationMessage.\n
+  Constant time since the SimulationMessage knows its row.
   */
 QModelIndex SimulationMessageModel::simulationMessageIndex(const SimulationMessage *pSimulationMessage) const
 {
-  return simulationMessageIndexHelper(pSimulationMessage, mpRootSimulationMessage, QModelIndex());
+  if (!pSimulationMessage || pSimulationMessage == mpRootSimulationMessage) {
+    return QModelIndex();
+  }
+  return createIndex(pSimulationMessage->row(), 0, const_cast<SimulationMessage*>(pSimulationMessage));
+}
+
+/*!
+  Adds the message and its children to the messages whose text is in memory.
+  \param pSimulationMessage - a pointer to SimulationMessage.
+  */
+void SimulationMessageModel::appendLoadedMessages(SimulationMessage *pSimulationMessage)
+{
+  mLoadedMessages.enqueue(pSimulationMessage);
+  foreach (SimulationMessage *pChildSimulationMessage, pSimulationMessage->children()) {
+    appendLoadedMessages(pChildSimulationMessage);
+  }
+}
+
+/*!
+  Reads the text of the message back from the spill file if it is unloaded.\n
+  The message objects are never deleted so the model indexes held by the view stay valid. Only the texts are paged.
+  \param pSimulationMessage - a pointer to SimulationMessage.
+  \sa unloadSimulationMessagesText()
+  */
+void SimulationMessageModel::loadSimulationMessageText(SimulationMessage *pSimulationMessage) const
+{
+  if (pSimulationMessage->mTextOffset < 0 || !pSimulationMessage->mText.isNull()) {
+    return;
+  }
+  if (mSpillFile.seek(pSimulationMessage->mTextOffset)) {
+    QDataStream inStream(&mSpillFile);
+    inStream >> pSimulationMessage->mText >> pSimulationMessage->mIndex;
+  }
+  if (pSimulationMessage->mText.isNull()) {
+    pSimulationMessage->mText = "";
+  }
+  mLoadedMessages.enqueue(pSimulationMessage);
+  unloadSimulationMessagesText();
+}
+
+/*!
+  Moves the texts of the least recently loaded messages to the spill file when more than SIMULATION_OUTPUT_MAXIMUM_MESSAGES are in memory.\n
+  The texts are written once. Unloading a message that is read back before only frees its text.
+  The texts are unloaded in chunks so the file is not touched for every inserted message.
+  \sa loadSimulationMessageText()
+  */
+void SimulationMessageModel::unloadSimulationMessagesText() const
+{
+  if (mSpillFileFailed || mLoadedMessages.size() <= SIMULATION_OUTPUT_MAXIMUM_MESSAGES + SIMULATION_OUTPUT_MAXIMUM_MESSAGES / 10) {
+    return;
+  }
+  if (!mSpillFile.isOpen() && !mSpillFile.open()) {
+    // keep everything in memory.
+    mSpillFileFailed = true;
+    return;
+  }
+  QDataStream outStream(&mSpillFile);
+  mSpillFile.seek(mSpillFile.size());
+  while (mLoadedMessages.size() > SIMULATION_OUTPUT_MAXIMUM_MESSAGES) {
+    SimulationMessage *pSimulationMessage = mLoadedMessages.dequeue();
+    if (pSimulationMessage->mText.isNull()) {
+      continue;
+    }
+    if (pSimulationMessage->mTextOffset < 0) {
+      pSimulationMessage->mTextOffset = mSpillFile.pos();
+      outStream << pSimulationMessage->mText << pSimulationMessage->mIndex;
+      if (outStream.status() != QDataStream::Ok) {
+        pSimulationMessage->mTextOffset = -1;
+        mSpillFileFailed = true;
+        return;
+      }
+    }
+    pSimulationMessage->mText = QString();
+    pSimulationMessage->mIndex = QString();
+  }
 }
 
 /*!
@@ -244,33 +335,13 @@ void SimulationMessageModel::selectedRowsHelper(SimulationMessage *pParentSimula
       if (mpSimulationOutputWidget->getSimulationOutputTree()->selectionModel()->isSelected(index)) {
         mSelectedRowsList.append(index);
       }
-      if (pSimulationMessage->children().size() > 0) {
+      if (pSimulationMessage->childrenCount() > 0) {
         selectedRowsHelper(pSimulationMessage);
       }
     }
   }
 }
 
-/*!
-  Helper function to find the QModelIndex.
-  \sa simulationMessageIndex()
-  */
-QModelIndex SimulationMessageModel::simulationMessageIndexHelper(const SimulationMessage *pSimulationMessage,
-                                                             const SimulationMessage *pParentSimulationMessage,
-                                                             const QModelIndex &parentIndex) const
-{
-  if (pSimulationMessage == pParentSimulationMessage)
-    return parentIndex;
-  for (int i = pParentSimulationMessage->children().size(); --i >= 0; ) {
-    const SimulationMessage *pChildSimulationMessage = pParentSimulationMessage->children().at(i);
-    QModelIndex childIndex = index(i, 0, parentIndex);
-    QModelIndex index = simulationMessageIndexHelper(pSimulationMessage, pChildSimulationMessage, childIndex);
-    if (index.isValid())
-      return index;
-  }
-  return QModelIndex();
-}
-
 /*!
   \class SimulationOutputHandler
   \brief Parses the xml output of simulation executable.
@@ -294,7 +365,7 @@ SimulationOutputHandler::SimulationOutputHandler(SimulationOutputWidget *pSimula
   mLevel = 0;
   mpSimulationMessage = 0;
   if (mpSimulationOutputWidget->isOutputStructured()) {
-    mpSimulationMessageModel = new SimulationMessageModel(mpSimulationOutputWidget);
+    mpSimulationMessageModel = new SimulationMessageModel(mpSimulationOutputWidget, mpSimulationOutputWidget);
   } else {
     mpSimulationMessageModel = 0;
   }
@@ -302,7 +373,7 @@ SimulationOutputHandler::SimulationOutputHandler(SimulationOutputWidget *pSimula
   mXmlSimpleReader.setErrorHandler(this);
   mpXmlInputSource = new QXmlInputSource;
   mpXmlInputSource->setData(simulationOutput.prepend("<root>"));
-  mOutputBuffer = mpXmlInputSource->data();
+  appendOutputBuffer(mpXmlInputSource->data());
   mXmlSimpleReader.parse(mpXmlInputSource, true);
 }
 
@@ -317,10 +388,23 @@ SimulationOutputHandler::~SimulationOutputHandler()
 void SimulationOutputHandler::parseSimulationOutput(QString output)
 {
   mpXmlInputSource->setData(output);
-  mOutputBuffer.append(mpXmlInputSource->data());
+  appendOutputBuffer(mpXmlInputSource->data());
   mXmlSimpleReader.parseContinue();
 }
 
+/*!
+  Appends the output to the buffer used to report the parse errors.\n
+  The parsed output is not needed anymore so only the last SIMULATION_OUTPUT_BUFFER_SIZE characters are kept.
+  The complete output is in the simulation output log file.
+  */
+void SimulationOutputHandler::appendOutputBuffer(const QString &output)
+{
+  mOutputBuffer.append(output);
+  if (mOutputBuffer.size() > 2 * SIMULATION_OUTPUT_BUFFER_SIZE) {
+    mOutputBuffer.remove(0, mOutputBuffer.size() - SIMULATION_OUTPUT_BUFFER_SIZE);
+  }
+}
+
 /*!
   The reader calls this function when it has parsed a start element tag.
   */
@@ -335,7 +419,8 @@ bool SimulationOutputHandler::startElement(const QString &namespaceURI, const QS
     } else {
       mpSimulationMessage = new SimulationMessage;
     }
-    mpSimulationMessage->mStream = atts.value("stream");
+    // share the stream names between the messages.
+    mpSimulationMessage->mStream = *mStreams.insert(atts.value("stream"));
     mpSimulationMessage->mType = StringHandler::getSimulationMessageType(atts.value("type"));
     mpSimulationMessage->mText = Qt::convertFromPlainText(atts.value("text"));
     mpSimulationMessage->mLevel = mLevel;
@@ -343,8 +428,7 @@ bool SimulationOutputHandler::startElement(const QString &namespaceURI, const QS
     if (mLevel > 0) {
       SimulationMessage *pSimulationMessage = mSimulationMessagesLevelMap.value(mLevel - 1, 0);
       if (pSimulationMessage) {
-        mpSimulationMessage->setParent(pSimulationMessage);
-        pSimulationMessage->mChildren.append(mpSimulationMessage);
+        pSimulationMessage->appendChild(mpSimulationMessage);
       }
     }
     mLevel++;
@@ -370,8 +454,12 @@ bool SimulationOutputHandler::endElement(const QString &namespaceURI, const QStr
       if (mpSimulationOutputWidget->isOutputStructured()) {
         mpSimulationMessageModel->insertSimulationMessage(mSimulationMessagesLevelMap.value(0, 0));
       } else {
-        mpSimulationOutputWidget->writeSimulationMessage(mSimulationMessagesLevelMap.value(0, 0));
+        // the text browser keeps its own copy of the message.
+        SimulationMessage *pSimulationMessage = mSimulationMessagesLevelMap.take(0);
+        mpSimulationOutputWidget->writeSimulationMessage(pSimulationMessage);
+        delete pSimulationMessage;
       }
+      mpSimulationMessage = 0;
     }
   }
   return true;
@@ -403,6 +491,7 @@ bool SimulationOutputHandler::fatalError(const QXmlParseException &exception)
     mpSimulationMessageModel->insertSimulationMessage(pSimulationMessage);
   } else {
     mpSimulationOutputWidget->writeSimulationMessage(pSimulationMessage);
+    delete pSimulationMessage;
   }
   return false;
 }
@@ -49,19 +49,31 @@ public:
   QString mIndex;
   QList<SimulationMessage*> mChildren;
   SimulationMessage* mpParentSimulationMessage;
+  /* the position of the message in its parent. */
+  int mRow;
+  /* the position of mText and mIndex in the spill file of SimulationMessageModel. -1 if they are not written yet. */
+  qint64 mTextOffset;
 public:
   SimulationMessage(SimulationMessage *pParentSimulationMessage = 0)
     : mpParentSimulationMessage(pParentSimulationMessage)
-  {mStream = ""; mType = StringHandler::Unknown; mText = ""; mIndex = "";}
+  {mStream = ""; mType = StringHandler::Unknown; mText = ""; mIndex = ""; mRow = 0; mTextOffset = -1;}
+  ~SimulationMessage() {qDeleteAll(mChildren);}
   void setParent(SimulationMessage *pParentSimulationMessage) {mpParentSimulationMessage = pParentSimulationMessage;}
   SimulationMessage *parent() {return mpParentSimulationMessage;}
   SimulationMessage *child(int row) {return mChildren.value(row);}
   QList<SimulationMessage*> children() const {return mChildren;}
-  void insertChild(int position, SimulationMessage *pSimulationMessage) {mChildren.insert(position, pSimulationMessage);}
+  int childrenCount() const {return mChildren.size();}
+  void appendChild(SimulationMessage *pSimulationMessage)
+  {
+    pSimulationMessage->mpParentSimulationMessage = this;
+    pSimulationMessage->mRow = mChildren.size();
+    mChildren.append(pSimulationMessage);
+  }
+  /* O(1) since the row is stored when the message is appended. Qt calls it for every parent() and index() lookup. */
   int row() const
   {
     if (mpParentSimulationMessage) {
-      return mpParentSimulationMessage->mChildren.indexOf(const_cast<SimulationMessage*>(this));
+      return mRow;
     } else {
       return 0;
     }
@@ -73,6 +85,7 @@ class SimulationMessageModel : public QAbstractItemModel
   Q_OBJECT
 public:
   SimulationMessageModel(SimulationOutputWidget *pSimulationOutputWidget, QObject *pParent = 0);
+  ~SimulationMessageModel();
   virtual QModelIndex index(int row, int column, const QModelIndex &parent) const;
   virtual QModelIndex parent(const QModelIndex &child) const;
   virtual int rowCount(const QModelIndex &parent) const;
@@ -88,10 +101,15 @@ private:
   SimulationOutputWidget *mpSimulationOutputWidget;
   SimulationMessage* mpRootSimulationMessage;
   QModelIndexList mSelectedRowsList;
+  /* the texts of the messages not shown recently are moved to the spill file and read back when needed. */
+  mutable QTemporaryFile mSpillFile;
+  mutable bool mSpillFileFailed;
+  mutable QQueue<SimulationMessage*> mLoadedMessages;
 
   void selectedRowsHelper(SimulationMessage *pParentSimulationMessage);
-  QModelIndex simulationMessageIndexHelper(const SimulationMessage *pSimulationMessage, const SimulationMessage *pParentSimulationMessage,
-                                           const QModelIndex &parentIndex) const;
+  void appendLoadedMessages(SimulationMessage *pSimulationMessage);
+  void loadSimulationMessageText(SimulationMessage *pSimulationMessage) const;
+  void unloadSimulationMessagesText() const;
 };
 
 class SimulationOutputHandler : private QXmlDefaultHandler
@@ -101,6 +119,7 @@ private:
   int mLevel;
   SimulationMessage* mpSimulationMessage;
   QMap<int, SimulationMessage*> mSimulationMessagesLevelMap;
+  QSet<QString> mStreams;
   QString mOutputBuffer;
   SimulationMessageModel *mpSimulationMessageModel;
   QXmlSimpleReader mXmlSimpleReader;
@@ -109,6 +128,7 @@ private:
   bool startElement(const QString &namespaceURI, const QString &localName, const QString &qName, const QXmlAttributes &atts);
   bool endElement(const QString &namespaceURI, const QString &localName, const QString &qName);
   bool fatalError(const QXmlParseException &exception);
+  void appendOutputBuffer(const QString &output);
 public:
   SimulationOutputHandler(SimulationOutputWidget *pSimulationOutputWidget, QString simulationOutput);
   ~SimulationOutputHandler();
@@ -140,13 +140,8 @@ void SimulationOutputTree::copyMessages()
     QStringList textToCopy;
     const QModelIndexList modelIndexes = pSimulationMessageModel->selectedRows();
     foreach (QModelIndex modelIndex, modelIndexes) {
-      SimulationMessage *pSimulationMessage = static_cast<SimulationMessage*>(modelIndex.internalPointer());
-      if (pSimulationMessage) {
-        textToCopy.append(QString("%1 | %2 | %3")
-                          .arg(pSimulationMessage->mStream)
-                          .arg(StringHandler::getSimulationMessageTypeString(pSimulationMessage->mType))
-                          .arg(pSimulationMessage->mText));
-      }
+      // the tooltip has the stream, type and text of the message. The model reads the text back if it is unloaded.
+      textToCopy.append(pSimulationMessageModel->data(modelIndex, Qt::ToolTipRole).toString());
     }
     QApplication::clipboard()->setText(textToCopy.join("\n"));
   }
@@ -185,6 +180,7 @@ SimulationOutputWidget::SimulationOutputWidget(SimulationOptions simulationOptio
   // progress label
   mpProgressLabel = new Label;
   mpProgressLabel->setTextFormat(Qt::RichText);
+  mpProgressLabel->setOpenExternalLinks(true);
   mpCancelButton = new QPushButton(tr("Cancel Compilation"));
   mpCancelButton->setEnabled(false);
   connect(mpCancelButton, SIGNAL(clicked()), SLOT(cancelCompilationOrSimulation()));
@@ -206,6 +202,7 @@ SimulationOutputWidget::SimulationOutputWidget(SimulationOptions simulationOptio
     mIsOutputStructured = false;
     // simulation output browser
     mpSimulationOutputTextBrowser = new QTextBrowser;
+    mpSimulationOutputTextBrowser->document()->setMaximumBlockCount(SIMULATION_OUTPUT_MAXIMUM_LINES);
     mpSimulationOutputTextBrowser->setFont(QFont(Helper::monospacedFontInfo.family()));
     mpSimulationOutputTextBrowser->setOpenLinks(false);
     mpSimulationOutputTextBrowser->setOpenExternalLinks(false);
@@ -311,6 +308,9 @@ SimulationOutputWidget::~SimulationOutputWidget()
   if (mpSimulationOutputHandler) {
     delete mpSimulationOutputHandler;
   }
+  if (mSimulationOutputFile.isOpen()) {
+    mSimulationOutputFile.close();
+  }
 }
 
 void SimulationOutputWidget::addGeneratedFileTab(QString fileName)
@@ -333,6 +333,15 @@ void SimulationOutputWidget::addGeneratedFileTab(QString fileName)
   }
 }
 
+/*!
+  Returns true if the simulation output view doesn't show all the messages anymore.
+  */
+bool SimulationOutputWidget::isSimulationOutputTruncated()
+{
+  // the simulation output tree pages the messages so it always shows all of them.
+  return !isOutputStructured() && mpSimulationOutputTextBrowser->document()->blockCount() >= SIMULATION_OUTPUT_MAXIMUM_LINES;
+}
+
 /*!
   Writes the simulation output in a formatted text form.\n
   \param - pSimulationMessage - the simulation output message.
@@ -463,6 +472,24 @@ void SimulationOutputWidget::writeSimulationOutput(QString output, StringHandler
 #endif
 
   mpGeneratedFilesTabWidget->setTabEnabled(0, true);
+  // the complete simulation output is saved in a file since the output view only keeps the last messages.
+  if (mSimulationOutputFile.fileName().isEmpty()) {
+    mSimulationOutputFile.setFileName(QString("%1/%2_output.log").arg(mSimulationOptions.getWorkingDirectory())
+                                      .arg(mSimulationOptions.getOutputFileName()));
+    if (!mSimulationOutputFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+      mpMainWindow->getMessagesWidget()->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0,
+                                                                   GUIMessages::getMessage(GUIMessages::ERROR_OPENING_FILE)
+                                                                   .arg(mSimulationOutputFile.fileName())
+                                                                   .arg(mSimulationOutputFile.errorString()),
+                                                                   Helper::scriptingKind, Helper::warningLevel));
+    }
+  }
+  if (mSimulationOutputFile.isOpen()) {
+    mSimulationOutputFile.write(output.toUtf8());
+    if (textFormat) {
+      mSimulationOutputFile.write("\n");
+    }
+  }
   if (isOutputStructured()) {
     if (textFormat) {
       output = QString("<message stream=\"stdout\" type=\"%1\" text=\"%2\" />")
@@ -508,7 +535,16 @@ void SimulationOutputWidget::simulationProcessFinished(int exitCode, QProcess::E
 {
   Q_UNUSED(exitCode);
   Q_UNUSED(exitStatus);
-  mpProgressLabel->setText(tr("Simulation of <b>%1</b> is finished.").arg(mSimulationOptions.getClassName()));
+  QString text = tr("Simulation of <b>%1</b> is finished.").arg(mSimulationOptions.getClassName());
+  if (mSimulationOutputFile.isOpen()) {
+    mSimulationOutputFile.close();
+    if (isSimulationOutputTruncated()) {
+      text.append(" ").append(tr("Only the last messages are shown. The complete output is saved in <a href=\"%1\">%2</a>.")
+                              .arg(QUrl::fromLocalFile(mSimulationOutputFile.fileName()).toString())
+                              .arg(mSimulationOutputFile.fileName()));
+    }
+  }
+  mpProgressLabel->setText(text);
   mpProgressBar->setValue(mpProgressBar->maximum());
   mpCancelButton->setEnabled(false);
   mpMainWindow->getSimulationDialog()->simulationProcessFinished(mSimulationOptions, mResultFileLastModifiedDateTime);
@@ -42,6 +42,13 @@
 #include "SimulationProcessThread.h"
 #include "SimulationOutputHandler.h"
 
+/* the number of messages whose text is kept in memory by the simulation output tree. The other texts are in a spill file. */
+#define SIMULATION_OUTPUT_MAXIMUM_MESSAGES 10000
+/* the number of lines kept in the simulation output text browser. */
+#define SIMULATION_OUTPUT_MAXIMUM_LINES 100000
+/* the number of characters of the parsed simulation output kept to report the xml parse errors. */
+#define SIMULATION_OUTPUT_BUFFER_SIZE 65536
+
 class SimulationProcessThread;
 class SimulationOutputHandler;
 class SimulationOutputWidget;
@@ -99,6 +106,8 @@ private:
   ArchivedSimulationItem *mpArchivedSimulationItem;
   SimulationProcessThread *mpSimulationProcessThread;
   QDateTime mResultFileLastModifiedDateTime;
+  QFile mSimulationOutputFile;
+  bool isSimulationOutputTruncated();
 public slots:
   void compilationProcessStarted();
   void writeCompilationOutput(QString output, QColor color);
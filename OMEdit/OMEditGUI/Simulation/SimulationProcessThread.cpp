@@ -45,6 +45,8 @@ SimulationProcessThread::SimulationProcessThread(SimulationOutputWidget *pSimula
   mIsCompilationProcessRunning = false;
   mpSimulationProcess = 0;
   mIsSimulationProcessRunning = false;
+  mSimulationProgress = -1;
+  mEmittedSimulationProgress = -1;
 }
 
 void SimulationProcessThread::run()
@@ -225,6 +227,8 @@ void SimulationProcessThread::readSimulationStandardError()
 void SimulationProcessThread::simulationProcessFinished(int exitCode, QProcess::ExitStatus exitStatus)
 {
   mIsSimulationProcessRunning = false;
+  // show the last progress value that is held back by the refresh interval.
+  emitSimulationProgress(true);
   QString exitCodeStr = tr("Simulation process failed. Exited with code %1.").arg(QString::number(exitCode));
   if (exitStatus == QProcess::NormalExit && exitCode == 0) {
     emit sendSimulationOutput(tr("Simulation process finished successfully."), StringHandler::OMEditInfo, true);
@@ -248,24 +252,54 @@ void SimulationProcessThread::createSimulationProgressSocket()
   }
 }
 
+/*!
+ * \brief SimulationProcessThread::readSimulationProgress
+ * Slot activated when the simulation progress socket readyRead signal is raised.\n
+ * Drains all the available data of the socket into a buffer and parses all the complete lines in one go.
+ * Only the latest progress value is kept and the progress bar is updated at most once per refresh interval.
+ */
 void SimulationProcessThread::readSimulationProgress()
 {
   if (sender()) {
     QTcpSocket *pTcpSocket = qobject_cast<QTcpSocket*>(const_cast<QObject*>(sender()));
     if (pTcpSocket) {
-      const int SOCKMAXLEN = 4096;
-      char buf[SOCKMAXLEN];
-      if (pTcpSocket->readLine(buf,SOCKMAXLEN) > 0) {
+      mSimulationProgressBuffer.append(pTcpSocket->readAll());
+      const char *buf = mSimulationProgressBuffer.constData();
+      int lineStart = 0;
+      int lineEnd;
+      while ((lineEnd = mSimulationProgressBuffer.indexOf('\n', lineStart)) != -1) {
         char *msg = 0;
-        double d = strtod(buf, &msg);
-        if (msg == buf || *msg != ' ') {
+        double d = strtod(buf + lineStart, &msg);
+        if (msg == buf + lineStart || *msg != ' ') {
           // do we really need to take care of this communication error?????
           //fprintf(stderr, "TODO: OMEdit GUI: COMM ERROR '%s'", buf);
         } else {
-          emit sendSimulationProgress(d/100.0);
+          mSimulationProgress = d/100.0;
           //fprintf(stderr, "TODO: OMEdit GUI: Display progress (%g%%) and message: %s", d/100.0, msg+1);
         }
+        lineStart = lineEnd + 1;
       }
+      // remove the parsed lines and keep the incomplete line for the next read.
+      mSimulationProgressBuffer.remove(0, lineStart);
+      emitSimulationProgress(false);
     }
   }
 }
+
+/*!
+ * \brief SimulationProcessThread::emitSimulationProgress
+ * Emits the sendSimulationProgress SIGNAL if the progress has changed and the refresh interval has elapsed.
+ * \param force - emit the progress regardless of the refresh interval.
+ */
+void SimulationProcessThread::emitSimulationProgress(bool force)
+{
+  const int refreshInterval = 100;
+  if (mSimulationProgress < 0 || mSimulationProgress == mEmittedSimulationProgress) {
+    return;
+  }
+  if (force || !mSimulationProgressTime.isValid() || mSimulationProgressTime.elapsed() >= refreshInterval) {
+    mSimulationProgressTime.start();
+    mEmittedSimulationProgress = mSimulationProgress;
+    emit sendSimulationProgress(mSimulationProgress);
+  }
+}
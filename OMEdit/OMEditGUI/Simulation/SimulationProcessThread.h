@@ -58,9 +58,14 @@ private:
   bool mIsCompilationProcessRunning;
   QProcess *mpSimulationProcess;
   bool mIsSimulationProcessRunning;
+  QByteArray mSimulationProgressBuffer;
+  int mSimulationProgress;
+  int mEmittedSimulationProgress;
+  QTime mSimulationProgressTime;
 
   void compileModel();
   void runSimulationExecutable();
+  void emitSimulationProgress(bool force);
 private slots:
   void compilationProcessStarted();
   void readCompilationStandardOutput();
@@ -44,6 +44,9 @@ TLMCoSimulationThread::TLMCoSimulationThread(TLMCoSimulationOutputWidget *pTLMCo
   mpMonitorProcess = 0;
   setIsMonitorProcessRunning(false);
   mpProgressFileTimer = 0;
+  mProgressFileOffset = 0;
+  mProgress = -1;
+  mEmittedProgress = -1;
 }
 
 void TLMCoSimulationThread::run()
@@ -206,6 +209,9 @@ void TLMCoSimulationThread::monitorProcessFinished(int exitCode, QProcess::ExitS
   // stop the timer that reads the progres file i.e <model>.run
   if (mpProgressFileTimer) {
     mpProgressFileTimer->stop();
+    // read the last records and report the final progress.
+    progressFileChanged(true);
+    emitProgress(true);
   }
   QString exitCodeStr = tr("TLMMonitor process failed. Exited with code %1.").arg(QString::number(exitCode));
   if (exitStatus == QProcess::NormalExit && exitCode == 0) {
@@ -218,23 +224,74 @@ void TLMCoSimulationThread::monitorProcessFinished(int exitCode, QProcess::ExitS
   emit sendMonitorFinished(exitCode, exitStatus);
 }
 
-void TLMCoSimulationThread::progressFileChanged()
+/*!
+ * \brief TLMCoSimulationThread::progressFileChanged
+ * Slot activated when mpProgressFileTimer timeout SIGNAL is raised.\n
+ * Reads only the records appended to the progress file since the last call.
+ * Starts again from the beginning if the file is truncated or replaced.
+ * \param finished - if true the last line is parsed even if it is not terminated.
+ */
+void TLMCoSimulationThread::progressFileChanged(bool finished)
 {
-  if (mProgressFile.open(QIODevice::ReadOnly)) {
-    QTextStream textStream(&mProgressFile);
-    while (!textStream.atEnd()) {
-      QString currentLine = textStream.readLine();
-      if (currentLine.startsWith("Progress")) {
-        QString progress = currentLine.mid(QString("Progress  : ").length());
-        progress = progress.remove("%").trimmed();
-        emit sendManagerProgress(progress.toDouble());
-      }
-    }
-    mProgressFile.close();
-  } else {
+  if (!mProgressFile.open(QIODevice::ReadOnly)) {
     MessagesWidget *pMessagesWidget = mpTLMCoSimulationOutputWidget->getMainWindow()->getMessagesWidget();
     pMessagesWidget->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0,
                                                GUIMessages::getMessage(GUIMessages::UNABLE_TO_OPEN_FILE).arg(mProgressFile.fileName()),
                                                Helper::scriptingKind, Helper::errorLevel));
+    return;
+  }
+  // the bytes before the offset must be the ones read last time otherwise the file is truncated or replaced.
+  bool restart = mProgressFile.size() < mProgressFileOffset;
+  if (!restart && !mProgressFileTail.isEmpty()) {
+    mProgressFile.seek(mProgressFileOffset - mProgressFileTail.size());
+    restart = mProgressFile.read(mProgressFileTail.size()) != mProgressFileTail;
+  }
+  if (restart) {
+    mProgressFileOffset = 0;
+    mProgressFileTail.clear();
+    mProgressFileBuffer.clear();
+  }
+  mProgressFile.seek(mProgressFileOffset);
+  QByteArray data = mProgressFile.readAll();
+  mProgressFileOffset += data.size();
+  mProgressFile.close();
+  if (!data.isEmpty()) {
+    mProgressFileTail = data.right(64);
+    mProgressFileBuffer.append(data);
+  }
+  if (finished && !mProgressFileBuffer.isEmpty()) {
+    mProgressFileBuffer.append('\n');
+  }
+  // parse the complete lines. Keep the incomplete last line for the next call.
+  int start = 0;
+  int end;
+  while ((end = mProgressFileBuffer.indexOf('\n', start)) >= 0) {
+    QByteArray currentLine = mProgressFileBuffer.mid(start, end - start);
+    if (currentLine.startsWith("Progress")) {
+      QString progress = QString(currentLine.mid(QString("Progress  : ").length()));
+      progress = progress.remove("%").trimmed();
+      mProgress = progress.toDouble();
+    }
+    start = end + 1;
+  }
+  mProgressFileBuffer.remove(0, start);
+  emitProgress(false);
+}
+
+/*!
+ * \brief TLMCoSimulationThread::emitProgress
+ * Emits the sendManagerProgress SIGNAL if the progress has changed and the refresh interval has elapsed.
+ * \param force - emit the progress regardless of the refresh interval.
+ */
+void TLMCoSimulationThread::emitProgress(bool force)
+{
+  const int refreshInterval = 100;
+  if (mProgress < 0 || mProgress == mEmittedProgress) {
+    return;
+  }
+  if (force || !mProgressTime.isValid() || mProgressTime.elapsed() >= refreshInterval) {
+    mProgressTime.start();
+    mEmittedProgress = mProgress;
+    emit sendManagerProgress(mProgress);
   }
 }
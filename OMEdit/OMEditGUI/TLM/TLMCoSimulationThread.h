@@ -63,9 +63,16 @@ private:
   bool mIsMonitorProcessRunning;
   QFile mProgressFile;
   QTimer *mpProgressFileTimer;
+  qint64 mProgressFileOffset;
+  QByteArray mProgressFileTail;
+  QByteArray mProgressFileBuffer;
+  int mProgress;
+  int mEmittedProgress;
+  QTime mProgressTime;
 
   void runManager();
   void runMonitor();
+  void emitProgress(bool force);
 private slots:
   void managerProcessStarted();
   void readManagerStandardOutput();
@@ -75,7 +82,7 @@ private slots:
   void readMonitorStandardOutput();
   void readMonitorStandardError();
   void monitorProcessFinished(int exitCode, QProcess::ExitStatus exitStatus);
-  void progressFileChanged();
+  void progressFileChanged(bool finished = false);
 signals:
   void sendManagerStarted();
   void sendManagerOutput(QString, StringHandler::SimulationMessageType type);
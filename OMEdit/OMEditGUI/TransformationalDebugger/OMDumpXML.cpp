@@ -38,6 +38,7 @@
 #include <QtGui>
 #include <QDebug>
 #include <QXmlStreamReader>
+#include <string.h>
 #include "OMDumpXML.h"
 #include "diff_match_patch.h"
 
@@ -199,7 +200,6 @@ OMVariable::OMVariable(const OMVariable &var)
   definedIn = var.definedIn;
   usedIn = var.usedIn;
   foreach (OMOperation *op, var.ops) {
-    qDebug() << "dynamic_cast op: " << op->toString();
     if (dynamic_cast<OMOperationSimplify*>(op))
       ops.append(new OMOperationSimplify(*dynamic_cast<OMOperationSimplify*>(op)));
     else if (dynamic_cast<OMOperationScalarize*>(op))
@@ -271,6 +271,265 @@ QString OMEquation::toString()
   }
 }
 
+/*!
+ * \param pData - the JSON document. The data must stay valid as long as the reader is used.
+ * \param size - the size of the document.
+ */
+JsonStreamReader::JsonStreamReader(const char *pData, qint64 size)
+  : mpData(pData), mSize(size), mPosition(0), mHasError(pData == 0)
+{
+}
+
+/*!
+ * \brief JsonStreamReader::readObjectStart
+ * Reads the start of an object.
+ * \return false if the next value is not an object.
+ */
+bool JsonStreamReader::readObjectStart()
+{
+  skipWhiteSpace();
+  return consume('{');
+}
+
+/*!
+ * \brief JsonStreamReader::readNextKey
+ * Reads the key of the next member of the current object. The value of the member must be read or skipped next.
+ * \param key
+ * \return false at the end of the object.
+ */
+bool JsonStreamReader::readNextKey(QString &key)
+{
+  skipWhiteSpace();
+  if (mHasError || mPosition >= mSize || mpData[mPosition] == '}') {
+    mPosition++;
+    return false;
+  }
+  if (mpData[mPosition] == ',') {
+    mPosition++;
+    skipWhiteSpace();
+  }
+  key = readString();
+  skipWhiteSpace();
+  return consume(':');
+}
+
+/*!
+ * \brief JsonStreamReader::readArrayStart
+ * Reads the start of an array.
+ * \return false if the next value is not an array.
+ */
+bool JsonStreamReader::readArrayStart()
+{
+  skipWhiteSpace();
+  return consume('[');
+}
+
+/*!
+ * \brief JsonStreamReader::readNextElement
+ * Moves to the next element of the current array. The element must be read or skipped next.
+ * \return false at the end of the array.
+ */
+bool JsonStreamReader::readNextElement()
+{
+  skipWhiteSpace();
+  if (mHasError || mPosition >= mSize || mpData[mPosition] == ']') {
+    mPosition++;
+    return false;
+  }
+  if (mpData[mPosition] == ',') {
+    mPosition++;
+  }
+  return true;
+}
+
+/*!
+ * \brief JsonStreamReader::readValue
+ * Reads the next value. Objects are returned as QVariantMap and arrays as QVariantList.
+ * \return
+ */
+QVariant JsonStreamReader::readValue()
+{
+  skipWhiteSpace();
+  if (mHasError || mPosition >= mSize) {
+    mHasError = true;
+    return QVariant();
+  }
+  switch (mpData[mPosition]) {
+    case '{': {
+      QVariantMap map;
+      QString key;
+      mPosition++;
+      while (readNextKey(key)) {
+        map.insert(key, readValue());
+      }
+      return map;
+    }
+    case '[': {
+      QVariantList list;
+      mPosition++;
+      while (readNextElement()) {
+        list.append(readValue());
+      }
+      return list;
+    }
+    case '"':
+      return readString();
+    case 't':
+      mPosition += 4;
+      return true;
+    case 'f':
+      mPosition += 5;
+      return false;
+    case 'n':
+      mPosition += 4;
+      return QVariant();
+    default:
+      return readNumber();
+  }
+}
+
+/*!
+ * \brief JsonStreamReader::skipValue
+ * Skips the next value without converting it.
+ */
+void JsonStreamReader::skipValue()
+{
+  skipWhiteSpace();
+  if (mHasError || mPosition >= mSize) {
+    mHasError = true;
+    return;
+  }
+  char c = mpData[mPosition];
+  if (c == '"') {
+    skipString();
+  } else if (c == '{' || c == '[') {
+    int depth = 0;
+    while (mPosition < mSize) {
+      c = mpData[mPosition];
+      if (c == '"') {
+        skipString();
+        continue;
+      } else if (c == '{' || c == '[') {
+        depth++;
+      } else if (c == '}' || c == ']') {
+        depth--;
+      }
+      mPosition++;
+      if (depth == 0) {
+        return;
+      }
+    }
+    mHasError = true;
+  } else {
+    while (mPosition < mSize && !strchr(",}] \t\r\n", mpData[mPosition])) {
+      mPosition++;
+    }
+  }
+}
+
+void JsonStreamReader::skipWhiteSpace()
+{
+  while (mPosition < mSize && (mpData[mPosition] == ' ' || mpData[mPosition] == '\t' || mpData[mPosition] == '\r' || mpData[mPosition] == '\n')) {
+    mPosition++;
+  }
+}
+
+bool JsonStreamReader::consume(char c)
+{
+  if (mHasError || mPosition >= mSize || mpData[mPosition] != c) {
+    mHasError = true;
+    return false;
+  }
+  mPosition++;
+  return true;
+}
+
+/*!
+ * \brief JsonStreamReader::readString
+ * Reads a string and decodes the escape sequences.
+ * \return
+ */
+QString JsonStreamReader::readString()
+{
+  QString result;
+  if (!consume('"')) {
+    return result;
+  }
+  qint64 start = mPosition;
+  while (mPosition < mSize) {
+    char c = mpData[mPosition];
+    if (c == '"') {
+      result.append(QString::fromUtf8(mpData + start, mPosition - start));
+      mPosition++;
+      return result;
+    } else if (c == '\\' && mPosition + 1 < mSize) {
+      result.append(QString::fromUtf8(mpData + start, mPosition - start));
+      mPosition++;
+      switch (mpData[mPosition]) {
+        case 'b': result.append('\b'); break;
+        case 'f': result.append('\f'); break;
+        case 'n': result.append('\n'); break;
+        case 'r': result.append('\r'); break;
+        case 't': result.append('\t'); break;
+        case 'u':
+          if (mPosition + 4 < mSize) {
+            result.append(QChar(QByteArray(mpData + mPosition + 1, 4).toUShort(0, 16)));
+            mPosition += 4;
+          }
+          break;
+        default: result.append(QLatin1Char(mpData[mPosition])); break;
+      }
+      mPosition++;
+      start = mPosition;
+    } else {
+      mPosition++;
+    }
+  }
+  mHasError = true;
+  return result;
+}
+
+void JsonStreamReader::skipString()
+{
+  mPosition++;
+  while (mPosition < mSize) {
+    if (mpData[mPosition] == '\\') {
+      mPosition += 2;
+    } else if (mpData[mPosition++] == '"') {
+      return;
+    }
+  }
+  mHasError = true;
+}
+
+/*!
+ * \brief JsonStreamReader::readNumber
+ * Reads a number. Integers are returned as qlonglong and the rest as double.
+ * \return
+ */
+QVariant JsonStreamReader::readNumber()
+{
+  qint64 start = mPosition;
+  bool isReal = false;
+  while (mPosition < mSize && strchr("+-0123456789.eE", mpData[mPosition])) {
+    if (mpData[mPosition] == '.' || mpData[mPosition] == 'e' || mpData[mPosition] == 'E') {
+      isReal = true;
+    }
+    mPosition++;
+  }
+  if (mPosition == start) {
+    mHasError = true;
+    return QVariant();
+  }
+  QByteArray number = QByteArray::fromRawData(mpData + start, mPosition - start);
+  bool ok;
+  QVariant result = isReal ? QVariant(number.toDouble(&ok)) : QVariant(number.toLongLong(&ok));
+  if (!ok) {
+    mHasError = true;
+  }
+  return result;
+}
+
 MyHandler::MyHandler(QFile &file, QHash<QString,OMVariable> &variables, QList<OMEquation*> &equations) : variables(variables), equations(equations)
 {
   hasOperationsEnabled = false;
@@ -41,6 +41,7 @@
 #include <QFile>
 #include <QXmlDefaultHandler>
 #include <QHash>
+#include <QVariant>
 
 class OMOperation {
 public:
@@ -188,6 +189,34 @@ struct OMEquation {
   QString toString();
 };
 
+/*!
+ * \class JsonStreamReader
+ * \brief A pull reader for JSON documents.\n
+ * Reads the document from a buffer one member at a time so large files like info.json are not converted into one big QVariantMap.
+ * Only the values requested with readValue() are converted into QVariant.
+ */
+class JsonStreamReader {
+public:
+  JsonStreamReader(const char *pData, qint64 size);
+  bool hasError() const {return mHasError;}
+  bool readObjectStart();
+  bool readNextKey(QString &key);
+  bool readArrayStart();
+  bool readNextElement();
+  QVariant readValue();
+  void skipValue();
+private:
+  const char *mpData;
+  qint64 mSize;
+  qint64 mPosition;
+  bool mHasError;
+  void skipWhiteSpace();
+  bool consume(char c);
+  QString readString();
+  void skipString();
+  QVariant readNumber();
+};
+
 class MyHandler : private QXmlDefaultHandler {
 public:
   bool hasOperationsEnabled;
@@ -536,6 +536,7 @@ TransformationsWidget::TransformationsWidget(QString infoXMLFullFileName, MainWi
   mpEquationsTreeWidget = new EquationTreeWidget(this);
   mpEquationsTreeWidget->setObjectName("TreeWithBranches");
   mpEquationsTreeWidget->setIndentation(Helper::treeIndentation);
+  connect(mpEquationsTreeWidget, SIGNAL(itemExpanded(QTreeWidgetItem*)), SLOT(fetchNestedEquations(QTreeWidgetItem*)));
   QGridLayout *pEquationsGridLayout = new QGridLayout;
   pEquationsGridLayout->setSpacing(1);
   pEquationsGridLayout->setContentsMargins(0, 0, 0, 0);
@@ -764,7 +765,7 @@ static OMOperation* variantToOperationPtr(QVariantMap var)
 }
 
 
-static void variantToSource(QVariantMap var, OMInfo &info, QStringList &types, QList<OMOperation*> &ops)
+static void variantToSource(const QVariantMap &var, OMInfo &info, QStringList &types, QList<OMOperation*> &ops)
 {
   QVariantMap vinfo = var["info"].toMap();
   info.file = vinfo["file"].toString();
@@ -782,8 +783,12 @@ static void variantToSource(QVariantMap var, OMInfo &info, QStringList &types, Q
   }
 }
 
-static OMEquation* getOMEquation(QList<OMEquation*> equations, int index)
+static OMEquation* getOMEquation(const QList<OMEquation*> &equations, int index)
 {
+  /* equations are normally stored at their own index. */
+  if (index > 0 && index < equations.size() && equations[index]->index == index) {
+    return equations[index];
+  }
   for (int i = 1 ; i < equations.size() ; i++) {
     if (equations[i]->index == index) {
       return equations[i];
@@ -799,71 +804,94 @@ void TransformationsWidget::loadTransformations()
   mVariables.clear();
   hasOperationsEnabled = false;
   if (mInfoXMLFullFileName.endsWith(".json")) {
-    QJson::Parser parser;
-    bool ok;
-    QVariantMap result;
-    result = parser.parse(&file, &ok).toMap();
-    if (!ok) {
+    if (!file.open(QIODevice::ReadOnly)) {
       QMessageBox::critical(this, QString(Helper::applicationName).append(" - ").append(Helper::parsingFailedJson), Helper::parsingFailedJson + ": " + mInfoXMLFullFileName, Helper::ok);
       return;
     }
-    QVariantMap vars = result["variables"].toMap();
-    QVariantList eqs = result["equations"].toList();
-    for(QVariantMap::const_iterator iter = vars.begin(); iter != vars.end(); ++iter) {
-      QVariantMap value = iter.value().toMap();
-      OMVariable *var = new OMVariable();
-      var->name = iter.key();
-      var->comment = value["comment"].toString();
-      variantToSource(value["source"].toMap(), var->info, var->types, var->ops);
-      if (!hasOperationsEnabled && var->ops.size() > 0) {
-        hasOperationsEnabled = true;
-      }
-      mVariables[iter.key()] = *var;
-    }
-    mpTVariablesTreeModel->insertTVariablesItems(mVariables);
-    for (int i=0; i<eqs.size(); i++) {
-      mEquations << new OMEquation();
+    /* map the file instead of reading it into memory. Fall back to reading if mapping is not possible. */
+    QByteArray contents;
+    const char *pData = (const char*)file.map(0, file.size());
+    qint64 size = file.size();
+    if (!pData) {
+      contents = file.readAll();
+      pData = contents.constData();
+      size = contents.size();
     }
-    for (int i=0; i<eqs.size(); i++) {
-      QVariantMap veq = eqs[i].toMap();
-      OMEquation *eq = mEquations[i];
-      eq->section = veq["section"].toString();
-      if (veq["eqIndex"].toInt() != i) {
-        QMessageBox::critical(this, QString(Helper::applicationName).append(" - ").append(Helper::parsingFailedJson), Helper::parsingFailedJson + QString(": got index ") + veq["eqIndex"].toString() + QString(" expected ") + QString::number(i), Helper::ok);
-        return;
-      }
-      eq->index = i;
-      eq->profileBlock = -1;
-      if (veq.find("parent") != veq.end()) {
-        eq->parent = veq["parent"].toInt();
-        mEquations[eq->parent]->eqs << eq->index;
-      } else {
-        eq->parent = 0;
-      }
-      if (veq.find("defines") != veq.end()) {
-        eq->defines = variantListToStringList(veq["defines"].toList());
-        foreach (QString v, eq->defines) {
-          mVariables[v].definedIn << eq->index;
+    JsonStreamReader reader(pData, size);
+    QString key;
+    reader.readObjectStart();
+    while (reader.readNextKey(key)) {
+      if (key == "variables") {
+        QString name;
+        reader.readObjectStart();
+        while (reader.readNextKey(name)) {
+          QVariantMap value = reader.readValue().toMap();
+          OMVariable &var = mVariables[name];
+          var.name = name;
+          var.comment = value["comment"].toString();
+          variantToSource(value["source"].toMap(), var.info, var.types, var.ops);
+          if (!hasOperationsEnabled && var.ops.size() > 0) {
+            hasOperationsEnabled = true;
+          }
         }
-      }
-      if (veq.find("uses") != veq.end()) {
-        eq->depends = variantListToStringList(veq["uses"].toList());
-        foreach (QString v, eq->depends) {
-          mVariables[v].usedIn << eq->index;
+      } else if (key == "equations") {
+        reader.readArrayStart();
+        for (int i = 0 ; reader.readNextElement() ; i++) {
+          QVariantMap veq = reader.readValue().toMap();
+          if (veq["eqIndex"].toInt() != i) {
+            QMessageBox::critical(this, QString(Helper::applicationName).append(" - ").append(Helper::parsingFailedJson), Helper::parsingFailedJson + QString(": got index ") + veq["eqIndex"].toString() + QString(" expected ") + QString::number(i), Helper::ok);
+            return;
+          }
+          while (mEquations.size() <= i) {
+            mEquations << new OMEquation();
+          }
+          OMEquation *eq = mEquations[i];
+          eq->section = veq["section"].toString();
+          eq->index = i;
+          eq->profileBlock = -1;
+          if (veq.find("parent") != veq.end()) {
+            eq->parent = veq["parent"].toInt();
+            while (mEquations.size() <= eq->parent) {
+              mEquations << new OMEquation();
+            }
+            mEquations[eq->parent]->eqs << eq->index;
+          } else {
+            eq->parent = 0;
+          }
+          if (veq.find("defines") != veq.end()) {
+            eq->defines = variantListToStringList(veq["defines"].toList());
+            foreach (QString v, eq->defines) {
+              mVariables[v].definedIn << eq->index;
+            }
+          }
+          if (veq.find("uses") != veq.end()) {
+            eq->depends = variantListToStringList(veq["uses"].toList());
+            foreach (QString v, eq->depends) {
+              mVariables[v].usedIn << eq->index;
+            }
+          }
+          eq->text = variantListToStringList(veq["equation"].toList());
+          eq->tag = veq["tag"].toString();
+          if (veq.find("display") != veq.end()) {
+            eq->display = veq["display"].toString();
+          } else {
+            eq->display = eq->tag;
+          }
+          variantToSource(veq["source"].toMap(), eq->info, eq->types, eq->ops);
+          if (!hasOperationsEnabled && eq->ops.size() > 0) {
+            hasOperationsEnabled = true;
+          }
         }
-      }
-      eq->text = variantListToStringList(veq["equation"].toList());
-      eq->tag = veq["tag"].toString();
-      if (veq.find("display") != veq.end()) {
-        eq->display = veq["display"].toString();
       } else {
-        eq->display = eq->tag;
-      }
-      variantToSource(veq["source"].toMap(), eq->info, eq->types, eq->ops);
-      if (!hasOperationsEnabled && eq->ops.size() > 0) {
-        hasOperationsEnabled = true;
+        reader.skipValue();
       }
     }
+    file.close();
+    if (reader.hasError()) {
+      QMessageBox::critical(this, QString(Helper::applicationName).append(" - ").append(Helper::parsingFailedJson), Helper::parsingFailedJson + ": " + mInfoXMLFullFileName, Helper::ok);
+      return;
+    }
+    mpTVariablesTreeModel->insertTVariablesItems(mVariables);
     parseProfiling(mProfJSONFullFileName);
     fetchEquations();
   } else {
@@ -972,6 +1000,10 @@ QTreeWidgetItem* TransformationsWidget::makeEquationTreeWidgetItem(int equationI
   pEquationTreeItem->setToolTip(4, "Maximum execution time in a single step");
   pEquationTreeItem->setToolTip(5, "Total time excluding the overhead of measuring.");
   pEquationTreeItem->setToolTip(6, "Fraction of time, 100% is the total time of all non-child equations.");
+  /* nested equations are created when the item is expanded. */
+  if (!equation->eqs.isEmpty()) {
+    pEquationTreeItem->setChildIndicatorPolicy(QTreeWidgetItem::ShowIndicator);
+  }
   return pEquationTreeItem;
 }
 
@@ -982,35 +1014,66 @@ void TransformationsWidget::fetchEquations()
     QTreeWidgetItem *pEquationTreeItem = makeEquationTreeWidgetItem(i,0);
     if (pEquationTreeItem) {
       mpEquationsTreeWidget->addTopLevelItem(pEquationTreeItem);
-      fetchNestedEquations(pEquationTreeItem, i);
     }
   }
 }
 
-void TransformationsWidget::fetchNestedEquations(QTreeWidgetItem *pParentTreeWidgetItem, int index)
+/*!
+ * \brief TransformationsWidget::fetchNestedEquations
+ * Creates the child items of the equation item. The nested equations are only created when the item is expanded.
+ * \param pParentTreeWidgetItem
+ */
+void TransformationsWidget::fetchNestedEquations(QTreeWidgetItem *pParentTreeWidgetItem)
 {
+  if (!pParentTreeWidgetItem || pParentTreeWidgetItem->childCount() > 0) {
+    return;
+  }
+  int index = pParentTreeWidgetItem->text(0).toInt();
+  if (index <= 0 || index >= mEquations.size()) {
+    return;
+  }
   foreach (int nestedIndex, mEquations[index]->eqs)
   {
-    // OMEquation *nestedEquation = mpInfoXMLFileHandler->equations[nestedIndex];
     QTreeWidgetItem *pNestedEquationTreeItem = makeEquationTreeWidgetItem(nestedIndex,1);
     if (pNestedEquationTreeItem) {
       pParentTreeWidgetItem->addChild(pNestedEquationTreeItem);
-      fetchNestedEquations(pNestedEquationTreeItem, nestedIndex);
     }
   }
+  pParentTreeWidgetItem->setChildIndicatorPolicy(QTreeWidgetItem::DontShowIndicatorWhenChildless);
 }
 
+/*!
+ * \brief TransformationsWidget::findEquationTreeItem
+ * Finds the equation item. Creates the items of the parent equations if they are not created yet.
+ * \param equationIndex
+ * \return
+ */
 QTreeWidgetItem* TransformationsWidget::findEquationTreeItem(int equationIndex)
 {
-  QTreeWidgetItemIterator it(mpEquationsTreeWidget);
-  while (*it)
-  {
-    QTreeWidgetItem *pEquationTreeItem = dynamic_cast<QTreeWidgetItem*>(*it);
-    if (pEquationTreeItem->text(0).toInt() == equationIndex)
-      return pEquationTreeItem;
-    ++it;
+  /* the chain of equations from the top level equation to the equation. */
+  QList<int> parents;
+  for (int index = equationIndex ; index > 0 && index < mEquations.size() && parents.size() < mEquations.size() ; index = mEquations[index]->parent) {
+    parents.prepend(index);
   }
-  return 0;
+  QTreeWidgetItem *pEquationTreeItem = 0;
+  for (int i = 0 ; i < mpEquationsTreeWidget->topLevelItemCount() && !parents.isEmpty() ; i++) {
+    if (mpEquationsTreeWidget->topLevelItem(i)->text(0).toInt() == parents.first()) {
+      pEquationTreeItem = mpEquationsTreeWidget->topLevelItem(i);
+      break;
+    }
+  }
+  for (int i = 1 ; i < parents.size() && pEquationTreeItem ; i++) {
+    fetchNestedEquations(pEquationTreeItem);
+    QTreeWidgetItem *pParentTreeWidgetItem = pEquationTreeItem;
+    pEquationTreeItem = 0;
+    for (int j = 0 ; j < pParentTreeWidgetItem->childCount() ; j++) {
+      if (pParentTreeWidgetItem->child(j)->text(0).toInt() == parents.at(i)) {
+        pEquationTreeItem = pParentTreeWidgetItem->child(j);
+        break;
+      }
+    }
+  }
+  return pEquationTreeItem;
 }
 
 #include <qwt_plot.h>
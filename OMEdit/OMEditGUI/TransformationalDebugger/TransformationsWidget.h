@@ -175,7 +175,6 @@ public:
   void fetchUsedInEquations(const OMVariable &variable);
   void fetchOperations(const OMVariable &variable);
   void fetchEquations();
-  void fetchNestedEquations(QTreeWidgetItem *pParentTreeWidgetItem, int index);
   QTreeWidgetItem* findEquationTreeItem(int equationIndex);
   void fetchEquationData(int equationIndex);
   void fetchDefines(OMEquation *equation);
@@ -220,6 +219,7 @@ public slots:
   void findVariables();
   void fetchVariableData(const QModelIndex &index);
   void fetchEquationData(QTreeWidgetItem *pEquationTreeItem, int column);
+  void fetchNestedEquations(QTreeWidgetItem *pParentTreeWidgetItem);
 };
 
 #endif // TRANSFORMATIONSWIDGET_H
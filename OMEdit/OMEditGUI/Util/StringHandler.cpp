@@ -1592,3 +1592,280 @@ bool StringHandler::isFileWritAble(QString filePath)
     return true;
   }
 }
+
+/*!
+ * \class OMCValueTree
+ * \brief A lightweight parse tree of the OMC value syntax.
+ */
+/*!
+ * \param value - the string to parse. The string is implicitly shared so it is not copied.
+ */
+OMCValueTree::OMCValueTree(const QString &value)
+  : mValue(value)
+{
+  parse();
+}
+
+/*!
+ * \brief OMCValueTree::parse
+ * Tokenizes the string in one pass and creates the nodes.
+ */
+void OMCValueTree::parse()
+{
+  const QChar *pData = mValue.constData();
+  const int length = mValue.length();
+  // count the separators first so the nodes are allocated once.
+  int capacity = 2;
+  for (int i = 0 ; i < length ; i++) {
+    if (pData[i] == QLatin1Char(',') || pData[i] == QLatin1Char('{')) {
+      capacity++;
+    }
+  }
+  mItems.reserve(capacity);
+  addItem(-1, 0, length, true);
+  QVarLengthArray<Frame, 16> frames;
+  Frame rootFrame = {0, 0, false};
+  frames.append(rootFrame);
+  int depth = 0;
+  for (int i = 0 ; i < length ; i++) {
+    const ushort c = pData[i].unicode();
+    // skip the strings and the quoted identifiers
+    if (c == '"' || c == '\'') {
+      for (i++ ; i < length ; i++) {
+        if (pData[i] == QLatin1Char('\\')) {
+          i++;
+        } else if (pData[i].unicode() == c) {
+          break;
+        }
+      }
+      continue;
+    }
+    // skip the contents of the parentheses and the arrays that are part of a value e.g., x = {1, 2}
+    if (depth > 0) {
+      if (c == '(' || c == '{') {
+        depth++;
+      } else if (c == ')' || c == '}') {
+        depth--;
+      }
+      continue;
+    }
+    Frame &frame = frames.last();
+    if (c == '{' && !frame.mElementIsArray && isBlank(frame.mElementStart, i)) {
+      frame.mElementIsArray = true;
+      Frame arrayFrame = {addItem(frame.mItem, i, 0, true), i + 1, false};
+      frames.append(arrayFrame);
+    } else if (c == '(' || c == '{') {
+      depth++;
+    } else if (c == ',' || (c == '}' && frames.size() > 1)) {
+      if (!frame.mElementIsArray) {
+        // an empty array has no elements
+        addElement(frame.mItem, frame.mElementStart, i, c == ',');
+      }
+      if (c == ',') {
+        frame.mElementStart = i + 1;
+        frame.mElementIsArray = false;
+      } else {
+        mItems[frame.mItem].mLength = i + 1 - mItems.at(frame.mItem).mPosition;
+        frames.removeLast();
+      }
+    }
+  }
+  // finish the last elements. The arrays are only left open if the string is malformed.
+  while (!frames.isEmpty()) {
+    const Frame &frame = frames.last();
+    if (!frame.mElementIsArray) {
+      addElement(frame.mItem, frame.mElementStart, length, false);
+    }
+    mItems[frame.mItem].mLength = length - mItems.at(frame.mItem).mPosition;
+    frames.removeLast();
+  }
+  // place the children of each node next to each other so they can be accessed by index.
+  mChildren.resize(mItems.size() - 1);
+  int childrenIndex = 0;
+  for (int i = 0 ; i < mItems.size() ; i++) {
+    mItems[i].mChildrenIndex = childrenIndex;
+    childrenIndex += mItems.at(i).mChildrenCount;
+    mItems[i].mChildrenCount = 0;
+  }
+  for (int i = 1 ; i < mItems.size() ; i++) {
+    Item &parent = mItems[mItems.at(i).mParent];
+    mChildren[parent.mChildrenIndex + parent.mChildrenCount++] = i;
+  }
+}
+
+/*!
+ * \brief OMCValueTree::addItem
+ * Adds a node to the tree.
+ * \return the index of the node.
+ */
+int OMCValueTree::addItem(int parent, int position, int length, bool array)
+{
+  Item item = {position, length, parent, 0, 0, array};
+  mItems.append(item);
+  if (parent >= 0) {
+    mItems[parent].mChildrenCount++;
+  }
+  return mItems.size() - 1;
+}
+
+/*!
+ * \brief OMCValueTree::addElement
+ * Adds the trimmed text between start and end as an element of the parent.\n
+ * An empty text is only added if the parent already has elements or if addEmpty is true. So {} has no elements.
+ */
+void OMCValueTree::addElement(int parent, int start, int end, bool addEmpty)
+{
+  const QChar *pData = mValue.constData();
+  while (start < end && pData[start].isSpace()) {
+    start++;
+  }
+  while (end > start && pData[end - 1].isSpace()) {
+    end--;
+  }
+  if (addEmpty || start < end || mItems.at(parent).mChildrenCount > 0) {
+    addItem(parent, start, end - start, false);
+  }
+}
+
+/*!
+ * \brief OMCValueTree::isBlank
+ * Returns true if the text between start and end only contains spaces.
+ */
+bool OMCValueTree::isBlank(int start, int end) const
+{
+  const QChar *pData = mValue.constData();
+  for (int i = start ; i < end ; i++) {
+    if (!pData[i].isSpace()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/*!
+ * \brief OMCValueTree::Node::isArray
+ * Returns true if the node is an array or the top level list.
+ * \return
+ */
+bool OMCValueTree::Node::isArray() const
+{
+  return isValid() && mpTree->mItems.at(mIndex).mArray;
+}
+
+/*!
+ * \brief OMCValueTree::Node::size
+ * Returns the number of elements of an array.
+ * \return
+ */
+int OMCValueTree::Node::size() const
+{
+  return isValid() ? mpTree->mItems.at(mIndex).mChildrenCount : 0;
+}
+
+/*!
+ * \brief OMCValueTree::Node::at
+ * Returns the element of an array at index. Returns an invalid node if the index is out of range.
+ * \param index
+ * \return
+ */
+OMCValueTree::Node OMCValueTree::Node::at(int index) const
+{
+  if (index < 0 || index >= size()) {
+    return Node();
+  }
+  return Node(mpTree, mpTree->mChildren.at(mpTree->mItems.at(mIndex).mChildrenIndex + index));
+}
+
+/*!
+ * \brief OMCValueTree::Node::toStringRef
+ * Returns the text of the node without copying it.
+ * \return
+ */
+QStringRef OMCValueTree::Node::toStringRef() const
+{
+  if (!isValid()) {
+    return QStringRef();
+  }
+  const Item &item = mpTree->mItems.at(mIndex);
+  return QStringRef(&mpTree->mValue, item.mPosition, item.mLength);
+}
+
+/*!
+ * \brief OMCValueTree::Node::toString
+ * Returns a copy of the text of the node.
+ * \return
+ */
+QString OMCValueTree::Node::toString() const
+{
+  return toStringRef().toString();
+}
+
+/*!
+ * \brief OMCValueTree::Node::unparse
+ * Returns "" if the node is not a Modelica string. Else it unparses it into normal form. Same as StringHandler::unparse.
+ * \return
+ */
+QString OMCValueTree::Node::unparse() const
+{
+  QStringRef ref = toStringRef();
+  if (ref.length() < 2 || ref.at(0) != QLatin1Char('"') || ref.at(ref.length() - 1) != QLatin1Char('"')) {
+    return "";
+  }
+  const QString value = QString::fromRawData(ref.unicode() + 1, ref.length() - 2);
+  QString res;
+  res.reserve(value.length());
+  for (int i = 0 ; i < value.length() ; i++) {
+    CONSUME_CHAR(value,res,i);
+  }
+  return res;
+}
+
+/*!
+ * \brief OMCValueTree::Node::toBool
+ * Returns true if the node is the literal true.
+ * \return
+ */
+bool OMCValueTree::Node::toBool() const
+{
+  return toStringRef() == QLatin1String("true");
+}
+
+/*!
+ * \brief OMCValueTree::Node::toInt
+ * \return
+ */
+int OMCValueTree::Node::toInt() const
+{
+  QStringRef ref = toStringRef();
+  return QString::fromRawData(ref.unicode(), ref.length()).toInt();
+}
+
+/*!
+ * \brief OMCValueTree::Node::toReal
+ * \return
+ */
+qreal OMCValueTree::Node::toReal() const
+{
+  QStringRef ref = toStringRef();
+  return QString::fromRawData(ref.unicode(), ref.length()).toDouble();
+}
+
+/*!
+ * \brief OMCValueTree::Node::toPoint
+ * Returns the point of an array {x, y}.
+ * \return
+ */
+QPointF OMCValueTree::Node::toPoint() const
+{
+  return QPointF(at(0).toReal(), at(1).toReal());
+}
+
+/*!
+ * \brief OMCValueTree::Node::toColor
+ * Returns the color of an array {r, g, b}.
+ * \return
+ */
+QColor OMCValueTree::Node::toColor() const
+{
+  return QColor(at(0).toInt(), at(1).toInt(), at(2).toInt());
+}
@@ -164,4 +164,64 @@ protected:
   static QString mLastOpenDir;
 };
 
+/*!
+ * \class OMCValueTree
+ * \brief A lightweight parse tree of the OMC value syntax e.g., true, {0.0, 0.0}, 0, {{-100, 0}, {100, 0}}, "text".\n
+ * The string is tokenized in one pass. The nodes only store the positions of the tokens in the string and are handed out as QStringRef,
+ * so parsing allocates the node list once instead of a QString for every token like StringHandler::getStrings does.\n
+ * The top level value is the comma separated list of the string. A value enclosed in curly brackets is an array whose elements are its children.
+ * Commas inside the strings and the parentheses are not splitted.
+ */
+class OMCValueTree
+{
+private:
+  struct Item {
+    int mPosition;
+    int mLength;
+    int mParent;
+    int mChildrenIndex;
+    int mChildrenCount;
+    bool mArray;
+  };
+  struct Frame {
+    int mItem;
+    int mElementStart;
+    bool mElementIsArray;
+  };
+public:
+  class Node
+  {
+  public:
+    Node() : mpTree(0), mIndex(-1) {}
+    Node(const OMCValueTree *pTree, int index) : mpTree(pTree), mIndex(index) {}
+    bool isValid() const {return mpTree && mIndex >= 0;}
+    bool isArray() const;
+    int size() const;
+    Node at(int index) const;
+    QStringRef toStringRef() const;
+    QString toString() const;
+    QString unparse() const;
+    bool toBool() const;
+    int toInt() const;
+    qreal toReal() const;
+    QPointF toPoint() const;
+    QColor toColor() const;
+  private:
+    const OMCValueTree *mpTree;
+    int mIndex;
+  };
+  OMCValueTree(const QString &value);
+  Node root() const {return Node(this, 0);}
+  Node at(int index) const {return root().at(index);}
+  int size() const {return root().size();}
+private:
+  QString mValue;
+  QVector<Item> mItems;
+  QVector<int> mChildren;
+  void parse();
+  int addItem(int parent, int position, int length, bool array);
+  void addElement(int parent, int start, int end, bool addEmpty);
+  bool isBlank(int start, int end) const;
+};
+
 #endif // STRINGHANDLER_H
@@ -74,6 +74,7 @@
   */
 
 #include "MainWindow.h"
+#include "BatchMode.h"
 #include "Helper.h"
 #include "CrashReportDialog.h"
 #include "meta/meta_modelica.h"
@@ -144,6 +145,8 @@ void signalHandler(int signum)
     fprintf(stderr, "Caught signal %d", signum);
   else
     fprintf(stderr, "Caught signal %d (%s)", signum, name);
+  // the crash report attaches the log files. Write the text the log writer still holds.
+  OMCLogWriter::flushAll();
   CrashReportDialog *pCrashReportDialog = new CrashReportDialog;
   pCrashReportDialog->exec();
 
@@ -190,6 +193,8 @@ LONG WINAPI exceptionFilter(LPEXCEPTION_POINTERS info)
     out.flush();
     stackTraceFile.close();
   }
+  // the crash report attaches the log files. Write the text the log writer still holds.
+  OMCLogWriter::flushAll();
   CrashReportDialog *pCrashReportDialog = new CrashReportDialog;
   pCrashReportDialog->exec();
   exit(1);
@@ -199,9 +204,14 @@ LONG WINAPI exceptionFilter(LPEXCEPTION_POINTERS info)
 
 void printOMEditUsage()
 {
-  printf("Usage: OMEdit [--OMCLogger=true|false] --Debug=true|false] [files]\n");
+  printf("Usage: OMEdit [--OMCLogger=true|false] --Debug=true|false] [--Batch=scriptFile] [--BatchCommand=command] [files]\n");
   printf("    --OMCLogger=[true|false]    Allows sending OMC commands from OMCLogger. Default is false.\n");
   printf("    --Debug=[true|false]        Enables the debugging features like QUndoView, diffModelicaFileListings view. Default is false.\n");
+  printf("    --Batch=scriptFile          Runs the commands in scriptFile without showing any window and exits.\n");
+  printf("    --BatchCommand=command      Runs the command without showing any window and exits. Can be given multiple times.\n");
+  printf("                                Commands: loadLibrary name [version], loadFile fileName, checkModel className,\n");
+  printf("                                checkAllModels className, exportDiagram className fileName (*.svg|*.png),\n");
+  printf("                                exportIcon className fileName (*.svg|*.png), simulate className [simulation options].\n");
   printf("    files                       List of Modelica files(*.mo) to open.\n");
 }
 
@@ -225,12 +235,21 @@ int main(int argc, char *argv[])
 #endif // #ifdef WIN32
 #endif // #ifdef QT_NO_DEBUG
   // if user asks for --help
+  bool batch = false;
   for(int i = 1; i < argc; i++) {
     if (strcmp(argv[i], "--help") == 0) {
       printOMEditUsage();
       return 0;
+    } else if (strncmp(argv[i], "--Batch=", 8) == 0 || strncmp(argv[i], "--BatchCommand=", 15) == 0) {
+      batch = true;
     }
   }
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
+  /* batch mode doesn't need a display. Use the offscreen platform unless the user has chosen one. */
+  if (batch && qgetenv("QT_QPA_PLATFORM").isEmpty()) {
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+  }
+#endif
   Q_INIT_RESOURCE(resource_omedit);
   QApplication a(argc, argv);
   // set the stylesheet
@@ -280,7 +299,9 @@ int main(int argc, char *argv[])
   QPixmap pixmap(":/Resources/icons/omedit_splashscreen.png");
   QSplashScreen splashScreen(pixmap);
   //splashScreen.setMessage();
-  splashScreen.show();
+  if (!batch) {
+    splashScreen.show();
+  }
   Helper::initHelperVariables();
   /* Force C-style doubles */
   setlocale(LC_NUMERIC, "C");
@@ -289,6 +310,7 @@ int main(int argc, char *argv[])
   bool debug = false;
   QString fileName = "";
   QStringList fileNames;
+  QStringList batchCommands;
   if (a.arguments().size() > 1) {
     for (int i = 1; i < a.arguments().size(); i++) {
       if (strncmp(a.arguments().at(i).toStdString().c_str(), "--OMCLogger=",12) == 0) {
@@ -307,6 +329,16 @@ int main(int argc, char *argv[])
         } else {
           debug = false;
         }
+      } else if (strncmp(a.arguments().at(i).toStdString().c_str(), "--Batch=",8) == 0) {
+        QString batchArg = a.arguments().at(i);
+        batchArg.remove(0, 8);
+        if (!BatchMode::readScript(batchArg, &batchCommands)) {
+          return 1;
+        }
+      } else if (strncmp(a.arguments().at(i).toStdString().c_str(), "--BatchCommand=",15) == 0) {
+        QString batchCommandArg = a.arguments().at(i);
+        batchCommandArg.remove(0, 15);
+        batchCommands << batchCommandArg;
       } else {
         fileName = a.arguments().at(i);
         if (!fileName.isEmpty()) {
@@ -322,11 +354,26 @@ int main(int argc, char *argv[])
     }
   }
   // MainWindow Initialization
-  MainWindow mainwindow(&splashScreen, debug);
+  MainWindow mainwindow(batch ? 0 : &splashScreen, debug, batch);
   if (mainwindow.getExitApplicationStatus()) {        // if there is some issue in running the application.
     a.quit();
     exit(1);
   }
+  // in batch mode load the files, run the commands and exit without showing the main window
+  if (batch) {
+    BatchMode batchMode(&mainwindow);
+    int exitCode = 0;
+    foreach (QString fileName, fileNames) {
+      if (!batchMode.loadFile(fileName)) {
+        exitCode = 1;
+      }
+    }
+    if (batchMode.run(batchCommands) != 0) {
+      exitCode = 1;
+    }
+    mainwindow.getOMCProxy()->quitOMC();
+    return exitCode;
+  }
   // open the files passed as command line arguments
   foreach (QString fileName, fileNames) {
     mainwindow.getLibraryWidget()->openFile(fileName);